@@ -0,0 +1,249 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef BENCH_HELP_H
+#define BENCH_HELP_H
+
+/** \file
+ * Helper file providing timing and reporting for the benchmarks
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "PerfCounters.h"
+
+/** Measures elapsed wall-clock time from its creation or last restart() */
+class Stopwatch {
+public:
+  /** The clock used for timing */
+  typedef std::chrono::steady_clock Clock;
+
+  /** Create a Stopwatch which starts timing now */
+  Stopwatch()
+    : start(Clock::now())
+  {
+  }
+
+  /** Start timing again from now */
+  void restart() {
+    start = Clock::now();
+  }
+
+  /** \return the seconds elapsed since creation or the last restart() */
+  double seconds() const {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+private:
+  /** When timing started */
+  Clock::time_point start;
+};
+
+/** Histogram of latencies in nanoseconds, as HDR histograms: exact below
+ * 2 * SUB_BUCKETS, and above in SUB_BUCKETS buckets per power of two, so each
+ * value is kept within 1 part in SUB_BUCKETS over the whole range.
+ */
+class LatencyHistogram {
+public:
+  /** Buckets per power of two */
+  static const uint64_t SUB_BUCKETS = 64;
+
+  /** Create with nothing recorded */
+  LatencyHistogram()
+    : counts(index(UINT64_MAX) + 1, 0), total(0), maximum(0)
+  {
+  }
+
+  /** Record one latency \param nanoseconds of the latency */
+  void record(uint64_t nanoseconds) {
+    ++counts[index(nanoseconds)];
+    ++total;
+    maximum = std::max(maximum, nanoseconds);
+  }
+
+  /** \return the number of latencies recorded */
+  size_t count() const {
+    return total;
+  }
+
+  /** \return the greatest latency recorded, or 0 for none */
+  uint64_t max() const {
+    return maximum;
+  }
+
+  /** \return the latency at or below which percent of those recorded are,
+   * to the precision of its bucket, or 0 for none
+   *
+   * \param percent of latencies, from 0 to 100
+   */
+  uint64_t percentile(double percent) const {
+    const size_t rank = std::max<size_t>(1, static_cast<size_t>(percent / 100 * total + 0.5));
+    size_t seen = 0;
+    for(size_t bucket = 0; bucket < counts.size(); ++bucket) {
+      seen += counts[bucket];
+      if(rank <= seen) {
+	return std::min(highest(bucket), maximum);
+      }
+    }
+    return maximum;
+  }
+
+private:
+  /** \return the bucket of value \param value to find the bucket of */
+  static size_t index(uint64_t value) {
+    if(value < 2 * SUB_BUCKETS) {
+      return value;
+    }
+    // Shift value to between SUB_BUCKETS and 2 * SUB_BUCKETS
+    const int shift = 63 - __builtin_clzll(value) - __builtin_ctzll(SUB_BUCKETS);
+    return 2 * SUB_BUCKETS + (shift - 1) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+  }
+
+  /** \return the highest value of bucket \param bucket to find the highest value of */
+  static uint64_t highest(size_t bucket) {
+    if(bucket < 2 * SUB_BUCKETS) {
+      return bucket;
+    }
+    const int shift = static_cast<int>((bucket - 2 * SUB_BUCKETS) / SUB_BUCKETS) + 1;
+    const uint64_t top = (bucket - 2 * SUB_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+  }
+
+  /** The number of latencies in each bucket */
+  std::vector<size_t> counts;
+
+  /** The number of latencies recorded */
+  size_t total;
+
+  /** The greatest latency recorded */
+  uint64_t maximum;
+};
+
+/** Print one line of the latency percentiles of histogram, in nanoseconds.
+ *
+ * \param name of what was measured
+ * \param histogram of the latencies
+ */
+inline void reportLatency(const char* name, const LatencyHistogram& histogram) {
+  std::cout << std::left << std::setw(20) << name << std::right
+	    << std::setw(10) << histogram.count() << " ops"
+	    << "  p50 " << std::setw(10) << histogram.percentile(50)
+	    << "  p99 " << std::setw(10) << histogram.percentile(99)
+	    << "  p99.9 " << std::setw(10) << histogram.percentile(99.9)
+	    << "  max " << std::setw(10) << histogram.max() << " ns"
+	    << std::endl;
+}
+
+/** \return the number of seconds to run function once
+ *
+ * \param function to run
+ *
+ * \tparam Function a callable taking no arguments
+ */
+template<class Function>
+double timeIt(Function function) {
+  Stopwatch stopwatch;
+  function();
+  return stopwatch.seconds();
+}
+
+/** \return the counts of running function once
+ *
+ * \param counters to count with, created on this thread
+ * \param function to run
+ *
+ * \tparam Function a callable taking no arguments
+ */
+template<class Function>
+Experiment::PerfCounts countIt(Experiment::PerfCounters& counters, Function function) {
+  Experiment::PerfCounts counts;
+  {
+    Experiment::PerfCounters::Scope scope(counters, counts);
+    function();
+  }
+  return counts;
+}
+
+/** Print one line of results for a benchmark named name.
+ *
+ * \param name of what was measured
+ * \param seconds spent measuring
+ * \param elements processed in that time, to report the time per element
+ */
+inline void report(const char* name, double seconds, size_t elements) {
+  std::cout << std::left << std::setw(40) << name << std::right
+	    << std::fixed << std::setprecision(3) << std::setw(12) << seconds * 1e3 << " ms"
+	    << std::setprecision(2) << std::setw(12) << (0 == elements ? 0.0 : seconds * 1e9 / elements) << " ns/element"
+	    << std::endl;
+}
+
+/** Print a line of results for a benchmark named name, as report(), then a
+ * line of each available counter per element and instructions per cycle.
+ *
+ * \param name of what was measured
+ * \param counts measured
+ * \param elements processed while measuring, to report counts per element
+ */
+inline void reportCounts(const char* name, const Experiment::PerfCounts& counts, size_t elements) {
+  report(name, counts.seconds, elements);
+  std::cout << "  ";
+  if(!counts.anyAvailable()) {
+    std::cout << "counters not available" << std::endl;
+    return;
+  }
+  std::cout << "per element:" << std::setprecision(2);
+  for(int counter = 0; counter < Experiment::PERF_COUNTERS; ++counter) {
+    if(counts.available[counter]) {
+      std::cout << ' ' << Experiment::perfCounterName(static_cast<Experiment::PerfCounter>(counter)) << ' '
+		<< (0 == elements ? 0.0 : static_cast<double>(counts.values[counter]) / elements);
+    }
+  }
+  if(counts.available[Experiment::CYCLES] && counts.available[Experiment::INSTRUCTIONS] && 0 < counts[Experiment::CYCLES]) {
+    std::cout << "; ipc " << static_cast<double>(counts[Experiment::INSTRUCTIONS]) / counts[Experiment::CYCLES];
+  }
+  std::cout << std::endl;
+}
+
+/** \return the positive integer value of argv[index], or defaultValue if not given
+ *
+ * \param argc number of arguments in argv
+ * \param argv the command line arguments
+ * \param index of the argument to read
+ * \param defaultValue to return if argv has no argument index
+ */
+inline size_t argument(int argc, char** argv, int index, size_t defaultValue) {
+  if(index < argc) {
+    return std::strtoul(argv[index], NULL, 10);
+  }
+  return defaultValue;
+}
+
+/** Keep value from being optimized away by the compiler.
+ *
+ * \param value which must appear to be used
+ *
+ * \tparam T the type of value
+ */
+template<class T>
+void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif // BENCH_HELP_H
@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of building a DoubleLinkedList<int> from a std::vector by
+ * push_back, by the range constructor, by appendParallel and by copying.
+ *
+ * Usage: BulkBuildBench.exe [elements] [threads]
+ *
+ * Lists are destroyed outside the timings.
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+
+#include "BenchHelp.h"
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 10000000);
+  const size_t threads = argument(argc, argv, 2, 4);
+  std::cout << "Elements: " << elements << " Threads: " << threads << std::endl;
+
+  std::vector<int> values(elements);
+  for(size_t i = 0; i < elements; ++i) {
+    values[i] = static_cast<int>(i);
+  }
+
+  {
+    Experiment::DoubleLinkedList<int> list;
+    report("push_back", timeIt([&list, &values]() {
+	  for(std::vector<int>::const_iterator iter = values.begin(); values.end() != iter; ++iter) {
+	    list.push_back(*iter);
+	  }
+	}), elements);
+  }
+
+  {
+    std::unique_ptr<Experiment::DoubleLinkedList<int> > built;
+    report("range constructor", timeIt([&built, &values]() {
+	  built.reset(new Experiment::DoubleLinkedList<int>(values.begin(), values.end()));
+	}), elements);
+  }
+
+  Experiment::DoubleLinkedList<int> list;
+  report("appendParallel", timeIt([&list, &values, threads]() {
+	list.appendParallel(values.begin(), values.end(), static_cast<unsigned int>(threads));
+      }), elements);
+
+  std::unique_ptr<Experiment::DoubleLinkedList<int> > copy;
+  report("copy constructor", timeIt([&copy, &list]() {
+	copy.reset(new Experiment::DoubleLinkedList<int>(list));
+      }), elements);
+  return 0;
+}
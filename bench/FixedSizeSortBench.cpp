@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of FixedSizeSort against std::sort sorting many arrays of 4, 8,
+ * 16 and 32 random ints and floats.
+ *
+ * Usage: FixedSizeSortBench.exe [elements]
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "FixedSizeSort.h"
+
+#include "BenchHelp.h"
+
+/** Time sorting arrays of N of elements random values with FixedSizeSort
+ * and std::sort
+ *
+ * \param elements in all arrays
+ *
+ * \tparam T the type of values
+ * \tparam N the number of values in each array
+ */
+template<class T, size_t N>
+void bench(size_t elements) {
+  const size_t arrays = std::max<size_t>(1, elements / N);
+  std::vector<T> unsorted;
+  unsigned int seed = 1;
+  for(size_t i = 0; i < arrays * N; ++i) {
+    seed = seed * 1103515245 + 12345;
+    unsorted.push_back(static_cast<T>(seed >> 8));
+  }
+  std::cout << N << " values per array" << std::endl;
+
+  std::vector<T> data(unsorted);
+  report("FixedSizeSort", timeIt([&data, arrays]() {
+	for(size_t array = 0; array < arrays; ++array) {
+	  Experiment::FixedSizeSort<N>::sort(data.data() + array * N);
+	}
+      }), data.size());
+  doNotOptimize(data.front());
+
+  data = unsorted;
+  report("std::sort", timeIt([&data, arrays]() {
+	for(size_t array = 0; array < arrays; ++array) {
+	  std::sort(data.data() + array * N, data.data() + (array + 1) * N);
+	}
+      }), data.size());
+  doNotOptimize(data.front());
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 8000000);
+  std::cout << "Elements: " << elements << std::endl;
+
+  std::cout << "int" << std::endl;
+  bench<int, 4>(elements);
+  bench<int, 8>(elements);
+  bench<int, 16>(elements);
+  bench<int, 32>(elements);
+
+  std::cout << "float" << std::endl;
+  bench<float, 4>(elements);
+  bench<float, 8>(elements);
+  bench<float, 16>(elements);
+  bench<float, 32>(elements);
+  return 0;
+}
@@ -0,0 +1,73 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of IncrementalListSort: the total time of sorting in one call
+ * and in time slices, against ListMergeSort, and the longest slice.
+ *
+ * Usage: IncrementalSortBench.exe [elements] [slice microseconds]
+ */
+
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "IncrementalListSort.h"
+#include "ListMergeSort.h"
+
+#include "BenchHelp.h"
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 1000000);
+  const size_t sliceMicroseconds = argument(argc, argv, 2, 1000);
+  std::vector<int> values;
+  std::mt19937 random(42);
+  for(size_t i = 0; i < elements; ++i) {
+    values.push_back(static_cast<int>(random()));
+  }
+  std::cout << "Elements: " << elements << " Slice: " << sliceMicroseconds << " us" << std::endl;
+
+  {
+    Experiment::DoubleLinkedList<int> list;
+    list.append(values.begin(), values.end());
+    Experiment::ListMergeSort<int> sort;
+    report("ListMergeSort", timeIt([&list, &sort]() { sort.sort(list); }), elements);
+  }
+
+  {
+    Experiment::DoubleLinkedList<int> list;
+    list.append(values.begin(), values.end());
+    Experiment::IncrementalListSort<int> sort(list);
+    report("IncrementalListSort finish", timeIt([&sort]() { sort.finish(); }), elements);
+  }
+
+  {
+    Experiment::DoubleLinkedList<int> list;
+    list.append(values.begin(), values.end());
+    Experiment::IncrementalListSort<int> sort(list);
+    size_t slices = 0;
+    double longest = 0;
+    const double seconds = timeIt([&sort, sliceMicroseconds, &slices, &longest]() {
+	for(bool done = false; !done; ++slices) {
+	  Stopwatch stopwatch;
+	  done = sort.stepFor(std::chrono::microseconds(sliceMicroseconds));
+	  longest = std::max(longest, stopwatch.seconds());
+	}
+      });
+    report("IncrementalListSort slices", seconds, elements);
+    std::cout << "Slices: " << slices << " longest: " << longest * 1e3 << " ms" << std::endl;
+  }
+  return 0;
+}
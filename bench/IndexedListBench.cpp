@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of IndexedDoubleLinkedList against DoubleLinkedList: building,
+ * traversal, sorting with ListMergeSort and traversal after the sort.
+ *
+ * Usage: IndexedListBench.exe [elements]
+ */
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "IndexedDoubleLinkedList.h"
+#include "ListMergeSort.h"
+
+#include "BenchHelp.h"
+
+/** \return the sum of the values in list, walking it in list order
+ *
+ * \param list to sum
+ *
+ * \tparam List the type of list
+ */
+template<class List>
+long sum(const List& list) {
+  long total = 0;
+  for(typename List::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter) {
+    total += *iter;
+  }
+  return total;
+}
+
+/** Build, traverse, sort and traverse again a list of type List.
+ *
+ * \param name of the type of list for reporting
+ * \param values to build the list from
+ *
+ * \tparam List the type of list to benchmark
+ */
+template<class List>
+void bench(const std::string& name, const std::vector<int>& values) {
+  List list;
+  report((name + " build").c_str(), timeIt([&list, &values]() {
+	for(std::vector<int>::const_iterator iter = values.begin(); values.end() != iter; ++iter) {
+	  list.push_back(*iter);
+	}
+      }), values.size());
+  report((name + " traverse").c_str(), timeIt([&list]() { doNotOptimize(sum(list)); }), values.size());
+
+  Experiment::ListMergeSort<int, typename List::iterator> sort;
+  report((name + " sort").c_str(), timeIt([&list, &sort]() { sort.sort(list); }), values.size());
+  report((name + " traverse sorted").c_str(), timeIt([&list]() { doNotOptimize(sum(list)); }), values.size());
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 1000000);
+
+  std::vector<int> values;
+  std::mt19937 random(42);
+  for(size_t i = 0; i < elements; ++i) {
+    values.push_back(static_cast<int>(random()));
+  }
+  std::cout << "Elements: " << elements << std::endl;
+
+  bench<Experiment::IndexedDoubleLinkedList<int> >("IndexedDoubleLinkedList", values);
+  bench<Experiment::DoubleLinkedList<int> >("DoubleLinkedList", values);
+
+  // Compaction puts storage back in list order after the sort
+  Experiment::IndexedDoubleLinkedList<int> list;
+  list.reserve(elements);
+  for(std::vector<int>::const_iterator iter = values.begin(); values.end() != iter; ++iter) {
+    list.push_back(*iter);
+  }
+  Experiment::ListMergeSort<int, Experiment::IndexedDoubleLinkedList<int>::iterator> sort;
+  sort.sort(list);
+  report("IndexedDoubleLinkedList compact", timeIt([&list]() { list.compact(); }), elements);
+  report("IndexedDoubleLinkedList traverse compact", timeIt([&list]() { doNotOptimize(sum(list)); }), elements);
+
+  return 0;
+}
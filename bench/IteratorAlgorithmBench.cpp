@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of standard algorithms over a DoubleLinkedList against hand-written loops.
+ *
+ * Usage: IteratorAlgorithmBench.exe [elements]
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "DoubleLinkedList.h"
+
+#include "BenchHelp.h"
+
+/** Convenience typedef of the list benchmarked */
+typedef Experiment::DoubleLinkedList<long> List;
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 10000000);
+
+  List list;
+  for(size_t i = 0; i < elements; ++i) {
+    list.push_back(static_cast<long>(i % 1000));
+  }
+  const List& constList = list;
+  std::cout << "Elements: " << elements << std::endl;
+
+  // std::for_each
+  report("for_each iterator", timeIt([&list]() {
+	std::for_each(list.begin(), list.end(), [](long& value) { value += 1; });
+      }), elements);
+  report("for_each const_iterator", timeIt([&constList]() {
+	long sum = 0;
+	std::for_each(constList.begin(), constList.end(), [&sum](long value) { sum += value; });
+	doNotOptimize(sum);
+      }), elements);
+  report("for_each hand-written", timeIt([&list]() {
+	for(List::unsafe_iterator iter = list.unsafeBegin(); list.unsafeEnd() != iter; ++iter) {
+	  *iter -= 1;
+	}
+      }), elements);
+
+  // std::accumulate
+  report("accumulate iterator", timeIt([&list]() {
+	doNotOptimize(std::accumulate(list.begin(), list.end(), 0L));
+      }), elements);
+  report("accumulate const_iterator", timeIt([&constList]() {
+	doNotOptimize(std::accumulate(constList.begin(), constList.end(), 0L));
+      }), elements);
+  report("accumulate hand-written", timeIt([&list]() {
+	long sum = 0;
+	for(List::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter) {
+	  sum += *iter;
+	}
+	doNotOptimize(sum);
+      }), elements);
+
+  // std::find_if, for a value which is not present to walk the whole list
+  report("find_if iterator", timeIt([&list]() {
+	doNotOptimize(std::find_if(list.begin(), list.end(), [](long value) { return value < 0; }) == list.end());
+      }), elements);
+  report("find_if const_iterator", timeIt([&constList]() {
+	doNotOptimize(std::find_if(constList.begin(), constList.end(), [](long value) { return value < 0; }) == constList.end());
+      }), elements);
+  report("find_if hand-written", timeIt([&list]() {
+	List::const_iterator iter = list.cbegin();
+	while(list.cend() != iter && !(*iter < 0)) {
+	  ++iter;
+	}
+	doNotOptimize(iter == list.cend());
+      }), elements);
+
+  return 0;
+}
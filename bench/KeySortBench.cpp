@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of ListKeySort against ListMergeSort with a key comparing lessor,
+ * sorting a DoubleLinkedList of wide records by one field.
+ *
+ * Usage: KeySortBench.exe [elements]
+ */
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListKeySort.h"
+#include "ListMergeSort.h"
+
+#include "BenchHelp.h"
+
+/** A wide record sorted by one field */
+struct Record {
+  /** Field to sort by */
+  int key;
+
+  /** Unsorted payload making this a wide record */
+  char payload[120];
+};
+
+/** Key extractor of Record::key */
+struct RecordKey {
+  /** \return the key of record \param record to return the key of */
+  int operator()(const Record& record) const {
+    return record.key;
+  }
+};
+
+/** Lessor comparing Record::key */
+struct RecordLess {
+  /** \return true if lhs has a lesser key than rhs
+   *
+   * \param lhs left hand side to compare
+   * \param rhs right hand side to compare
+   */
+  bool operator()(const Record& lhs, const Record& rhs) const {
+    return lhs.key < rhs.key;
+  }
+};
+
+/** \return a list of records with the keys in keys
+ *
+ * \param keys of the records in order
+ */
+Experiment::DoubleLinkedList<Record> build(const std::vector<int>& keys) {
+  Experiment::DoubleLinkedList<Record> list;
+  Record record = Record();
+  for(std::vector<int>::const_iterator iter = keys.begin(); keys.end() != iter; ++iter) {
+    record.key = *iter;
+    list.push_back(record);
+  }
+  return list;
+}
+
+/** \return the sum of the keys in list, walking it in list order
+ *
+ * \param list to sum
+ */
+long sum(const Experiment::DoubleLinkedList<Record>& list) {
+  long total = 0;
+  for(Experiment::DoubleLinkedList<Record>::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter) {
+    total += iter->key;
+  }
+  return total;
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 1000000);
+
+  std::vector<int> keys;
+  std::mt19937 random(42);
+  for(size_t i = 0; i < elements; ++i) {
+    keys.push_back(static_cast<int>(random()));
+  }
+  std::cout << "Elements: " << elements << " of " << sizeof(Record) << " bytes" << std::endl;
+
+  {
+    Experiment::DoubleLinkedList<Record> list = build(keys);
+    Experiment::ListMergeSort<Record, Record*, RecordLess> sort;
+    report("ListMergeSort", timeIt([&list, &sort]() { sort.sort(list); }), elements);
+    report("ListMergeSort traverse sorted", timeIt([&list]() { doNotOptimize(sum(list)); }), elements);
+  }
+
+  {
+    Experiment::DoubleLinkedList<Record> list = build(keys);
+    Experiment::ListKeySort<Record, RecordKey> sort;
+    report("ListKeySort", timeIt([&list, &sort]() { sort.sort(list); }), elements);
+    report("ListKeySort traverse sorted", timeIt([&list]() { doNotOptimize(sum(list)); }), elements);
+  }
+
+  return 0;
+}
@@ -0,0 +1,201 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Latency benchmark of a DoubleLinkedList under a mix of operations, with
+ * iterators kept live throughout, printing the p50, p99, p99.9 and max
+ * latency of each operation.
+ *
+ * The operations, as named in the mix:
+ * - push_back, push_front: of one value; push_front notifies every iterator
+ *   of every value after it
+ * - erase: of the first value, by moving it to a scratch list which is
+ *   cleared, as DoubleLinkedList has no erase
+ * - move: of the first value to the end
+ * - iterate: a whole traversal
+ * - sort: by Sort, relinking
+ * - clear: of the whole list, which is then refilled untimed
+ *
+ * The mix is a comma separated list of name=weight, each operation being
+ * chosen at random in proportion to its weight.
+ *
+ * Usage: LatencyBench.exe [elements] [operations] [iterators] [mix]
+ */
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "Sort.h"
+
+#include "BenchHelp.h"
+
+/** Convenience typedef of the list measured */
+typedef Experiment::DoubleLinkedList<int> List;
+
+/** The operations measured */
+enum Operation { PUSH_BACK, PUSH_FRONT, ERASE, MOVE, ITERATE, SORT, CLEAR, OPERATIONS };
+
+/** The names of the operations, in the mix and reports */
+static const char* const OPERATION_NAMES[OPERATIONS] = {
+  "push_back", "push_front", "erase", "move", "iterate", "sort", "clear"
+};
+
+/** \return the weight of each operation in mix
+ *
+ * \param mix of name=weight, separated by commas
+ *
+ * \throw std::invalid_argument if mix names an unknown operation or has no weight
+ */
+std::vector<unsigned int> parseMix(const std::string& mix) {
+  std::vector<unsigned int> weights(OPERATIONS, 0);
+  size_t start = 0;
+  while(start < mix.size()) {
+    size_t end = mix.find(',', start);
+    if(std::string::npos == end) {
+      end = mix.size();
+    }
+    const std::string entry = mix.substr(start, end - start);
+    const size_t equals = entry.find('=');
+    int operation = 0;
+    while(operation < OPERATIONS && (std::string::npos == equals || entry.substr(0, equals) != OPERATION_NAMES[operation])) {
+      ++operation;
+    }
+    if(OPERATIONS == operation) {
+      throw std::invalid_argument("unknown operation in mix: " + entry);
+    }
+    weights[operation] = std::stoul(entry.substr(equals + 1));
+    start = end + 1;
+  }
+
+  unsigned int total = 0;
+  for(int operation = 0; operation < OPERATIONS; ++operation) {
+    total += weights[operation];
+  }
+  if(0 == total) {
+    throw std::invalid_argument("mix has no weight: " + mix);
+  }
+  return weights;
+}
+
+/** Seat iterators spread over list, as after it is refilled
+ *
+ * \param list to seat in
+ * \param iterators to seat
+ */
+void seat(List& list, std::vector<List::iterator>& iterators) {
+  List::iterator position = list.begin();
+  const size_t stride = 1 + 1024 / (iterators.size() + 1);
+  for(std::vector<List::iterator>::iterator iter = iterators.begin(); iterators.end() != iter; ++iter) {
+    for(size_t step = 0; step < stride && list.end() != position; ++step) {
+      ++position;
+    }
+    *iter = position;
+  }
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 10000);
+  const size_t operations = argument(argc, argv, 2, 100000);
+  const size_t iteratorCount = argument(argc, argv, 3, 4);
+  const std::string mix = 4 < argc ? argv[4] : "push_back=30,push_front=10,erase=35,move=10,iterate=14,sort=1,clear=1";
+  const std::vector<unsigned int> weights = parseMix(mix);
+  std::cout << "Elements: " << elements << " Operations: " << operations
+	    << " Iterators: " << iteratorCount << " Mix: " << mix << std::endl;
+
+  std::mt19937 random(42);
+  std::vector<int> values;
+  for(size_t i = 0; i < elements; ++i) {
+    values.push_back(static_cast<int>(random()));
+  }
+
+  List list;
+  list.append(values.begin(), values.end());
+  List scratch;
+  std::vector<List::iterator> iterators(iteratorCount);
+  seat(list, iterators);
+
+  std::discrete_distribution<int> choose(weights.begin(), weights.end());
+  std::vector<LatencyHistogram> histograms(OPERATIONS);
+  Experiment::Sort<int> sort;
+  long sum = 0;
+  for(size_t count = 0; count < operations; ++count) {
+    const Operation operation = static_cast<Operation>(choose(random));
+    if((ERASE == operation || MOVE == operation) && list.isEmpty()) {
+      continue;
+    }
+
+    // Keep iterators off the value erased
+    if(ERASE == operation) {
+      const List::iterator front = list.begin();
+      for(std::vector<List::iterator>::iterator iter = iterators.begin(); iterators.end() != iter; ++iter) {
+	if(front == *iter) {
+	  ++*iter;
+	}
+      }
+    }
+
+    Stopwatch stopwatch;
+    switch(operation) {
+    case PUSH_BACK:
+      list.push_back(static_cast<int>(count));
+      break;
+    case PUSH_FRONT:
+      list.push_front(static_cast<int>(count));
+      break;
+    case ERASE:
+      {
+	List::iterator front = list.begin();
+	List::iterator scratchEnd = scratch.end();
+	front.moveBefore(scratchEnd);
+      }
+      scratch.clear();
+      break;
+    case MOVE:
+      {
+	List::iterator front = list.begin();
+	List::iterator end = list.end();
+	front.moveBefore(end);
+      }
+      break;
+    case ITERATE:
+      for(List::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter) {
+	sum += *iter;
+      }
+      break;
+    case SORT:
+      sort.sort(list);
+      break;
+    default:
+      list.clear();
+      break;
+    }
+    histograms[operation].record(static_cast<uint64_t>(stopwatch.seconds() * 1e9));
+
+    if(CLEAR == operation) {
+      list.append(values.begin(), values.end());
+      seat(list, iterators);
+    }
+  }
+  doNotOptimize(sum);
+
+  for(int operation = 0; operation < OPERATIONS; ++operation) {
+    if(0 < histograms[operation].count()) {
+      reportLatency(OPERATION_NAMES[operation], histograms[operation]);
+    }
+  }
+  return 0;
+}
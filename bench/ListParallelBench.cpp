@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of ListParallel reducing and transforming a DoubleLinkedList<double>
+ * with compute-heavy work per value, on 1 thread up to one per hardware
+ * thread.
+ *
+ * Usage: ListParallelBench.exe [elements] [work per value] [most threads]
+ */
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListParallel.h"
+
+#include "BenchHelp.h"
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 10000000);
+  const size_t work = argument(argc, argv, 2, 32);
+  std::cout << "Elements: " << elements << " work per value: " << work << std::endl;
+
+  std::vector<double> values;
+  for(size_t i = 0; i < elements; ++i) {
+    values.push_back(static_cast<double>(i % 1000) / 1000.0);
+  }
+  Experiment::DoubleLinkedList<double> list(values.begin(), values.end());
+
+  // Iterations of a square root as the compute-heavy work per value
+  const auto heavy = [work](const double& value) {
+    double result = value;
+    for(size_t i = 0; i < work; ++i) {
+      result = std::sqrt(result + 1.0);
+    }
+    return result;
+  };
+
+  const size_t most = argument(argc, argv, 3, std::max(1u, std::thread::hardware_concurrency()));
+  for(unsigned int threads = 1; threads <= most; threads *= 2) {
+    std::cout << "Threads: " << threads << std::endl;
+
+    std::unique_ptr<Experiment::ListParallel<double> > parallel;
+    report("segment", timeIt([&parallel, &list, threads]() {
+	  parallel.reset(new Experiment::ListParallel<double>(list, threads));
+	}), elements);
+
+    double sum = 0;
+    report("reduce", timeIt([&parallel, &sum, &heavy]() {
+	  sum = parallel->reduce(0.0, heavy, std::plus<double>());
+	}), elements);
+    doNotOptimize(sum);
+
+    report("transformInPlace", timeIt([&parallel, &heavy]() {
+	  parallel->transformInPlace(heavy);
+	}), elements);
+    doNotOptimize(*list.cbegin());
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of DoubleLinkedList with NoListStats, the default, against
+ * CountingListStats, for the cost of counting: push, bulk append, inserts
+ * before a tracking iterator, and clear.
+ *
+ * Inserts before a tracking iterator notify it once per value after, so are
+ * quadratic; fewer are made.
+ *
+ * Usage: ListStatsBench.exe [elements] [inserts]
+ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListStats.h"
+
+#include "BenchHelp.h"
+
+/** Push, append and clear elements values each, and insert inserts before an iterator.
+ *
+ * \param name to report
+ * \param elements number of values pushed, appended and cleared
+ * \param inserts number of values inserted before an iterator
+ *
+ * \tparam Stats the statistics policy of the list
+ */
+template<class Stats>
+void bench(const std::string& name, size_t elements, size_t inserts) {
+  typedef Experiment::DoubleLinkedList<int, Stats> List;
+  const std::vector<int> values(elements, 1);
+
+  List list;
+  report((name + " push_back").c_str(), timeIt([&list, elements]() {
+	for(size_t i = 0; i < elements; ++i) {
+	  list.push_back(static_cast<int>(i));
+	}
+      }), elements);
+  report((name + " clear").c_str(), timeIt([&list]() { list.clear(); }), elements);
+
+  report((name + " append").c_str(), timeIt([&list, &values]() { list.append(values.begin(), values.end()); }), elements);
+  list.clear();
+
+  // An iterator at the only value is notified of each push_front
+  list.push_back(0);
+  typename List::iterator tracked = list.begin();
+  report((name + " push_front tracked").c_str(), timeIt([&list, inserts]() {
+	for(size_t i = 0; i < inserts; ++i) {
+	  list.push_front(static_cast<int>(i));
+	}
+      }), inserts);
+  doNotOptimize(*tracked);
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 10000000);
+  const size_t inserts = argument(argc, argv, 2, 10000);
+  std::cout << "Elements: " << elements << " Inserts: " << inserts << std::endl;
+
+  bench<Experiment::NoListStats>("NoListStats", elements, inserts);
+  bench<Experiment::CountingListStats>("CountingListStats", elements, inserts);
+
+  Experiment::DoubleLinkedList<int, Experiment::CountingListStats> counted;
+  const std::vector<int> values(elements, 1);
+  counted.append(values.begin(), values.end());
+  std::cout << counted.stats().snapshot() << std::endl;
+  return 0;
+}
@@ -0,0 +1,142 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of LruCache against a hash map of std::list iterators, with get
+ * and put on miss of keys drawn from a Zipfian distribution.
+ *
+ * Usage: LruCacheBench.exe [operations] [keys] [capacity]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "LruCache.h"
+
+#include "BenchHelp.h"
+
+/** \return operations keys from 0 to keys drawn with Zipfian exponent 0.99
+ *
+ * \param operations number of keys to draw
+ * \param keys number of distinct keys
+ */
+std::vector<int> zipfKeys(size_t operations, size_t keys) {
+  std::vector<double> cumulative;
+  double total = 0;
+  for(size_t rank = 1; rank <= keys; ++rank) {
+    total += 1.0 / std::pow(static_cast<double>(rank), 0.99);
+    cumulative.push_back(total);
+  }
+
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> uniform(0, total);
+  std::vector<int> result;
+  result.reserve(operations);
+  for(size_t i = 0; i < operations; ++i) {
+    result.push_back(static_cast<int>(std::lower_bound(cumulative.begin(), cumulative.end(), uniform(random)) - cumulative.begin()));
+  }
+  return result;
+}
+
+/** LRU of a hash map of keys to std::list iterators, spliced to the front on hit */
+class ListMapLru {
+public:
+  /** Create an empty LRU \param theCapacity in entries */
+  explicit ListMapLru(size_t theCapacity)
+    : capacity(theCapacity)
+  {
+  }
+
+  /** \return the value of key or NULL \param key to find */
+  int* get(int key) {
+    std::unordered_map<int, std::list<std::pair<int, int> >::iterator>::iterator found = map.find(key);
+    if(map.end() == found) {
+      return NULL;
+    }
+    order.splice(order.begin(), order, found->second);
+    return &found->second->second;
+  }
+
+  /** Cache value for key, which is not cached \param key to cache \param value to cache */
+  void put(int key, int value) {
+    if(capacity <= map.size()) {
+      map.erase(order.back().first);
+      order.pop_back();
+    }
+    order.push_front(std::make_pair(key, value));
+    map[key] = order.begin();
+  }
+
+private:
+  /** Maximum number of entries */
+  size_t capacity;
+
+  /** Entries from most to least recently used */
+  std::list<std::pair<int, int> > order;
+
+  /** Entries by key */
+  std::unordered_map<int, std::list<std::pair<int, int> >::iterator> map;
+};
+
+/** Run get, and put on miss, for each key on cache
+ *
+ * \param cache to run on
+ * \param keys to get and put
+ *
+ * \return the number of hits
+ *
+ * \tparam Cache the type of cache
+ */
+template<class Cache>
+size_t run(Cache& cache, const std::vector<int>& keys) {
+  size_t hits = 0;
+  for(std::vector<int>::const_iterator iter = keys.begin(); keys.end() != iter; ++iter) {
+    if(NULL != cache.get(*iter)) {
+      ++hits;
+    } else {
+      cache.put(*iter, *iter);
+    }
+  }
+  return hits;
+}
+
+int main(int argc, char** argv) {
+  const size_t operations = argument(argc, argv, 1, 10000000);
+  const size_t keyCount = argument(argc, argv, 2, 1000000);
+  const size_t capacity = argument(argc, argv, 3, 100000);
+
+  const std::vector<int> keys = zipfKeys(operations, keyCount);
+  std::cout << "Operations: " << operations << " Keys: " << keyCount << " Capacity: " << capacity << std::endl;
+
+  {
+    Experiment::LruCache<int, int> cache(capacity);
+    size_t hits = 0;
+    report("LruCache", timeIt([&cache, &keys, &hits]() { hits = run(cache, keys); }), operations);
+    std::cout << "  hit rate " << static_cast<double>(hits) / operations << std::endl;
+  }
+
+  {
+    ListMapLru cache(capacity);
+    size_t hits = 0;
+    report("unordered_map + std::list", timeIt([&cache, &keys, &hits]() { hits = run(cache, keys); }), operations);
+    std::cout << "  hit rate " << static_cast<double>(hits) / operations << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of reopening a MappedDoubleLinkedList<int> against loading a
+ * snapshot of the same values into a DoubleLinkedList<int>, and of sorting
+ * each in place.
+ *
+ * Usage: MappedListBench.exe [elements]
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "DoubleLinkedList.h"
+#include "ListMergeSort.h"
+#include "ListSnapshot.h"
+#include "MappedDoubleLinkedList.h"
+
+#include "BenchHelp.h"
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 5000000);
+  std::cout << "Elements: " << elements << std::endl;
+
+  char name[] = "/tmp/MappedListBench.XXXXXX";
+  const int fd = mkstemp(name);
+  if(fd < 0) {
+    std::cerr << "Cannot create a temporary file" << std::endl;
+    return 1;
+  }
+  close(fd);
+  const std::string path = name;
+  const std::string snapshotPath = path + ".snapshot";
+
+  {
+    Experiment::MappedDoubleLinkedList<int> mapped(path);
+    Experiment::DoubleLinkedList<int> list;
+    mapped.reserve(elements);
+    for(size_t i = 0; i < elements; ++i) {
+      const int value = static_cast<int>(i * 2654435761u);
+      mapped.push_back(value);
+      list.push_back(value);
+    }
+    mapped.sync();
+    Experiment::saveTo(list, snapshotPath);
+  }
+
+  Experiment::DoubleLinkedList<int> loaded;
+  report("loadFrom", timeIt([&loaded, &snapshotPath]() { Experiment::loadFrom(loaded, snapshotPath); }), elements);
+
+  std::unique_ptr<Experiment::MappedDoubleLinkedList<int> > mapped;
+  report("open mapped", timeIt([&mapped, &path]() {
+	mapped.reset(new Experiment::MappedDoubleLinkedList<int>(path));
+      }), elements);
+
+  report("sort loaded", timeIt([&loaded]() {
+	Experiment::ListMergeSort<int, Experiment::DoubleLinkedList<int>::iterator> sort;
+	sort.sort(loaded);
+      }), elements);
+  report("sort mapped", timeIt([&mapped]() {
+	Experiment::ListMergeSort<int, Experiment::MappedDoubleLinkedList<int>::iterator> sort;
+	sort.sort(*mapped);
+      }), elements);
+  doNotOptimize(*mapped->begin() + *loaded.begin());
+
+  mapped.reset();
+  unlink(snapshotPath.c_str());
+  unlink(path.c_str());
+  return 0;
+}
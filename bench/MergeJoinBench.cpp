@@ -0,0 +1,119 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of mergeJoin over two sorted DoubleLinkedLists of records
+ * against a hash join building a std::unordered_multimap of the right
+ * records, for inner and anti joins.
+ *
+ * Usage: MergeJoinBench.exe [rows per side]
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "MergeJoin.h"
+
+#include "BenchHelp.h"
+
+/** A record joined */
+struct Record {
+  /** The key joined on */
+  int key;
+
+  /** The payload summed by the joins */
+  int payload;
+};
+
+/** \return the key of record */
+int recordKey(const Record& record) {
+  return record.key;
+}
+
+/** \return rows records with keys in [0, rows), sorted by key
+ *
+ * \param rows the number of records
+ * \param seed for choosing keys
+ */
+Experiment::DoubleLinkedList<Record> records(size_t rows, unsigned int seed) {
+  std::vector<Record> values;
+  for(size_t i = 0; i < rows; ++i) {
+    seed = seed * 1103515245 + 12345;
+    values.push_back(Record { static_cast<int>((seed >> 4) % rows), static_cast<int>(i) });
+  }
+  std::sort(values.begin(), values.end(), [](const Record& a, const Record& b) { return a.key < b.key; });
+  return Experiment::DoubleLinkedList<Record>(values.begin(), values.end());
+}
+
+/** Time the kind of join of left and right by mergeJoin and by a hash join
+ *
+ * \param name of the join
+ * \param left records, sorted by key
+ * \param right records, sorted by key
+ * \param rows in each of left and right
+ *
+ * \tparam kind of join, INNER_JOIN or ANTI_JOIN
+ */
+template<Experiment::JoinKind kind>
+void bench(const char* name, const Experiment::DoubleLinkedList<Record>& left, const Experiment::DoubleLinkedList<Record>& right,
+	   size_t rows) {
+  std::cout << name << std::endl;
+
+  long mergeSum = 0;
+  report("mergeJoin", timeIt([&left, &right, &mergeSum]() {
+	Experiment::mergeJoin<kind>(left, right, recordKey, recordKey, [&mergeSum](const Record& l, const Record* r) {
+	    mergeSum += l.payload + (NULL == r ? 0 : r->payload);
+	  });
+      }), 2 * rows);
+  doNotOptimize(mergeSum);
+
+  long hashSum = 0;
+  report("hash join", timeIt([&left, &right, &hashSum, rows]() {
+	std::unordered_multimap<int, const Record*> table(rows);
+	for(const Record& r : right) {
+	  table.insert(std::make_pair(r.key, &r));
+	}
+	for(const Record& l : left) {
+	  const auto matches = table.equal_range(l.key);
+	  if(Experiment::ANTI_JOIN == kind) {
+	    if(matches.first == matches.second) {
+	      hashSum += l.payload;
+	    }
+	    continue;
+	  }
+	  for(auto match = matches.first; matches.second != match; ++match) {
+	    hashSum += l.payload + match->second->payload;
+	  }
+	}
+      }), 2 * rows);
+  doNotOptimize(hashSum);
+
+  if(mergeSum != hashSum) {
+    throw std::logic_error("Joins disagree");
+  }
+}
+
+int main(int argc, char** argv) {
+  const size_t rows = argument(argc, argv, 1, 10000000);
+  std::cout << "Rows per side: " << rows << std::endl;
+
+  const Experiment::DoubleLinkedList<Record> left = records(rows, 1);
+  const Experiment::DoubleLinkedList<Record> right = records(rows, 2);
+
+  bench<Experiment::INNER_JOIN>("Inner join", left, right, rows);
+  bench<Experiment::ANTI_JOIN>("Anti join", left, right, rows);
+  return 0;
+}
@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of IndexedDoubleLinkedList with and without a PositionIndex:
+ * building, seeking to random positions as pagination does with
+ * begin() + offset, erasing and reinserting at random positions, and
+ * sorting.
+ *
+ * Usage: PositionIndexBench.exe [elements] [seeks]
+ */
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "IndexedDoubleLinkedList.h"
+#include "ListMergeSort.h"
+#include "PositionIndex.h"
+
+#include "BenchHelp.h"
+
+/** Build, seek in, change and sort a list of type List.
+ *
+ * \param name of the type of list for reporting
+ * \param values to build the list from
+ * \param offsets to seek to, and to erase and reinsert at
+ *
+ * \tparam List the type of list to benchmark
+ */
+template<class List>
+void bench(const std::string& name, const std::vector<int>& values, const std::vector<size_t>& offsets) {
+  List list;
+  report((name + " build").c_str(), timeIt([&list, &values]() {
+	for(std::vector<int>::const_iterator iter = values.begin(); values.end() != iter; ++iter) {
+	  list.push_back(*iter);
+	}
+      }), values.size());
+
+  report((name + " begin() + offset").c_str(), timeIt([&list, &offsets]() {
+	long total = 0;
+	for(std::vector<size_t>::const_iterator iter = offsets.begin(); offsets.end() != iter; ++iter) {
+	  total += *(list.begin() + static_cast<std::ptrdiff_t>(*iter));
+	}
+	doNotOptimize(total);
+      }), offsets.size());
+
+  // Seeking finds each position, then erasing and adding keep the index
+  report((name + " erase and reinsert").c_str(), timeIt([&list, &offsets]() {
+	for(std::vector<size_t>::const_iterator iter = offsets.begin(); offsets.end() != iter; ++iter) {
+	  const int value = *list.erase(list.at(*iter));
+	  list.push_back(value);
+	}
+      }), offsets.size());
+
+  Experiment::ListMergeSort<int, typename List::iterator> sort;
+  report((name + " sort").c_str(), timeIt([&list, &sort]() { sort.sort(list); }), values.size());
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 1000000);
+  const size_t seeks = argument(argc, argv, 2, 1000);
+
+  std::vector<int> values;
+  std::mt19937 random(42);
+  for(size_t i = 0; i < elements; ++i) {
+    values.push_back(static_cast<int>(random()));
+  }
+  std::vector<size_t> offsets;
+  for(size_t i = 0; i < seeks && 1 < elements; ++i) {
+    offsets.push_back(random() % (elements - 1));
+  }
+  std::cout << "Elements: " << elements << " Seeks: " << seeks << std::endl;
+
+  bench<Experiment::IndexedDoubleLinkedList<int> >("NoPositionIndex", values, offsets);
+  bench<Experiment::IndexedDoubleLinkedList<int, Experiment::PositionIndex> >("PositionIndex", values, offsets);
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of Prefetch distances when traversing a DoubleLinkedList<int>
+ * whose nodes are scattered in memory, and when merge sorting a
+ * DoubleLinkedList<int*> compared through PointerLess.
+ *
+ * Usage: PrefetchBench.exe [elements] [distance]
+ *
+ * Each is run without prefetching and at distance Nodes ahead.  Use elements
+ * large enough for the lists to exceed the last level cache.
+ */
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListMergeSort.h"
+#include "Predicates.h"
+#include "Prefetch.h"
+
+#include "BenchHelp.h"
+
+/** Relink list in a random order, so consecutive Nodes are far apart in memory
+ *
+ * \param list to shuffle
+ *
+ * \tparam T type of data in list
+ */
+template<class T>
+void shuffle(Experiment::DoubleLinkedList<T>& list) {
+  std::vector<typename Experiment::DoubleLinkedList<T>::unsafe_iterator> order;
+  for(typename Experiment::DoubleLinkedList<T>::unsafe_iterator iter = list.unsafeBegin(); list.unsafeEnd() != iter; ++iter) {
+    order.push_back(iter);
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  list.relink(order.begin(), order.end());
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 4000000);
+  const size_t distance = argument(argc, argv, 2, Experiment::Prefetch::DEFAULT_DISTANCE);
+  std::cout << "Elements: " << elements << " Distance: " << distance << std::endl;
+
+  {
+    Experiment::DoubleLinkedList<int> list;
+    for(size_t i = 0; i < elements; ++i) {
+      list.push_back(static_cast<int>(i));
+    }
+    shuffle(list);
+
+    const size_t distances[] = { 0, distance };
+    for(const size_t ahead : distances) {
+      long long sum = 0;
+      const std::string name = "traverse, distance " + std::to_string(ahead);
+      report(name.c_str(), timeIt([&list, &sum, ahead]() {
+	    Experiment::Prefetch::forEach(list.cbegin(), list.cend(), [&sum](const int& value) { sum += value; }, ahead);
+	  }), elements);
+      doNotOptimize(sum);
+    }
+  }
+
+  std::vector<int> values(elements);
+  for(size_t i = 0; i < elements; ++i) {
+    values[i] = static_cast<int>(i * 2654435761u);
+  }
+  
+  const size_t distances[] = { 0, distance };
+  for(const size_t ahead : distances) {
+    Experiment::DoubleLinkedList<int*> list;
+    for(size_t i = 0; i < elements; ++i) {
+      list.push_back(&values[(i * 40503) % elements]);
+    }
+    shuffle(list);
+
+    Experiment::ListMergeSort<int*, Experiment::DoubleLinkedList<int*>::iterator, Experiment::PointerLess<int> > sort;
+    sort.prefetchDistance = ahead;
+    const std::string name = "PointerLess merge sort, distance " + std::to_string(ahead);
+    report(name.c_str(), timeIt([&sort, &list]() { sort.sort(list); }), elements);
+    doNotOptimize(*list.begin());
+  }
+  return 0;
+}
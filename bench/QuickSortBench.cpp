@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of ListQuickSort against ListMergeSort sorting a
+ * DoubleLinkedList<int> in place, with few and with many distinct values.
+ *
+ * Usage: QuickSortBench.exe [elements]
+ */
+
+#include <stdexcept>
+
+#include "DoubleLinkedList.h"
+#include "ListMergeSort.h"
+#include "ListQuickSort.h"
+
+#include "BenchHelp.h"
+
+/** Time sorting a list of elements values in [0, distinct) with Sort
+ *
+ * \param name to report
+ * \param elements in the list
+ * \param distinct values in the list
+ *
+ * \tparam Sort the sort to time
+ */
+template<class Sort>
+void bench(const char* name, size_t elements, unsigned int distinct) {
+  Experiment::DoubleLinkedList<int> list;
+  unsigned int seed = 1;
+  for(size_t i = 0; i < elements; ++i) {
+    seed = seed * 1103515245 + 12345;
+    list.push_back(static_cast<int>((seed >> 8) % distinct));
+  }
+
+  Sort sort;
+  report(name, timeIt([&sort, &list]() { sort.sort(list); }), elements);
+  doNotOptimize(*list.begin());
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 2000000);
+  std::cout << "Elements: " << elements << std::endl;
+
+  typedef Experiment::ListMergeSort<int, Experiment::DoubleLinkedList<int>::iterator> MergeSort;
+  typedef Experiment::ListQuickSort<int> QuickSort;
+
+  const unsigned int distincts[] = { 4, 64, 1u << 24 };
+  for(const unsigned int distinct : distincts) {
+    std::cout << "Distinct values: " << distinct << std::endl;
+    bench<MergeSort>("ListMergeSort", elements, distinct);
+    bench<QuickSort>("ListQuickSort", elements, distinct);
+  }
+  return 0;
+}
@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of emptying a large DoubleLinkedList: the caller's time for
+ * clear(), against ListReclaimer::reclaim() with a background thread and
+ * the time for it to finish freeing, and reclaimSome() in slices.
+ *
+ * Usage: ReclaimerBench.exe [elements] [iterators] [slice]
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListReclaimer.h"
+
+#include "BenchHelp.h"
+
+/** Convenience typedef of the list emptied */
+typedef Experiment::DoubleLinkedList<long> List;
+
+/** Fill list with values, and seat iterators in it
+ *
+ * \param list to fill
+ * \param values to fill with
+ * \param iterators to seat at values of list
+ */
+void fill(List& list, const std::vector<long>& values, std::vector<List::iterator>& iterators) {
+  list.append(values.begin(), values.end());
+  List::iterator position = list.begin();
+  for(std::vector<List::iterator>::iterator iter = iterators.begin(); iterators.end() != iter; ++iter) {
+    *iter = position;
+    ++position;
+  }
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 10000000);
+  const size_t iteratorCount = argument(argc, argv, 2, 4);
+  const size_t slice = argument(argc, argv, 3, 65536);
+  std::cout << "Elements: " << elements << " Iterators: " << iteratorCount << " Slice: " << slice << std::endl;
+
+  const std::vector<long> values(elements, 1);
+  List list;
+  std::vector<List::iterator> iterators(iteratorCount);
+
+  fill(list, values, iterators);
+  report("clear", timeIt([&list]() { list.clear(); }), elements);
+
+  {
+    fill(list, values, iterators);
+    Experiment::ListReclaimer reclaimer;
+    report("reclaim, caller", timeIt([&list, &reclaimer]() { reclaimer.reclaim(list); }), elements);
+    report("reclaim, background drain", timeIt([&reclaimer]() { reclaimer.drain(); }), elements);
+  }
+
+  {
+    fill(list, values, iterators);
+    Experiment::ListReclaimer reclaimer(false);
+    reclaimer.reclaim(list);
+    double slowest = 0;
+    size_t slices = 0;
+    const double seconds = timeIt([&reclaimer, slice, &slowest, &slices]() {
+	for(size_t freed = 1; 0 < freed; ++slices) {
+	  Stopwatch stopwatch;
+	  freed = reclaimer.reclaimSome(slice);
+	  slowest = std::max(slowest, stopwatch.seconds());
+	}
+      });
+    report("reclaimSome, all slices", seconds, elements);
+    report("reclaimSome, slowest slice", slowest, slice);
+    std::cout << "Slices: " << slices << std::endl;
+  }
+  return 0;
+}
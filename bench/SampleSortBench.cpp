@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of SampleSort across local worker processes, against
+ * ListMergeSort of the same values in one process.  Both times include
+ * building the lists; the sample sorts include starting the workers.
+ *
+ * Usage: SampleSortBench.exe [elements] [maximum workers]
+ */
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListMergeSort.h"
+#include "SampleSort.h"
+#include "SampleSortTransport.h"
+
+#include "BenchHelp.h"
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 4000000);
+  const size_t maxWorkers = argument(argc, argv, 2, 4);
+  std::cout << "Elements: " << elements << " Maximum workers: " << maxWorkers << std::endl;
+
+  std::vector<long> values;
+  values.reserve(elements);
+  for(size_t index = 0; index < elements; ++index) {
+    values.push_back(rand());
+  }
+
+  report("ListMergeSort, one process", timeIt([&values]() {
+	Experiment::DoubleLinkedList<long> data;
+	data.append(values.begin(), values.end());
+	Experiment::ListMergeSort<long> sorter;
+	sorter.sort(data);
+	doNotOptimize(data);
+      }), elements);
+
+  for(size_t workers = 1; workers <= maxWorkers; workers *= 2) {
+    // Each worker sorts its share of values, inherited from this process
+    const double seconds = timeIt([&values, workers]() {
+	Experiment::UnixSocketTransport::runLocal(workers, [&values, workers](Experiment::SampleSortTransport& transport) {
+	    const size_t share = values.size() / workers;
+	    const size_t first = transport.rank() * share;
+	    const size_t last = transport.rank() + 1 < workers ? first + share : values.size();
+	    Experiment::DoubleLinkedList<long> data;
+	    data.append(values.begin() + first, values.begin() + last);
+	    Experiment::SampleSort<long> sorter;
+	    sorter.sort(data, transport);
+	    doNotOptimize(data);
+	  });
+      });
+    const std::string name = "SampleSort, " + std::to_string(workers) + " workers";
+    report(name.c_str(), seconds, elements);
+  }
+  return 0;
+}
@@ -0,0 +1,123 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of ListSetAlgebra relinking nodes against the std::set_
+ * algorithms copying values into a new list, on two sorted
+ * DoubleLinkedList<int> posting lists.
+ *
+ * Usage: SetAlgebraBench.exe [elements]
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListSetAlgebra.h"
+
+#include "BenchHelp.h"
+
+/** Convenience typedef of the lists operated on */
+typedef Experiment::DoubleLinkedList<int> List;
+
+/** \return elements sorted values, each a multiple of step
+ *
+ * \param elements in the list
+ * \param step between candidate values
+ * \param seed for choosing values
+ */
+std::vector<int> postings(size_t elements, int step, unsigned int seed) {
+  std::vector<int> values;
+  for(size_t i = 0; i < elements; ++i) {
+    seed = seed * 1103515245 + 12345;
+    values.push_back(static_cast<int>((seed >> 8) % (2 * elements)) * step);
+  }
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+/** Time an operation of ListSetAlgebra against the copying std::set_
+ * algorithm doing the same.
+ *
+ * \param name of the operation
+ * \param first values of the first list
+ * \param second values of the second list
+ * \param relinking calling the ListSetAlgebra operation to time
+ * \param copying the std::set_ algorithm to time
+ *
+ * \tparam Relinking the type of relinking
+ * \tparam Copying the type of copying
+ */
+template<class Relinking, class Copying>
+void bench(const std::string& name, const std::vector<int>& first, const std::vector<int>& second,
+	   Relinking relinking, Copying copying) {
+  {
+    List a(first.begin(), first.end());
+    List b(second.begin(), second.end());
+    List out;
+    report((name + " copying").c_str(), timeIt([&a, &b, &out, copying]() {
+	  copying(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(out));
+	  a.clear();
+	  b.clear();
+	}), first.size() + second.size());
+    doNotOptimize(*out.cbegin());
+  }
+  {
+    List a(first.begin(), first.end());
+    List b(second.begin(), second.end());
+    List out;
+    Experiment::ListSetAlgebra<int> algebra;
+    report((name + " relinking").c_str(), timeIt([&a, &b, &out, &algebra, relinking]() {
+	  relinking(algebra, a, b, out);
+	}), first.size() + second.size());
+    doNotOptimize(*out.cbegin());
+  }
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 2000000);
+  std::cout << "Elements per list: " << elements << std::endl;
+
+  typedef Experiment::ListSetAlgebra<int> Algebra;
+  typedef List::const_iterator Iter;
+  typedef std::back_insert_iterator<List> Out;
+  const std::vector<int> first = postings(elements, 2, 1);
+  const std::vector<int> second = postings(elements, 3, 2);
+
+  bench("union", first, second, [](Algebra& algebra, List& a, List& b, List& out) { algebra.setUnion(a, b, out); }, std::set_union<Iter, Iter, Out>);
+  bench("intersection", first, second, [](Algebra& algebra, List& a, List& b, List& out) { algebra.setIntersection(a, b, out); }, std::set_intersection<Iter, Iter, Out>);
+  bench("difference", first, second, [](Algebra& algebra, List& a, List& b, List& out) { algebra.setDifference(a, b, out); }, std::set_difference<Iter, Iter, Out>);
+  bench("symmetric difference", first, second,
+	[](Algebra& algebra, List& a, List& b, List& out) { algebra.setSymmetricDifference(a, b, out); },
+	std::set_symmetric_difference<Iter, Iter, Out>);
+
+  {
+    List list(first.begin(), first.end());
+    List out;
+    report("unique copying", timeIt([&list, &out]() {
+	  std::unique_copy(list.cbegin(), list.cend(), std::back_inserter(out));
+	  list.clear();
+	}), elements);
+    doNotOptimize(*out.cbegin());
+  }
+  {
+    List list(first.begin(), first.end());
+    Experiment::ListSetAlgebra<int> algebra;
+    report("unique relinking", timeIt([&list, &algebra]() { algebra.unique(list); }), elements);
+    doNotOptimize(*list.cbegin());
+  }
+  return 0;
+}
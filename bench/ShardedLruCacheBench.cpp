@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of ShardedLruCache throughput from 1 to 32 threads, against one
+ * shard, which is an LruCache behind a single lock.
+ *
+ * Each thread runs get, and put on miss, of keys drawn from a Zipfian
+ * distribution on a cache already warmed with them.
+ *
+ * Usage: ShardedLruCacheBench.exe [operations per thread] [keys] [capacity]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ShardedLruCache.h"
+
+#include "BenchHelp.h"
+
+/** \return operations keys from 0 to keys drawn with Zipfian exponent 0.99
+ *
+ * \param operations number of keys to draw
+ * \param keys number of distinct keys
+ * \param seed for the random draws
+ */
+std::vector<int> zipfKeys(size_t operations, size_t keys, unsigned int seed) {
+  std::vector<double> cumulative;
+  double total = 0;
+  for(size_t rank = 1; rank <= keys; ++rank) {
+    total += 1.0 / std::pow(static_cast<double>(rank), 0.99);
+    cumulative.push_back(total);
+  }
+
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<double> uniform(0, total);
+  std::vector<int> result;
+  result.reserve(operations);
+  for(size_t i = 0; i < operations; ++i) {
+    result.push_back(static_cast<int>(std::lower_bound(cumulative.begin(), cumulative.end(), uniform(random)) - cumulative.begin()));
+  }
+  return result;
+}
+
+/** Run get, and put on miss, for each key on cache
+ *
+ * \param cache to run on
+ * \param keys to get and put
+ */
+void run(Experiment::ShardedLruCache<int, int>& cache, const std::vector<int>& keys) {
+  size_t hits = 0;
+  int value = 0;
+  for(std::vector<int>::const_iterator iter = keys.begin(); keys.end() != iter; ++iter) {
+    if(cache.get(*iter, value)) {
+      ++hits;
+    } else {
+      cache.put(*iter, *iter);
+    }
+  }
+  doNotOptimize(hits);
+}
+
+/** Run threadCount threads on cache, each with its own keys, and report
+ *
+ * \param name of the cache for reporting
+ * \param cache to run on
+ * \param keys of each thread
+ * \param threadCount number of threads to run
+ */
+void bench(const std::string& name, Experiment::ShardedLruCache<int, int>& cache,
+	   const std::vector<std::vector<int> >& keys, size_t threadCount) {
+  const double seconds = timeIt([&cache, &keys, threadCount]() {
+      std::vector<std::thread> threads;
+      for(size_t thread = 0; thread < threadCount; ++thread) {
+	threads.push_back(std::thread(run, std::ref(cache), std::cref(keys[thread])));
+      }
+      for(size_t thread = 0; thread < threadCount; ++thread) {
+	threads[thread].join();
+      }
+    });
+  report((name + " " + std::to_string(threadCount) + " threads").c_str(), seconds, threadCount * keys[0].size());
+}
+
+int main(int argc, char** argv) {
+  const size_t operations = argument(argc, argv, 1, 1000000);
+  const size_t keyCount = argument(argc, argv, 2, 1000000);
+  const size_t capacity = argument(argc, argv, 3, 100000);
+  const size_t maxThreads = 32;
+
+  std::vector<std::vector<int> > keys;
+  for(size_t thread = 0; thread < maxThreads; ++thread) {
+    keys.push_back(zipfKeys(operations, keyCount, static_cast<unsigned int>(42 + thread)));
+  }
+  std::cout << "Operations per thread: " << operations << " Keys: " << keyCount << " Capacity: " << capacity
+	    << " Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+  std::cout << "(ns/element is wall time over all threads' operations: lower is more throughput)" << std::endl;
+
+  Experiment::ShardedLruCache<int, int> single(capacity, 1);
+  Experiment::ShardedLruCache<int, int> sharded(capacity, 64);
+  run(single, keys[0]);
+  run(sharded, keys[0]);
+
+  for(size_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+    bench("1 shard", single, keys, threadCount);
+    bench("64 shards", sharded, keys, threadCount);
+  }
+
+  return 0;
+}
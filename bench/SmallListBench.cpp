@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of a list of short lists: DoubleLinkedList<DoubleLinkedList<int> >
+ * against DoubleLinkedList<SmallDoubleLinkedList<int, 4> >, for heap use and
+ * time to build, traverse and destroy.
+ *
+ * Usage: SmallListBench.exe [outer] [inner]
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <malloc.h>
+
+#include "DoubleLinkedList.h"
+#include "SmallDoubleLinkedList.h"
+
+#include "BenchHelp.h"
+
+/** \return the bytes of heap in use, after returning free memory to the system */
+size_t heapInUse() {
+  malloc_trim(0);
+  return mallinfo2().uordblks;
+}
+
+/** Build, traverse and destroy outer lists of inner values each.
+ *
+ * \param name to report
+ * \param outer number of inner lists
+ * \param inner number of values in each inner list
+ *
+ * \tparam Inner the type of inner list
+ */
+template<class Inner>
+void bench(const std::string& name, size_t outer, size_t inner) {
+  typedef Experiment::DoubleLinkedList<Inner> Outer;
+  const size_t elements = outer * inner;
+  const size_t before = heapInUse();
+
+  std::unique_ptr<Outer> nested(new Outer());
+  report((name + " build").c_str(), timeIt([&nested, outer, inner]() {
+	for(size_t i = 0; i < outer; ++i) {
+	  nested->push_back(Inner());
+	  Inner& added = *--nested->end();
+	  for(size_t j = 0; j < inner; ++j) {
+	    added.push_back(static_cast<int>(i + j));
+	  }
+	}
+      }), elements);
+  std::cout << name << " heap: " << (heapInUse() - before) / outer << " bytes per inner list" << std::endl;
+
+  long long sum = 0;
+  report((name + " traverse").c_str(), timeIt([&nested, &sum]() {
+	for(typename Outer::const_iterator outerIter = nested->cbegin(); nested->cend() != outerIter; ++outerIter) {
+	  for(typename Inner::const_iterator innerIter = outerIter->cbegin(); outerIter->cend() != innerIter; ++innerIter) {
+	    sum += *innerIter;
+	  }
+	}
+      }), elements);
+  doNotOptimize(sum);
+
+  report((name + " destroy").c_str(), timeIt([&nested]() { nested.reset(); }), elements);
+}
+
+int main(int argc, char** argv) {
+  const size_t outer = argument(argc, argv, 1, 1000000);
+  const size_t inner = argument(argc, argv, 2, 3);
+  std::cout << "Outer: " << outer << " Inner: " << inner << std::endl;
+
+  bench<Experiment::DoubleLinkedList<int> >("DoubleLinkedList", outer, inner);
+  bench<Experiment::SmallDoubleLinkedList<int, 4> >("SmallDoubleLinkedList<4>", outer, inner);
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of saving and loading a DoubleLinkedList<int> through snapshots
+ * against writing it element by element to an iostream and reloading it
+ * with push_back.
+ *
+ * Usage: SnapshotBench.exe [elements]
+ */
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "DoubleLinkedList.h"
+#include "ListSnapshot.h"
+
+#include "BenchHelp.h"
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 10000000);
+  std::cout << "Elements: " << elements << std::endl;
+
+  char name[] = "/tmp/SnapshotBench.XXXXXX";
+  const int fd = mkstemp(name);
+  if(fd < 0) {
+    std::cerr << "Cannot create a temporary file" << std::endl;
+    return 1;
+  }
+  close(fd);
+  const std::string path = name;
+
+  Experiment::DoubleLinkedList<int> list;
+  for(size_t i = 0; i < elements; ++i) {
+    list.push_back(static_cast<int>(i * 2654435761u));
+  }
+
+  const std::string streamPath = path + ".stream";
+  report("iostream save", timeIt([&list, &streamPath]() {
+	std::ofstream out(streamPath.c_str(), std::ios::binary);
+	for(Experiment::DoubleLinkedList<int>::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter) {
+	  out.write(reinterpret_cast<const char*>(&*iter), sizeof(int));
+	}
+      }), elements);
+  report("saveTo", timeIt([&list, &path]() { Experiment::saveTo(list, path); }), elements);
+  // list is kept so neither load reuses its freed nodes, as after a restart
+
+  {
+    Experiment::DoubleLinkedList<int> loaded;
+    report("iostream load with push_back", timeIt([&loaded, &streamPath]() {
+	  std::ifstream in(streamPath.c_str(), std::ios::binary);
+	  int value = 0;
+	  while(in.read(reinterpret_cast<char*>(&value), sizeof(int))) {
+	    loaded.push_back(value);
+	  }
+	}), elements);
+    report("clear push_back nodes", timeIt([&loaded]() { loaded.clear(); }), elements);
+  }
+
+  {
+    Experiment::DoubleLinkedList<int> loaded;
+    report("loadFrom", timeIt([&loaded, &path]() { Experiment::loadFrom(loaded, path); }), elements);
+    report("clear chunked nodes", timeIt([&loaded]() { loaded.clear(); }), elements);
+  }
+
+  unlink(streamPath.c_str());
+  unlink(path.c_str());
+  return 0;
+}
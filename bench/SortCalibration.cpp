@@ -0,0 +1,299 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Calibration of the thresholds by which Sort chooses a sort engine,
+ * writing them as SortTuning.h.
+ *
+ * Each threshold is where one engine overtakes another on this machine,
+ * timing Sort on DoubleLinkedLists with its thresholds set to force each
+ * engine.
+ *
+ * Usage: SortCalibration.exe [output header, default standard output]
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListQuickSort.h"
+#include "Sort.h"
+
+#include "BenchHelp.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::SortStrategy;
+using Experiment::SortThresholds;
+
+/** Values sorted per timing, spread over as many lists as needed */
+const size_t VALUES_PER_TIMING = 1 << 18;
+
+/** Timings of each engine, of which the fastest is taken */
+const int TIMINGS = 3;
+
+/** Length of lists for the thresholds not calibrated by length */
+const size_t LENGTH = 1 << 16;
+
+/** \return thresholds with which Sort always chooses strategy, other than
+ * QUICK_SORT, which timeSort() runs directly
+ *
+ * \param strategy to choose
+ */
+SortThresholds forcing(const SortStrategy strategy) {
+  const size_t never = std::numeric_limits<size_t>::max();
+  SortThresholds thresholds;
+  thresholds.insertionMax = Experiment::INSERTION_SORT == strategy ? never : 0;
+  thresholds.valuesPerRunMin = Experiment::RUN_MERGE_SORT == strategy ? 0 : never;
+  thresholds.radixMin = Experiment::RADIX_SORT == strategy ? 0 : never;
+  thresholds.fewDistinctMax = 0;
+  return thresholds;
+}
+
+/** \return length pseudo-random values in [0, range)
+ *
+ * \param length the number of values
+ * \param range the bound of values
+ * \param seed for the values
+ */
+std::vector<unsigned int> randomValues(const size_t length, const unsigned int range, unsigned int seed) {
+  std::vector<unsigned int> values;
+  for(size_t index = 0; index < length; ++index) {
+    seed = seed * 1103515245 + 12345;
+    values.push_back((seed >> 8) % range);
+  }
+  return values;
+}
+
+/** Report and \return the fastest of TIMINGS seconds per value to sort
+ * lists of data with strategy
+ *
+ * \param name to report
+ * \param data the values of each list
+ * \param strategy the engine to sort with
+ *
+ * \tparam T the type of values sorted
+ */
+template<class T>
+double timeSort(const std::string& name, const std::vector<T>& data, const SortStrategy strategy) {
+  const size_t lists = std::max<size_t>(1, VALUES_PER_TIMING / std::max<size_t>(1, data.size()));
+  double fastest = std::numeric_limits<double>::max();
+  for(int timing = 0; timing < TIMINGS; ++timing) {
+    // Nodes allocated singly, as append() would give each tiny list a whole chunk
+    std::vector<DoubleLinkedList<T> > unsorted(lists);
+    for(DoubleLinkedList<T>& list : unsorted) {
+      for(const T& value : data) {
+	list.push_back(value);
+      }
+    }
+    // Sort never quick sorts a sample of values all distinct, so quick sort is run itself
+    Experiment::Sort<T> sort;
+    sort.thresholds = forcing(strategy);
+    Experiment::ListQuickSort<T> quick;
+    fastest = std::min(fastest, timeIt([&sort, &quick, &unsorted, strategy]() {
+	  for(DoubleLinkedList<T>& list : unsorted) {
+	    if(Experiment::QUICK_SORT == strategy) {
+	      quick.sort(list);
+	    } else {
+	      sort.sort(list);
+	    }
+	  }
+	}));
+    doNotOptimize(*unsorted.front().begin());
+  }
+  report(name.c_str(), fastest, lists * data.size());
+  return fastest / (lists * data.size());
+}
+
+/** \return the largest length which insertion sorts faster than the other
+ * engines for int
+ */
+size_t calibrateInsertionMax() {
+  size_t insertionMax = 1;
+  for(size_t length = 2; length <= 1024; length *= 2) {
+    const std::vector<unsigned int> values = randomValues(length, 1u << 24, 1);
+    const std::vector<int> data(values.begin(), values.end());
+    const std::string suffix = " of " + std::to_string(length);
+    const double insertion = timeSort("insertion sort" + suffix, data, Experiment::INSERTION_SORT);
+    const double other = std::min(timeSort("merge sort" + suffix, data, Experiment::MERGE_SORT),
+				  timeSort("radix sort" + suffix, data, Experiment::RADIX_SORT));
+    if(other < insertion) {
+      break;
+    }
+    insertionMax = length;
+  }
+  return insertionMax;
+}
+
+/** \return the smallest length which radix sorts int faster than merge sort
+ *
+ * \param insertionMax lengths up to which are insertion sorted anyway
+ */
+size_t calibrateRadixMin(const size_t insertionMax) {
+  size_t length = insertionMax + 1;
+  for( ; length < LENGTH; length *= 2) {
+    const std::vector<unsigned int> values = randomValues(length, 1u << 24, 2);
+    const std::vector<int> data(values.begin(), values.end());
+    const std::string suffix = " of " + std::to_string(length);
+    const double radix = timeSort("radix sort" + suffix, data, Experiment::RADIX_SORT);
+    const double merge = timeSort("merge sort" + suffix, data, Experiment::MERGE_SORT);
+    if(radix < merge) {
+      break;
+    }
+  }
+  return length;
+}
+
+/** \return the smallest values per ascending run at which merging those
+ * runs sorts int faster than the other engines.  Random values average two
+ * values per run, so this starts above that, lest random inputs be run
+ * merged or not by chance.
+ */
+size_t calibrateValuesPerRunMin() {
+  size_t perRun = 4;
+  for( ; perRun < LENGTH; perRun *= 2) {
+    const std::vector<unsigned int> values = randomValues(LENGTH, 1u << 24, 3);
+    std::vector<int> data(values.begin(), values.end());
+    for(size_t run = 0; run < LENGTH; run += perRun) {
+      std::sort(data.begin() + run, data.begin() + std::min(LENGTH, run + perRun));
+    }
+    const std::string suffix = " of runs of " + std::to_string(perRun);
+    const double runMerge = timeSort("run merge sort" + suffix, data, Experiment::RUN_MERGE_SORT);
+    const double other = std::min(std::min(timeSort("merge sort" + suffix, data, Experiment::MERGE_SORT),
+					   timeSort("quick sort" + suffix, data, Experiment::QUICK_SORT)),
+				  timeSort("radix sort" + suffix, data, Experiment::RADIX_SORT));
+    if(runMerge < other) {
+      break;
+    }
+  }
+  return perRun;
+}
+
+/** \return the largest number of distinct strings which quick sorts faster
+ * than merge sort, less than distinctSample as Sort requires
+ *
+ * \param distinctSample the number of values sampled to count distinct values
+ */
+size_t calibrateFewDistinctMax(const size_t distinctSample) {
+  size_t fewDistinctMax = 0;
+  for(size_t distinct = 1; distinct < distinctSample; distinct *= 2) {
+    std::vector<std::string> data;
+    for(const unsigned int value : randomValues(LENGTH, static_cast<unsigned int>(distinct), 4)) {
+      data.push_back("value " + std::to_string(value));
+    }
+    const std::string suffix = " of " + std::to_string(distinct) + " distinct";
+    const double quick = timeSort("quick sort" + suffix, data, Experiment::QUICK_SORT);
+    const double merge = timeSort("merge sort" + suffix, data, Experiment::MERGE_SORT);
+    if(merge < quick) {
+      break;
+    }
+    fewDistinctMax = distinct;
+  }
+  return fewDistinctMax;
+}
+
+/** Write SortTuning.h with the thresholds given to out
+ *
+ * \param out to write to
+ * \param insertionMax for SortTuning::INSERTION_MAX
+ * \param valuesPerRunMin for SortTuning::VALUES_PER_RUN_MIN
+ * \param radixMin for SortTuning::RADIX_MIN
+ * \param fewDistinctMax for SortTuning::FEW_DISTINCT_MAX
+ * \param distinctSample for SortTuning::DISTINCT_SAMPLE
+ */
+void writeTuning(std::ostream& out, size_t insertionMax, size_t valuesPerRunMin, size_t radixMin,
+		 size_t fewDistinctMax, size_t distinctSample) {
+  out << R"(/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SORT_TUNING_H
+#define SORT_TUNING_H
+
+/** \file
+ * Thresholds by which Sort chooses a sort engine.
+ *
+ * Generated by SortCalibration.exe; run "make tune" to measure this machine
+ * and rewrite this file.
+ */
+
+#include <cstddef>
+
+namespace Experiment {
+
+  namespace SortTuning {
+
+    /** Inputs of at most this many values are insertion sorted */
+    const size_t INSERTION_MAX = )" << insertionMax << R"(;
+
+    /** Inputs with at least this many values per ascending run are merged from their runs */
+    const size_t VALUES_PER_RUN_MIN = )" << valuesPerRunMin << R"(;
+
+    /** Inputs of at least this many arithmetic values compared by std::less are radix sorted */
+    const size_t RADIX_MIN = )" << radixMin << R"(;
+
+    /** Inputs with at most this many distinct values in a sample are quick sorted */
+    const size_t FEW_DISTINCT_MAX = )" << fewDistinctMax << R"(;
+
+    /** Values sampled to estimate the number of distinct values */
+    const size_t DISTINCT_SAMPLE = )" << distinctSample << R"(;
+
+  } // namespace SortTuning
+
+} // namespace Experiment
+
+#endif // SORT_TUNING_H
+)";
+}
+
+int main(int argc, char** argv) {
+  // Progress goes to standard error when the header goes to standard output
+  std::streambuf* const progress = std::cout.rdbuf();
+  if(argc < 2) {
+    std::cout.rdbuf(std::cerr.rdbuf());
+  }
+
+  const size_t distinctSample = Experiment::SortTuning::DISTINCT_SAMPLE;
+  const size_t insertionMax = calibrateInsertionMax();
+  const size_t radixMin = calibrateRadixMin(insertionMax);
+  const size_t valuesPerRunMin = calibrateValuesPerRunMin();
+  const size_t fewDistinctMax = calibrateFewDistinctMax(distinctSample);
+
+  if(argc < 2) {
+    std::cout.rdbuf(progress);
+    writeTuning(std::cout, insertionMax, valuesPerRunMin, radixMin, fewDistinctMax, distinctSample);
+    return 0;
+  }
+
+  std::ofstream out(argv[1]);
+  writeTuning(out, insertionMax, valuesPerRunMin, radixMin, fewDistinctMax, distinctSample);
+  out.close();
+  if(!out) {
+    throw std::runtime_error(std::string("Cannot write ") + argv[1]);
+  }
+  std::cout << "Wrote " << argv[1] << std::endl;
+  return 0;
+}
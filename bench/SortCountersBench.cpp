@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of the list sorts with PerfCounterSortMetrics: per element, the
+ * compares, swaps, cycles, instructions, cache misses and branch misses of
+ * each, as far as this machine's counters are available.
+ *
+ * Usage: SortCountersBench.exe [elements]
+ */
+
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListKeySort.h"
+#include "ListMergeSort.h"
+#include "ListQuickSort.h"
+#include "PerfCounters.h"
+#include "Predicates.h"
+#include "Sort.h"
+
+#include "BenchHelp.h"
+
+/** Convenience typedef of the metrics of the sorts */
+typedef Experiment::PerfCounterSortMetrics<int> Metrics;
+
+/** Sort a list of values with Engine and report its metrics.
+ *
+ * \param name to report
+ * \param values to sort
+ *
+ * \tparam Engine the sort, with public Metrics metrics
+ */
+template<class Engine>
+void bench(const std::string& name, const std::vector<int>& values) {
+  Experiment::DoubleLinkedList<int> list;
+  list.append(values.begin(), values.end());
+
+  Engine engine;
+  engine.sort(list);
+  doNotOptimize(*list.cbegin());
+
+  reportCounts(name.c_str(), engine.metrics.counts, values.size());
+  std::cout << "  per element: compares " << static_cast<double>(engine.metrics.compares) / values.size()
+	    << " swaps " << static_cast<double>(engine.metrics.swaps) / values.size() << std::endl;
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 1000000);
+  std::vector<int> values;
+  std::mt19937 random(42);
+  for(size_t i = 0; i < elements; ++i) {
+    values.push_back(static_cast<int>(random()));
+  }
+  std::cout << "Elements: " << elements << std::endl;
+
+  bench<Experiment::ListMergeSort<int, int*, std::less<int>, Metrics> >("ListMergeSort", values);
+  bench<Experiment::ListQuickSort<int, int*, std::less<int>, Metrics> >("ListQuickSort", values);
+  bench<Experiment::ListKeySort<int, Experiment::IdentityKey<int>, int*, Metrics> >("ListKeySort", values);
+  bench<Experiment::Sort<int, int*, std::less<int>, Metrics> >("Sort", values);
+
+  // Traversal, for the cost of the list alone
+  Experiment::DoubleLinkedList<int> list;
+  list.append(values.begin(), values.end());
+  Experiment::PerfCounters counters;
+  long sum = 0;
+  reportCounts("traverse", countIt(counters, [&list, &sum]() {
+	for(Experiment::DoubleLinkedList<int>::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter) {
+	  sum += *iter;
+	}
+      }), elements);
+  doNotOptimize(sum);
+  return 0;
+}
@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Benchmark of ListMergeSort::sort(begin, end) starting from runs sorted by
+ * SortKernels against starting from single values, with std::sort for scale.
+ *
+ * Usage: SortKernelsBench.exe [elements]
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ListMergeSort.h"
+
+#include "BenchHelp.h"
+
+/** Lessor equal to std::less, but not it, so ListMergeSort starts from single
+ * values.
+ *
+ * \tparam T the type of value to compare
+ */
+template<class T>
+struct PlainLess {
+  /** \return true if lhs < rhs \param lhs left hand side \param rhs right hand side */
+  bool operator()(const T& lhs, const T& rhs) const {
+    return lhs < rhs;
+  }
+};
+
+/** Sort values of type T each way, named name
+ *
+ * \param name of T for reporting
+ * \param elements number of values to sort
+ *
+ * \tparam T the type of value to sort
+ */
+template<class T>
+void bench(const std::string& name, size_t elements) {
+  std::vector<T> values;
+  std::mt19937_64 random(42);
+  for(size_t i = 0; i < elements; ++i) {
+    values.push_back(static_cast<T>(static_cast<int64_t>(random() >> 2) - (1LL << 60)));
+  }
+
+  {
+    std::vector<T> data = values;
+    Experiment::ListMergeSort<T, T*, PlainLess<T> > sort;
+    report((name + " ListMergeSort singles").c_str(), timeIt([&data, &sort]() { sort.sort(data.data(), data.data() + data.size()); }), elements);
+  }
+  {
+    std::vector<T> data = values;
+    Experiment::ListMergeSort<T> sort;
+    report((name + " ListMergeSort kernels").c_str(), timeIt([&data, &sort]() { sort.sort(data.data(), data.data() + data.size()); }), elements);
+  }
+  {
+    std::vector<T> data = values;
+    report((name + " std::sort").c_str(), timeIt([&data]() { std::sort(data.begin(), data.end()); }), elements);
+  }
+}
+
+int main(int argc, char** argv) {
+  const size_t elements = argument(argc, argv, 1, 1000000);
+  std::cout << "Elements: " << elements << std::endl;
+
+  bench<int32_t>("int32_t", elements);
+  bench<int64_t>("int64_t", elements);
+  bench<float>("float", elements);
+  bench<double>("double", elements);
+
+  return 0;
+}
@@ -32,7 +32,7 @@ int main(int argc, char**argv) {
 
   // Iterate across the list printing the results
   std::cout << "List [ ";
-  for(Experiment::DoubleLinkedList<int>::iterator iter = list.begin(); list.end() != iter; ++iter) {
+  for(Experiment::DoubleLinkedList<int>::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter) {
     std::cout << *iter << " ";
   }
   std::cout << "]" << std::endl;
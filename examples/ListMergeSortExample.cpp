@@ -37,7 +37,7 @@ int main(int argc, char**argv) {
  
   // Iterate across the list printing the results
   std::cout << "Sorted [ ";
-  for(List::iterator iter = list.begin(); iter != list.end(); ++iter) {
+  for(List::const_iterator iter = list.cbegin(); iter != list.cend(); ++iter) {
     std::cout << *iter << " ";
   }
   std::cout << "]" << std::endl;
@@ -0,0 +1,201 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CURSOR_H
+#define CURSOR_H
+
+/** \file
+ * Cursor definition: a lightweight, non-tracking iterator.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace Experiment {
+  
+  /** Lightweight iterator that works genericly on a List containing Node elements
+   * with data of type T.
+   *
+   * Unlike Iterator, a Cursor does not register with its list.  It is a bare Node
+   * pointer: trivially copyable, free to create and destroy, and traversal with it
+   * is a plain pointer chase.  The price is that a Cursor is not kept at its
+   * position when Nodes are inserted, moved or removed -- it stays with its Node.
+   *
+   * Use Cursor for read-only traversal and inside algorithms which own the lists
+   * they restructure.  Dereferencing a Cursor at a marker position (such as end())
+   * is undefined rather than throwing.
+   *
+   * These are created by the lists themselves.
+   *
+   * \tparam T the type of data held by the Nodes, const for a read-only Cursor
+   * \tparam Node the type of Node in the list, const for a read-only Cursor
+   * \tparam DataNode the type of Node holding valid data in the list, const for a
+   * read-only Cursor
+   */
+  template <class T, class Node, class DataNode>
+    class Cursor {
+  public:
+    /** Cursors move forward and backward one position at a time */
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+    /** The type of data held by the Nodes */
+    typedef typename std::remove_const<T>::type value_type;
+
+    /** The type of the distance between two Cursors */
+    typedef std::ptrdiff_t difference_type;
+
+    /** The type of a pointer to the data at a Cursor */
+    typedef T* pointer;
+
+    /** The type of a reference to the data at a Cursor */
+    typedef T& reference;
+
+  public:
+    /** Create a Cursor at no position */
+    Cursor()
+      : current(NULL)
+    {
+    }
+
+    /** Create a Cursor at the Node at
+     *
+     * \param at the Node to point at
+     */
+    explicit Cursor(Node* at)
+      : current(at)
+    {
+    }
+
+    /** Create a Cursor at the same Node as rhs, such as a read-only Cursor from
+     * a modifiable one.
+     *
+     * \param rhs the Cursor to copy the position of
+     */
+    template <class OtherT, class OtherNode, class OtherDataNode>
+      Cursor(const Cursor<OtherT, OtherNode, OtherDataNode>& rhs,
+	     typename std::enable_if<std::is_convertible<OtherNode*, Node*>::value>::type* = NULL)
+      : current(rhs.getNode())
+    {
+    }
+
+    // All other constructors, destructors, and assignment operators = default
+    
+  public:
+    /** \return true if this is at the same Node as rhs, otherwise false
+     *
+     * \param rhs to compare position against
+     */
+    bool operator==(const Cursor& rhs) const {
+      return current == rhs.current;
+    }
+
+    /** \return true if this is not at the same Node as rhs, otherwise false
+     *
+     * \param rhs to compare position against
+     */
+    bool operator!=(const Cursor& rhs) const {
+      return current != rhs.current;
+    }
+
+    /** Advance this Cursor one position.
+     *
+     * \return this Cursor after advancement
+     */
+    Cursor& operator++() {
+      current = current->getNext();
+      return *this;
+    }
+
+    /** Advance this Cursor one position.
+     *
+     * \return a Cursor at the original position
+     */
+    Cursor operator++(int) {
+      Cursor copy(*this);
+      current = current->getNext();
+      return copy;
+    }
+
+    /** Decrement this Cursor one position.
+     *
+     * \return this Cursor after decrement
+     */
+    Cursor& operator--() {
+      current = current->getPrevious();
+      return *this;
+    }
+
+    /** Decrement this Cursor one position.
+     *
+     * \return a Cursor at the original position
+     */
+    Cursor operator--(int) {
+      Cursor copy(*this);
+      current = current->getPrevious();
+      return copy;
+    }
+
+    /** \return the value at this Cursor, which must be at a valid position */
+    T& operator*() const {
+      return static_cast<DataNode*>(current)->getValue();
+    }
+
+    /** \return a pointer to the value at this Cursor, which must be at a valid position */
+    T* operator->() const {
+      return &operator*();
+    }
+
+    /** Swap the Node at this Cursor with the Node at other.
+     *
+     * Both Cursors stay with their Nodes, thus trade positions.
+     *
+     * \param other Cursor at the Node to swap with
+     *
+     * \note No Iterator of either list is notified.  Only use on lists with no
+     * Iterator which must keep its position.
+     */
+    void swapWith(const Cursor& other) const {
+      current->swapWith(other.current);
+    }
+
+    /** Move the Node at this Cursor before the Node at other, which may be in
+     * another list.
+     *
+     * This Cursor stays with its Node.
+     *
+     * \param other Cursor at the Node to move this Node before
+     *
+     * \note No Iterator of either list is notified.  Only use on lists with no
+     * Iterator which must keep its position.
+     */
+    void moveBefore(const Cursor& other) const {
+      current->moveBefore(other.current);
+    }
+
+    /** \return the Node this Cursor is at
+     *
+     * \todo Conceal from public access.
+     */
+    Node* getNode() const {
+      return current;
+    }
+
+  private:
+    /** The current Node we are pointing at */
+    Node* current;
+  };
+  
+} // namespace Experiment
+
+#endif // CURSOR_H
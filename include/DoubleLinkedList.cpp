@@ -27,8 +27,8 @@ namespace Experiment {
    *
    * \note If the value_type is a pointer, the pointers will not be deleted.
    */
-  template<typename T>
-  DoubleLinkedList<T>::~DoubleLinkedList() {
+  template<typename T, typename Stats>
+  DoubleLinkedList<T, Stats>::~DoubleLinkedList() {
     // Delete all the Nodes
     clear();
     
@@ -38,12 +38,13 @@ namespace Experiment {
       IterNode* tmp = iterNode;
       iterNode = iterNode->getNext();
       delete tmp;
+      stats().iteratorRemoved(sizeof(IterDataNode));
     }
   }
   
   /** Create a new list. */
-  template<typename T>
-  DoubleLinkedList<T>::DoubleLinkedList()
+  template<typename T, typename Stats>
+  DoubleLinkedList<T, Stats>::DoubleLinkedList()
   {
     // Setup the marker nodes such that head <-> tail and the previous
     // of head is itself and the next of tail is itself.  This allows
@@ -58,8 +59,8 @@ namespace Experiment {
    *
    * @param rhs to copy from
    */
-  template<typename T>
-  DoubleLinkedList<T>::DoubleLinkedList(const DoubleLinkedList& rhs) {
+  template<typename T, typename Stats>
+  DoubleLinkedList<T, Stats>::DoubleLinkedList(const DoubleLinkedList& rhs) {
     // Setup the marker nodes such that head <-> tail and the previous
     // of head is itself and the next of tail is itself.  This allows
     // iterators to move indefinitely "past" the end of a list to itself.
@@ -68,28 +69,63 @@ namespace Experiment {
     tail.setPrevious(&head);
     tail.setNext(&tail);
     
-    // Copy all data from rhs
-    for(Node* node = rhs.head.getNext(); &rhs.tail != node; node = node->getNext()) {
-      push_back(node->operator*());
+    // Copy all data from rhs, each node allocated alone, as a copy may be
+    // kept long after its values are reordered or moved
+    try {
+      for(const_iterator iter = rhs.cbegin(); rhs.cend() != iter; ++iter) {
+	push_back(*iter);
+      }
+    } catch(...) {
+      clear();
+      throw;
     }
     
     // Do not copy iterators
   }
+  
+  /** Create a list of the values from first to last, in bulk as append().
+   *
+   * \param first the first value of the list
+   * \param last the position after the last value of the list
+   *
+   * \tparam InputIter an input iterator over values of value_type
+   */
+  template<typename T, typename Stats>
+  template<class InputIter>
+  DoubleLinkedList<T, Stats>::DoubleLinkedList(InputIter first, InputIter last) {
+    // Setup the marker nodes such that head <-> tail and the previous
+    // of head is itself and the next of tail is itself.  This allows
+    // iterators to move indefinitely "past" the end of a list to itself.
+    head.setPrevious(&head);
+    head.setNext(&tail);
+    tail.setPrevious(&head);
+    tail.setNext(&tail);
+
+    try {
+      append(first, last);
+    } catch(...) {
+      clear();
+      throw;
+    }
+  }
 
   /** Remove all data from this list.
    *
    * \note If the value_type is a pointer, the pointers will not be deleted.
    */
-  template<typename T>
-  void DoubleLinkedList<T>::clear() {
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::clear() {
     // Swap all to tail (as far as the iterators are concerned) and delete Node
     Node* curr = head.getNext();
+    size_t count = 0;
     while(curr != &tail) {
       Node* tmp = curr;
       notifyItersSwapOccurred(tmp, &tail);
       curr = curr->getNext();
       delete tmp;
+      ++count;
     }
+    stats().freed(count, count * sizeof(DataNode));
 
     // Link head <-> tail
     head.setNext(&tail);
@@ -97,8 +133,8 @@ namespace Experiment {
   }
 
   /** \return true if this list has not data, otherwise false */
-  template<typename T>
-  bool DoubleLinkedList<T>::isEmpty() const {
+  template<typename T, typename Stats>
+  bool DoubleLinkedList<T, Stats>::isEmpty() const {
     return head.getNext() == &tail;
   }
 
@@ -106,8 +142,8 @@ namespace Experiment {
    *
    * \note isEmpty() returns true if begin() == end()
    */
-  template<typename T>
-  typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::begin() {
+  template<typename T, typename Stats>
+  typename DoubleLinkedList<T, Stats>::iterator DoubleLinkedList<T, Stats>::begin() {
     return iterator(this, head.getNext());
   }
   
@@ -115,48 +151,454 @@ namespace Experiment {
    *
    * \note isEmpty() returns true if begin() == end()
    */
-  template<typename T>
-  typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::end() {
+  template<typename T, typename Stats>
+  typename DoubleLinkedList<T, Stats>::iterator DoubleLinkedList<T, Stats>::end() {
     return iterator(this, &tail);
   }
 
+  /** \return a read-only iterator pointing to the first element of this list */
+  template<typename T, typename Stats>
+  typename DoubleLinkedList<T, Stats>::const_iterator DoubleLinkedList<T, Stats>::begin() const {
+    return const_iterator(head.getNext());
+  }
+  
+  /** \return a read-only iterator pointing beyond the last element of this list */
+  template<typename T, typename Stats>
+  typename DoubleLinkedList<T, Stats>::const_iterator DoubleLinkedList<T, Stats>::end() const {
+    return const_iterator(&tail);
+  }
+  
+  /** \return a read-only iterator pointing to the first element of this list */
+  template<typename T, typename Stats>
+  typename DoubleLinkedList<T, Stats>::const_iterator DoubleLinkedList<T, Stats>::cbegin() const {
+    return begin();
+  }
+  
+  /** \return a read-only iterator pointing beyond the last element of this list */
+  template<typename T, typename Stats>
+  typename DoubleLinkedList<T, Stats>::const_iterator DoubleLinkedList<T, Stats>::cend() const {
+    return end();
+  }
+  
+  /** \return a non-tracking iterator pointing to the first element of this list
+   *
+   * \see unsafe_iterator
+   */
+  template<typename T, typename Stats>
+  typename DoubleLinkedList<T, Stats>::unsafe_iterator DoubleLinkedList<T, Stats>::unsafeBegin() {
+    return unsafe_iterator(head.getNext());
+  }
+  
+  /** \return a non-tracking iterator pointing beyond the last element of this list
+   *
+   * \see unsafe_iterator
+   */
+  template<typename T, typename Stats>
+  typename DoubleLinkedList<T, Stats>::unsafe_iterator DoubleLinkedList<T, Stats>::unsafeEnd() {
+    return unsafe_iterator(&tail);
+  }
+
   /** Insert value as the first item in this list and udpate iterators to remain
    * at same position.
    *
    * \param value to insert at the start of the list
    */
-  template<typename T>
-  void DoubleLinkedList<T>::push_front(const value_type& value) {
-    DataNode* created = new DataNode(value, &head, head.getNext());
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::push_front(const value_type& value) {
+    linkFront(new DataNode(value));
+    stats().allocated(1, sizeof(DataNode));
+  }
+
+  /** Insert value as the last item in this list */
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::push_back(const value_type& value) {
+    linkBack(new DataNode(value));
+    stats().allocated(1, sizeof(DataNode));
+  }
+
+  /** Replace all data of this list with the values from first to last, in
+   * bulk as append().
+   *
+   * As for clear(), iterators of this list move to end().
+   *
+   * \param first the first value of the list
+   * \param last the position after the last value of the list
+   *
+   * \tparam InputIter an input iterator over values of value_type, which must
+   * not be of this list
+   */
+  template<typename T, typename Stats>
+  template<class InputIter>
+  void DoubleLinkedList<T, Stats>::assign(InputIter first, InputIter last) {
+    clear();
+    append(first, last);
+  }
+
+  /** Insert the values from first to last after the last item in this list.
+   *
+   * Rather than allocating each node as push_back() does, the nodes of long
+   * ranges are constructed in large shared chunks and linked in a single
+   * pass.  A chunk is freed once all its nodes have been removed, so this
+   * suits lists built in bulk and cleared in bulk, such as loading a
+   * snapshot.  Chunks are only taken for at least NodeChunk::minimum()
+   * values; the nodes of shorter ranges, the rest of a range after its
+   * chunks and ranges which can be read only once are allocated as
+   * push_back() does.
+   *
+   * \param first the first value to append
+   * \param last the position after the last value to append
+   *
+   * \tparam InputIter an input iterator over values of value_type
+   */
+  template<typename T, typename Stats>
+  template<class InputIter>
+  void DoubleLinkedList<T, Stats>::append(InputIter first, InputIter last) {
+    appendFrom(first, last, typename std::iterator_traits<InputIter>::iterator_category());
+  }
+
+  /** Insert the values from first to last, which can be read only once,
+   * after the last item in this list, each in its own node.
+   *
+   * \param first the first value to append
+   * \param last the position after the last value to append
+   *
+   * \tparam InputIter an input iterator over values of value_type
+   */
+  template<typename T, typename Stats>
+  template<class InputIter>
+  void DoubleLinkedList<T, Stats>::appendFrom(InputIter first, InputIter last, std::input_iterator_tag) {
+    for( ; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  /** Insert the values from first to last after the last item in this list,
+   * in chunks while at least NodeChunk::minimum() values remain, then each
+   * in its own node.
+   *
+   * \param first the first value to append
+   * \param last the position after the last value to append
+   *
+   * \tparam ForwardIter a forward iterator over values of value_type
+   */
+  template<typename T, typename Stats>
+  template<class ForwardIter>
+  void DoubleLinkedList<T, Stats>::appendFrom(ForwardIter first, ForwardIter last, std::forward_iterator_tag) {
+    typedef DoubleLinkedListImpl::NodeChunk NodeChunk;
+    const size_t capacity = NodeChunk::capacity<ChunkedDataNode>();
+
+    size_t remaining = static_cast<size_t>(std::distance(first, last));
+    while(NodeChunk::minimum<ChunkedDataNode>() <= remaining) {
+      const size_t length = std::min(capacity, remaining);
+      remaining -= length;
+      NodeChunk* chunk = NodeChunk::allocate();
+      char* slot = chunk->firstSlot<ChunkedDataNode>();
+      Node* previous = tail.getPrevious();
+      size_t count = 0;
+      try {
+	for( ; count < length; ++count, ++first, slot += sizeof(ChunkedDataNode)) {
+	  ChunkedDataNode* created = new (slot) ChunkedDataNode(*first, previous, &tail);
+	  previous->setNext(created);
+	  previous = created;
+	}
+      } catch(...) {
+	tail.setPrevious(previous);
+	stats().allocated(count, count * sizeof(ChunkedDataNode));
+	// Release chunk if no node holds it
+	chunk->acquire(count + 1);
+	chunk->release();
+	throw;
+      }
+      chunk->acquire(count);
+      tail.setPrevious(previous);
+      stats().allocated(count, count * sizeof(ChunkedDataNode));
+    }
+    appendFrom(first, last, std::input_iterator_tag());
+
+    // No need to notify of inserts since there were no elements we added before
+  }
+
+  /** Insert the values from first to last after the last item in this list,
+   * constructing the nodes on several threads.
+   *
+   * As for append(), nodes are constructed in chunks.  Each chunk's worth of
+   * consecutive values is constructed and linked within its chunk by one of
+   * threads threads; the chunks are then linked to each other in order.
+   * Ranges of fewer than two chunks are appended on this thread, as is the
+   * rest of a range too short for a chunk of its own, as for append().
+   *
+   * Should copying a value throw, the values before it are appended and the
+   * exception is rethrown, as for append().
+   *
+   * \param first the first value to append
+   * \param last the position after the last value to append
+   * \param threads the number of threads to construct on, or 0 for one per
+   * hardware thread
+   *
+   * \note Work of threads which cannot be started is done on this thread.
+   *
+   * \tparam RandomIter a random access iterator over values of value_type,
+   * which may be read from several threads at once
+   */
+  template<typename T, typename Stats>
+  template<class RandomIter>
+  void DoubleLinkedList<T, Stats>::appendParallel(RandomIter first, RandomIter last, unsigned int threads) {
+    typedef DoubleLinkedListImpl::NodeChunk NodeChunk;
+    const size_t capacity = NodeChunk::capacity<ChunkedDataNode>();
+    const size_t rest = (last - first) % capacity;
+    const size_t length = (last - first) - (rest < NodeChunk::minimum<ChunkedDataNode>() ? rest : 0);
+    const size_t pieces = (length + capacity - 1) / capacity;
+    if(0 == threads) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if(pieces < 2 || threads < 2) {
+      append(first, last);
+      return;
+    }
+    const size_t workers = std::min(static_cast<size_t>(threads), pieces);
+
+    // The nodes of one chunk: the values of consecutive positions, linked
+    // to each other but not yet to the rest of the list
+    struct Piece {
+      NodeChunk* chunk;
+      size_t count;
+      std::exception_ptr error;
+    };
+    std::vector<Piece> built(pieces, Piece { NULL, 0, std::exception_ptr() });
+
+    // Build every workers-th piece from worker, stopping at the first error
+    auto work = [&built, &first, capacity, length, pieces, workers](size_t worker) {
+      for(size_t index = worker; index < pieces; index += workers) {
+	Piece& piece = built[index];
+	try {
+	  piece.chunk = NodeChunk::allocate();
+	  char* slot = piece.chunk->template firstSlot<ChunkedDataNode>();
+	  const size_t start = index * capacity;
+	  const size_t count = std::min(capacity, length - start);
+	  RandomIter value = first + start;
+	  Node* previous = NULL;
+	  for( ; piece.count < count; ++piece.count, ++value, slot += sizeof(ChunkedDataNode)) {
+	    ChunkedDataNode* created = new (slot) ChunkedDataNode(*value, previous, NULL);
+	    if(NULL != previous) {
+	      previous->setNext(created);
+	    }
+	    previous = created;
+	  }
+	} catch(...) {
+	  piece.error = std::current_exception();
+	  return;
+	}
+      }
+    };
+
+    // Start as many threads as we can, and work on this one
+    std::vector<std::thread> started;
+    size_t worker = 1;
+    try {
+      for( ; worker < workers; ++worker) {
+	started.push_back(std::thread(work, worker));
+      }
+    } catch(...) {
+      // Do the work of threads which could not start
+    }
+    for(size_t unstarted = worker; unstarted < workers; ++unstarted) {
+      work(unstarted);
+    }
+    work(0);
+    for(typename std::vector<std::thread>::iterator iter = started.begin(); started.end() != iter; ++iter) {
+      iter->join();
+    }
+
+    // Link pieces in order up to and including the first failed; discard the rest
+    std::exception_ptr error;
+    for(typename std::vector<Piece>::iterator iter = built.begin(); built.end() != iter; ++iter) {
+      if(NULL == iter->chunk) {
+	continue;
+      }
+      iter->chunk->acquire(iter->count + 1);
+
+      ChunkedDataNode* nodes = reinterpret_cast<ChunkedDataNode*>(iter->chunk->template firstSlot<ChunkedDataNode>());
+      if(!error) {
+	if(0 < iter->count) {
+	  link(nodes, nodes + iter->count - 1);
+	  stats().allocated(iter->count, iter->count * sizeof(ChunkedDataNode));
+	}
+	error = iter->error;
+      } else {
+	for(size_t index = 0; index < iter->count; ++index) {
+	  delete (nodes + index);
+	}
+      }
+
+      // Release chunk if no node holds it
+      iter->chunk->release();
+    }
+    if(error) {
+      std::rethrow_exception(error);
+    }
+    append(first + length, last);
+
+    // No need to notify of inserts since there were no elements we added before
+  }
+
+  /** Link created as the first item in this list and update iterators to
+   * remain at same position.
+   *
+   * \param created the unlinked Node to link, which this list now owns
+   */
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::linkFront(Node* created) {
+    created->setPrevious(&head);
+    created->setNext(head.getNext());
     head.getNext()->setPrevious(created);
     head.setNext(created);
     
     notifyItersInsertedBefore(1, created->getNext());
   }
 
-  /** Insert value as the last item in this list */
-  template<typename T>
-  void DoubleLinkedList<T>::push_back(const value_type& value) {
-    DataNode* created = new DataNode(value, tail.getPrevious(), &tail);
+  /** Link created as the last item in this list.
+   *
+   * \param created the unlinked Node to link, which this list now owns
+   */
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::linkBack(Node* created) {
+    created->setPrevious(tail.getPrevious());
+    created->setNext(&tail);
     tail.getPrevious()->setNext(created);
     tail.setPrevious(created);
 
     // No need to notify of inserts since there were no elements we added before
   }
 
+  /** Link the chain of Nodes from first to last after the last item in this list.
+   *
+   * \param first the first Node of the chain
+   * \param last the last Node of the chain, reached from first by next links
+   */
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::link(Node* first, Node* last) {
+    Node* previous = tail.getPrevious();
+    previous->setNext(first);
+    first->setPrevious(previous);
+    last->setNext(&tail);
+    tail.setPrevious(last);
+  }
+
+  /** Relink all values of this list into the order given by [first, last).
+   *
+   * Only the links are rewritten, in a single pass; no value is copied.  As
+   * for other changes, iterators remain at the same positions.
+   *
+   * \param first the first unsafe_iterator of the new order
+   * \param last the position after the last unsafe_iterator of the new order
+   *
+   * \tparam CursorIter an input iterator over unsafe_iterators of this list,
+   * which must hold each element of this list exactly once
+   */
+  template<typename T, typename Stats>
+  template<class CursorIter>
+  void DoubleLinkedList<T, Stats>::relink(CursorIter first, CursorIter last) {
+    const std::vector<std::pair<size_t, iterator*> > positions = iteratorPositions();
+
+    // Relink in order, moving the iterators at each position to its new Node
+    typename std::vector<std::pair<size_t, iterator*> >::const_iterator nextPosition = positions.begin();
+    Node* previous = &head;
+    size_t position = 0;
+    for( ; first != last; ++first, ++position) {
+      Node* node = first->getNode();
+      previous->setNext(node);
+      node->setPrevious(previous);
+      previous = node;
+
+      for( ; positions.end() != nextPosition && position == nextPosition->first; ++nextPosition) {
+	nextPosition->second->swapOccurred(nextPosition->second->getNode(), node);
+      }
+    }
+    previous->setNext(&tail);
+    tail.setPrevious(previous);
+    stats().relinked(position);
+  }
+
+  /** \return the positions of the iterators at values of this list, in
+   * position order, with each iterator there
+   */
+  template<typename T, typename Stats>
+  std::vector<std::pair<size_t, typename DoubleLinkedList<T, Stats>::iterator*> > DoubleLinkedList<T, Stats>::iteratorPositions() const {
+    std::vector<std::pair<size_t, iterator*> > positions;
+    if(NULL != iterHead.getNext()) {
+      size_t position = 0;
+      for(const Node* node = head.getNext(); &tail != node; node = node->getNext(), ++position) {
+	for(const IterNode* curr = iterHead.getNext(); NULL != curr; curr = curr->getNext()) {
+	  if(node == curr->operator*()->getNode()) {
+	    positions.push_back(std::make_pair(position, curr->operator*()));
+	  }
+	}
+      }
+    }
+    return positions;
+  }
+
+  /** Move each iterator of positions to the Node now at its position, or to
+   * the end of this list if it is no longer that long.
+   *
+   * \param positions of iterators, in position order, as from iteratorPositions()
+   */
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::restoreIteratorPositions(const std::vector<std::pair<size_t, iterator*> >& positions) {
+    typename std::vector<std::pair<size_t, iterator*> >::const_iterator nextPosition = positions.begin();
+    Node* node = head.getNext();
+    for(size_t position = 0; positions.end() != nextPosition; ++nextPosition) {
+      for( ; position < nextPosition->first && &tail != node; ++position) {
+	node = node->getNext();
+      }
+      nextPosition->second->swapOccurred(nextPosition->second->getNode(), position == nextPosition->first ? node : &tail);
+    }
+  }
+
+  /** Unlink all Nodes from this list, leaving it empty, without walking them.
+   *
+   * Iterators at values are moved to the end, as for clear(), by walking the
+   * iterators rather than the values.
+   *
+   * \return the first Node of the chain, ending in a NULL next, which the
+   * caller now owns, or NULL if this list was empty
+   */
+  template<typename T, typename Stats>
+  typename DoubleLinkedList<T, Stats>::Node* DoubleLinkedList<T, Stats>::detach() {
+    if(isEmpty()) {
+      return NULL;
+    }
+
+    for(IterNode* curr = iterHead.getNext(); NULL != curr; curr = curr->getNext()) {
+      iterator* iter = curr->operator*();
+      Node* at = iter->getNode();
+      if(&head != at && &tail != at) {
+	iter->swapOccurred(at, &tail);
+      }
+    }
+
+    Node* first = head.getNext();
+    tail.getPrevious()->setNext(NULL);
+    head.setNext(&tail);
+    tail.setPrevious(&head);
+    stats().detachedAll();
+    return first;
+  }
+
   /** Record that iter has been created as an iterator of this list.
    *
    * \param iter to add
    *
    * \todo Conceal this from public access
    */
-  template<typename T>
-  void DoubleLinkedList<T>::addIterator(iterator* iter) {
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::addIterator(iterator* iter) {
     IterDataNode* created = new IterDataNode(iter, &iterHead, iterHead.getNext());
     if(NULL != iterHead.getNext()) {
       iterHead.getNext()->setPrevious(created);
     }
     iterHead.setNext(created);
+    stats().iteratorAdded(sizeof(IterDataNode));
   }
 
   /** Record that iter that is being destroyed as an iterator of this list.
@@ -165,8 +607,8 @@ namespace Experiment {
    *
    * \todo Conceal this from public access
    */
-  template<typename T>
-  void DoubleLinkedList<T>::removeIterator(iterator* iter) {
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::removeIterator(iterator* iter) {
     for(IterNode* curr = iterHead.getNext(); NULL != curr; curr = curr->getNext()) {
       iterator* atCurr = curr->operator*();
       if(iter == atCurr) {
@@ -175,6 +617,7 @@ namespace Experiment {
 	  curr->getNext()->setPrevious(curr->getPrevious());
 	}
 	delete curr;
+	stats().iteratorRemoved(sizeof(IterDataNode));
 	return;
       }
     }
@@ -192,11 +635,13 @@ namespace Experiment {
    *
    * \todo Conceal this from public access
    */
-  template<typename T>
-  void DoubleLinkedList<T>::notifyItersSwapOccurred(Node* a, Node* b) const {
-     for(IterNode* curr = iterHead.getNext(); NULL != curr; curr = curr->getNext()) {
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::notifyItersSwapOccurred(Node* a, Node* b) const {
+     size_t callbacks = 0;
+     for(IterNode* curr = iterHead.getNext(); NULL != curr; curr = curr->getNext(), ++callbacks) {
        curr->operator*()->swapOccurred(a, b);
      }
+     stats().swapNotified(callbacks);
   }
 
   /** Notify all iterators that count Nodes were inserted before firstAfter.
@@ -210,13 +655,21 @@ namespace Experiment {
    *
    * \todo Conceal this from public access
    */
-  template<typename T>
-  void DoubleLinkedList<T>::notifyItersInsertedBefore(int count, Node* firstAfter) const {
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::notifyItersInsertedBefore(int count, Node* firstAfter) const {
+    // Nothing to walk for if no iterators are kept at their positions
+    if(NULL == iterHead.getNext()) {
+      stats().insertNotified(0);
+      return;
+    }
+    
+    size_t callbacks = 0;
     for(Node* node = firstAfter; node != &tail; node=node->getNext()) {
-      for(IterNode* curr = iterHead.getNext(); NULL != curr; curr = curr->getNext()) {
+      for(IterNode* curr = iterHead.getNext(); NULL != curr; curr = curr->getNext(), ++callbacks) {
 	curr->operator*()->insertedBefore(node, count);
       }
     }
+    stats().insertNotified(callbacks);
   }
 
   /** Notify all iterators that count Nodes were removed before firstAfter.
@@ -230,13 +683,21 @@ namespace Experiment {
    *
    * \todo Conceal this from public access
    */
-  template<typename T>
-  void DoubleLinkedList<T>::notifyItersRemovedBefore(int count, Node* firstAfter) const {
+  template<typename T, typename Stats>
+  void DoubleLinkedList<T, Stats>::notifyItersRemovedBefore(int count, Node* firstAfter) const {
+    // Nothing to walk for if no iterators are kept at their positions
+    if(NULL == iterHead.getNext()) {
+      stats().removalNotified(0);
+      return;
+    }
+    
+    size_t callbacks = 0;
     for(Node* node = firstAfter; node != &tail; node=node->getNext()) {
-      for(IterNode* curr = iterHead.getNext(); NULL != curr; curr = curr->getNext()) {
+      for(IterNode* curr = iterHead.getNext(); NULL != curr; curr = curr->getNext(), ++callbacks) {
 	curr->operator*()->removedBefore(node, count);
       }
     }
+    stats().removalNotified(callbacks);
   }
 
 } // namespace Experiment
@@ -18,6 +18,13 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  * Double Linked List defintion.
  */
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #ifndef DOUBLE_LINKED_LIST_IMPL_H
 #include "DoubleLinkedListImpl.h"
 #endif // DOUBLE_LINKED_LIST_IMPL_H
@@ -26,26 +33,53 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "Iterator.h"
 #endif // ITERATOR_H
 
+#ifndef CURSOR_H
+#include "Cursor.h"
+#endif // CURSOR_H
+
+#ifndef LIST_STATS_H
+#include "ListStats.h"
+#endif // LIST_STATS_H
+
 namespace Experiment {
   
+  template<class T, class Lessor>
+    class ListSetAlgebra;
+
+  class ListReclaimer;
+
   /** DoubleLinkedList which can be iterated via DoubleLinkedList::iterator
    *
    * \tparam T the type of Data this DoubleLinkedList will hold
+   * \tparam Stats the policy told of allocations, iterators, notifications
+   * and relinks, as NoListStats which collects nothing and costs nothing, or
+   * CountingListStats
    */
-  template<class T>
-    class DoubleLinkedList {
-  private:
+  template<class T, class Stats = NoListStats>
+    class DoubleLinkedList : private Stats {
+  protected:
     /** Convenience typedef of Nodes contained in this list */
     typedef DoubleLinkedListImpl::Node<T> Node;
     /** Convenience typedef of Nodes with valid data contained in this list */
     typedef DoubleLinkedListImpl::DataNode<T> DataNode;
+    /** Convenience typedef of DataNodes allocated in chunks by append() */
+    typedef DoubleLinkedListImpl::ChunkedDataNode<T> ChunkedDataNode;
     
   public:
     /** Convenience typedef of the type of values in this list */
     typedef T value_type;
     
     /** Convenience typedef of iterators of this list */
-    typedef Experiment::Iterator<value_type, DoubleLinkedList<value_type>, Node> iterator;
+    typedef Experiment::Iterator<value_type, DoubleLinkedList<value_type, Stats>, Node> iterator;
+    
+    /** Convenience typedef of read-only, non-tracking iterators of this list */
+    typedef Experiment::Cursor<const value_type, const Node, const DataNode> const_iterator;
+    
+    /** Convenience typedef of non-tracking iterators of this list.
+     *
+     * Unlike iterator, these are not kept at their position when the list changes.
+     */
+    typedef Experiment::Cursor<value_type, Node, DataNode> unsafe_iterator;
     
   private: 
     /** Convenience typedef of Nodes for iterators for keeping this lists's iterators
@@ -70,18 +104,55 @@ namespace Experiment {
     
     DoubleLinkedList(const DoubleLinkedList& rhs);
     
+    template<class InputIter>
+      DoubleLinkedList(InputIter first, InputIter last);
+    
     void clear();
     
     bool isEmpty() const;
+
+    /** \return the statistics policy of this list, which is not copied with it */
+    const Stats& stats() const {
+      return *this;
+    }
+
+    /** \return the statistics policy of this list, which is not copied with it */
+    Stats& stats() {
+      return *this;
+    }
     
     iterator begin();
     
     iterator end();
     
+    const_iterator begin() const;
+    
+    const_iterator end() const;
+    
+    const_iterator cbegin() const;
+    
+    const_iterator cend() const;
+    
+    unsafe_iterator unsafeBegin();
+    
+    unsafe_iterator unsafeEnd();
+    
     void push_front(const value_type& value);
     
     void push_back(const value_type& value);
     
+    template<class InputIter>
+      void assign(InputIter first, InputIter last);
+    
+    template<class InputIter>
+      void append(InputIter first, InputIter last);
+    
+    template<class RandomIter>
+      void appendParallel(RandomIter first, RandomIter last, unsigned int threads = 0);
+    
+    template<class CursorIter>
+      void relink(CursorIter first, CursorIter last);
+    
     /// \todo add erase method
 
     /// \todo add insert method
@@ -108,6 +179,31 @@ namespace Experiment {
     
     /** List of iterators */
     IterNode iterHead;
+
+  protected:
+    void linkFront(Node* created);
+
+    void linkBack(Node* created);
+
+  private:
+    template<class InputIter>
+      void appendFrom(InputIter first, InputIter last, std::input_iterator_tag);
+
+    template<class ForwardIter>
+      void appendFrom(ForwardIter first, ForwardIter last, std::forward_iterator_tag);
+
+    void link(Node* first, Node* last);
+
+    std::vector<std::pair<size_t, iterator*> > iteratorPositions() const;
+
+    void restoreIteratorPositions(const std::vector<std::pair<size_t, iterator*> >& positions);
+
+    Node* detach();
+
+    template<class U, class Lessor>
+      friend class ListSetAlgebra;
+
+    friend class ListReclaimer;
   };
   
 } // namespace Experiment
@@ -199,6 +199,36 @@ namespace Experiment {
     {
     }
     
+    /** \return a new chunk with no nodes, aligned to its size
+     *
+     * \throw std::bad_alloc if no memory is available
+     */
+    inline NodeChunk* NodeChunk::allocate() {
+      void* memory = NULL;
+      if(0 != posix_memalign(&memory, BYTES, BYTES)) {
+	throw std::bad_alloc();
+      }
+#ifdef MADV_HUGEPAGE
+      // A chunk is exactly one huge page, so faulting it in is one fault
+      madvise(memory, BYTES, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+      return new (memory) NodeChunk();
+    }
+
+    /** Create a chunk with no nodes */
+    inline NodeChunk::NodeChunk()
+      : live(0)
+    {
+    }
+
+    /** Count one node of this chunk deleted, freeing this chunk after its last */
+    inline void NodeChunk::release() {
+      if(1 == live.fetch_sub(1)) {
+	this->~NodeChunk();
+	free(this);
+      }
+    }
+
   } // namespace DoubleLinkedListImpl
 
 } // namespace Experiment
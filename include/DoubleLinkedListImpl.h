@@ -18,6 +18,14 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  * Implementation details of a DoubleLinkedList
  */
 
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#include <stdlib.h>
+#include <sys/mman.h>
+
 namespace Experiment {
 
   namespace DoubleLinkedListImpl {
@@ -135,11 +143,185 @@ namespace Experiment {
 	return true;
       }
       
+      /** \return a reference to the value of this node without virtual dispatch */
+      value_type& getValue() {
+	return theT;
+      }
+      
+      /** \return a const reference to the value of this node without virtual dispatch */
+      const value_type& getValue() const {
+	return theT;
+      }
+      
     private:
       /** The value in this node */
       value_type theT;
     };
     
+    /** Header of an aligned chunk of memory holding many ChunkedDataNodes.
+     *
+     * Nodes allocated together by DoubleLinkedList::append() share chunks
+     * rather than each having its own allocation.  A chunk is aligned to its
+     * size, so a node finds its chunk by masking its own address, and the
+     * chunk is freed when its last node is deleted.
+     *
+     * \note This class is not accessible to the users of DoubleLinkedList.
+     */
+    class NodeChunk {
+    public:
+      /** Size and alignment of each chunk in bytes */
+      static const size_t BYTES = static_cast<size_t>(1) << 21;
+
+      static NodeChunk* allocate();
+
+      /** \return the chunk holding the node at address \param address of a node in a chunk */
+      static NodeChunk* of(const void* address) {
+	return reinterpret_cast<NodeChunk*>(reinterpret_cast<size_t>(address) & ~(BYTES - 1));
+      }
+
+      /** \return the address of the first node of type NodeType in this chunk
+       *
+       * \tparam NodeType the type of node held
+       */
+      template<class NodeType>
+	char* firstSlot() {
+	const size_t align = alignof(NodeType);
+	return reinterpret_cast<char*>(this) + (sizeof(NodeChunk) + align - 1) / align * align;
+      }
+
+      /** \return the number of nodes of type NodeType a chunk holds
+       *
+       * \tparam NodeType the type of node held
+       */
+      template<class NodeType>
+	static size_t capacity() {
+	const size_t align = alignof(NodeType);
+	return (BYTES - (sizeof(NodeChunk) + align - 1) / align * align) / sizeof(NodeType);
+      }
+
+      /** \return the fewest nodes of type NodeType worth a chunk, so that
+       * no chunk is less than half used when filled
+       *
+       * \tparam NodeType the type of node held
+       */
+      template<class NodeType>
+	static size_t minimum() {
+	return capacity<NodeType>() / 2;
+      }
+
+      /** Count nodes more nodes constructed in this chunk \param nodes constructed */
+      void acquire(size_t nodes) {
+	live += nodes;
+      }
+
+      void release();
+
+    private:
+      NodeChunk();
+      NodeChunk(const NodeChunk& rhs);
+      NodeChunk& operator=(const NodeChunk& rhs);
+
+    private:
+      /** Number of nodes constructed and not yet deleted in this chunk.
+       *
+       * Atomic, as nodes of one chunk may end up in lists of different threads.
+       */
+      std::atomic<size_t> live;
+    };
+
+    /** DoubleLinkedList internal DataNode constructed in a NodeChunk rather
+     * than allocated on its own.
+     *
+     * It is deleted like any other Node: its operator delete releases it from
+     * its chunk.
+     *
+     * \tparam T the type of the value this Node works on
+     *
+     * \note This class is not accessible to the users of DoubleLinkedList.
+     */
+    template<typename T>
+      class ChunkedDataNode : public DataNode<T> {
+    public:
+      /** Create a ChunkedDataNode, as DataNode, which must be placed in a NodeChunk
+       *
+       * \param t the value to copy into this DataNode
+       * \param previous the Node sequentially before this Node, or NULL for none
+       * \param next the Node sequentially after this Node, or NULL for none
+       */
+      ChunkedDataNode(const T& t, Node<T>* previous = NULL, Node<T>* next = NULL)
+	: DataNode<T>(t, previous, next)
+      {
+      }
+
+      /** \return place, a slot of a NodeChunk to construct in \param place the slot */
+      static void* operator new(size_t, void* place) {
+	return place;
+      }
+
+      /** Nothing to free when construction at place fails; the chunk never acquired it */
+      static void operator delete(void*, void*) {
+      }
+
+      /** Release node from its chunk \param node deleted */
+      static void operator delete(void* node) {
+	NodeChunk::of(node)->release();
+      }
+    };
+
+    /** DoubleLinkedList internal DataNode constructed in a slot inside a list
+     * object rather than allocated on its own, for SmallDoubleLinkedList.
+     *
+     * It is deleted like any other Node: its operator delete frees nothing but
+     * marks its slot free by zeroing the slot's first word.  The first word of
+     * a Node, its virtual table pointer, is never zero, so a slot is free
+     * exactly when its first word is zero -- \see isFree().  This keeps the
+     * Node the size of a DataNode.
+     *
+     * \tparam T the type of the value this Node works on
+     *
+     * \note This class is not accessible to the users of DoubleLinkedList.
+     */
+    template<typename T>
+      class InlineDataNode : public DataNode<T> {
+    public:
+      /** Create an InlineDataNode, as an unlinked DataNode, which must be
+       * placed in a free slot
+       *
+       * \param t the value to copy into this DataNode
+       */
+      explicit InlineDataNode(const T& t)
+	: DataNode<T>(t)
+      {
+      }
+
+      /** \return true if the slot at place holds no Node \param place the slot */
+      static bool isFree(const void* place) {
+	void* first;
+	std::memcpy(&first, place, sizeof(first));
+	return NULL == first;
+      }
+
+      /** Mark the slot at place free \param place the slot */
+      static void markFree(void* place) {
+	std::memset(place, 0, sizeof(void*));
+      }
+
+      /** \return place, a free slot to construct in \param place the slot */
+      static void* operator new(size_t, void* place) {
+	return place;
+      }
+
+      /** Mark place free again when construction at place fails \param place the slot */
+      static void operator delete(void* place, void*) {
+	markFree(place);
+      }
+
+      /** Mark the slot of node free \param node deleted */
+      static void operator delete(void* node) {
+	markFree(node);
+      }
+    };
+
   } // namespace DoubleLinkedListImpl
 
 } // namespace Experiment
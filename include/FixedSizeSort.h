@@ -0,0 +1,226 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef FIXED_SIZE_SORT_H
+#define FIXED_SIZE_SORT_H
+
+/** \file
+ * Sorting networks for a number of values fixed at compile time
+ */
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace Experiment {
+
+  /** Internals of FixedSizeSort
+   *
+   * \todo Conceal this from public access
+   */
+  namespace FixedSizeSortImpl {
+
+    /** Comparators of a sorting network of N values: each comparator leaves
+     * the lesser of the values at low[i] and high[i] at low[i].
+     *
+     * \tparam N the number of values sorted
+     */
+    template<size_t N>
+      struct Network {
+      /** Bound on the number of comparators, above the n log2(n)^2 / 4 + n of Batcher's networks */
+      static const size_t CAPACITY = N * N / 2 + 1;
+
+      /** Number of comparators */
+      size_t size;
+
+      /** Index of the lesser value of each comparator */
+      size_t low[CAPACITY];
+
+      /** Index of the greater value of each comparator */
+      size_t high[CAPACITY];
+    };
+
+    /** \return Batcher's odd-even merge sorting network of N values.
+     *
+     * The network is that of the next power of two, less the comparators
+     * reaching past N: the values there would be greater than all others
+     * and never move.  It is optimal for up to 8 values, and takes 63
+     * comparators for 16 rather than the best known 60, and 191 for 32
+     * rather than 185.
+     *
+     * \tparam N the number of values sorted
+     */
+    template<size_t N>
+      constexpr Network<N> oddEvenMergeNetwork() {
+      Network<N> network = {};
+      size_t powerOfTwo = 1;
+      while(powerOfTwo < N) {
+	powerOfTwo <<= 1;
+      }
+
+      for(size_t merged = 1; merged < powerOfTwo; merged <<= 1) {
+	for(size_t distance = merged; 1 <= distance; distance >>= 1) {
+	  for(size_t start = distance % merged; start + distance < powerOfTwo; start += 2 * distance) {
+	    for(size_t offset = 0; offset < distance && start + offset + distance < powerOfTwo; ++offset) {
+	      const size_t low = start + offset;
+	      const size_t high = low + distance;
+	      if(low / (2 * merged) == high / (2 * merged) && high < N) {
+		network.low[network.size] = low;
+		network.high[network.size] = high;
+		++network.size;
+	      }
+	    }
+	  }
+	}
+      }
+      return network;
+    }
+
+  } // namespace FixedSizeSortImpl
+
+  /** Sort of exactly N values by a sorting network built at compile time.
+   *
+   * Each comparator of the network is unrolled into a compare-exchange
+   * selecting the lesser and greater values without branching, which
+   * compiles to conditional moves for arithmetic values.  The sequence of
+   * compare-exchanges never depends on the values, so sort() may be used in
+   * constexpr functions, with a comparison usable there such as std::less.
+   *
+   * The sort is not stable.
+   *
+   * \tparam N the number of values sorted
+   */
+  template<size_t N>
+    class FixedSizeSort {
+  public:
+    /** The comparators of the network */
+    static constexpr FixedSizeSortImpl::Network<N> NETWORK = FixedSizeSortImpl::oddEvenMergeNetwork<N>();
+
+    /** Sort the N values from data by compare.
+     *
+     * \param data the first of N values to sort
+     * \param compare returning true if its first argument sorts before its second
+     *
+     * \tparam RandomIter random access iterator to the values
+     * \tparam Compare the comparison of values
+     */
+    template<class RandomIter, class Compare>
+      static constexpr void sort(RandomIter data, Compare compare) {
+      sortByNetwork(data, compare, std::make_index_sequence<NETWORK.size>());
+    }
+
+    /** Sort the N values from data by operator<
+     *
+     * \param data the first of N values to sort
+     *
+     * \tparam RandomIter random access iterator to the values
+     */
+    template<class RandomIter>
+      static constexpr void sort(RandomIter data) {
+      sort(data, std::less<typename std::iterator_traits<RandomIter>::value_type>());
+    }
+
+  private:
+    /** Compare-exchange the values at data by each comparator of NETWORK in turn
+     *
+     * \param data the first of N values to sort
+     * \param compare returning true if its first argument sorts before its second
+     *
+     * \tparam RandomIter random access iterator to the values
+     * \tparam Compare the comparison of values
+     * \tparam comparators the indexes of the comparators of NETWORK
+     */
+    template<class RandomIter, class Compare, size_t... comparators>
+      static constexpr void sortByNetwork(RandomIter data, Compare& compare, std::index_sequence<comparators...>) {
+      const int unrolled[] = { 0, (compareExchange<NETWORK.low[comparators], NETWORK.high[comparators]>(data, compare), 0)... };
+      (void) unrolled;
+    }
+
+    /** Leave the lesser of the values at data[low] and data[high] at
+     * data[low] and the other at data[high], without branching.
+     *
+     * \param data the first of N values to sort
+     * \param compare returning true if its first argument sorts before its second
+     *
+     * \tparam low index of the value to hold the lesser value
+     * \tparam high index of the value to hold the greater value
+     * \tparam RandomIter random access iterator to the values
+     * \tparam Compare the comparison of values
+     */
+    template<size_t low, size_t high, class RandomIter, class Compare>
+      static constexpr void compareExchange(RandomIter data, Compare& compare) {
+      typedef typename std::iterator_traits<RandomIter>::value_type Value;
+      const Value a = data[low];
+      const Value b = data[high];
+      const bool exchange = compare(b, a);
+      data[low] = exchange ? b : a;
+      data[high] = exchange ? a : b;
+    }
+  };
+
+  template<size_t N>
+  constexpr FixedSizeSortImpl::Network<N> FixedSizeSort<N>::NETWORK;
+
+  /** Sort of fewer than N values by the sorting network for their number:
+   * FixedSizeSort<length>, found by length at runtime.
+   *
+   * \tparam N the bound on the number of values sorted
+   */
+  template<size_t N>
+    class FixedSizeSortUpTo {
+  public:
+    /** Sort the length values from data by compare if length is less than N.
+     *
+     * \param data the first of length values to sort
+     * \param length the number of values to sort
+     * \param compare returning true if its first argument sorts before its second
+     *
+     * \return true if length is less than N and data was sorted, false if
+     * data was left for another sort
+     *
+     * \tparam RandomIter random access iterator to the values
+     * \tparam Compare the comparison of values
+     */
+    template<class RandomIter, class Compare>
+      static bool sort(RandomIter data, const size_t length, Compare compare) {
+      if(length + 1 == N) {
+	FixedSizeSort<N - 1>::sort(data, compare);
+	return true;
+      }
+      return FixedSizeSortUpTo<N - 1>::sort(data, length, compare);
+    }
+  };
+
+  /** Sort of no values: the end of FixedSizeSortUpTo's search */
+  template<>
+    class FixedSizeSortUpTo<0> {
+  public:
+    /** \return false: no length is less than 0
+     *
+     * \param data ignored
+     * \param length ignored
+     * \param compare ignored
+     *
+     * \tparam RandomIter random access iterator to the values
+     * \tparam Compare the comparison of values
+     */
+    template<class RandomIter, class Compare>
+      static bool sort(RandomIter data, const size_t length, Compare compare) {
+      return false;
+    }
+  };
+
+} // namespace Experiment
+
+#endif // FIXED_SIZE_SORT_H
@@ -0,0 +1,340 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INCREMENTAL_LIST_SORT_H
+#define INCREMENTAL_LIST_SORT_H
+
+/** \file
+ * Merge sort of a DoubleLinkedList done a bounded amount at a time
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+#ifndef LIST_MERGE_SORT_H
+#include "ListMergeSort.h"
+#endif // LIST_MERGE_SORT_H
+
+namespace Experiment {
+
+  /** Stable merge sort of a DoubleLinkedList resumed by step() calls, each
+   * doing a bounded amount of work, so a long sort can be spread over many
+   * short slices of one thread.
+   *
+   * The sort runs in four phases, each a unit of work per value: counting
+   * the values, so storage for them is reserved once rather than copied as it
+   * grows; collecting unsafe_iterators to the values and finding their
+   * natural runs; merging the runs pairwise, pass after pass, among those
+   * unsafe_iterators; and placing each Node after the one before it in order.
+   * Until placing, the list is untouched; while placing, it always holds all
+   * its values, with a sorted prefix.  No value is copied.
+   *
+   * Between steps, the values of the list may be read, but none may be
+   * added or removed until the sort is done.  Unlike the other sorts, the
+   * list's iterators are not kept at their positions, which move between
+   * steps: they stay with their values.
+   *
+   * \tparam T the type of values sorted
+   * \tparam Lessor to compare values
+   * \tparam Metrics to collect metrics on the sort -- \see NoSortMetrics as an example
+   * \tparam Stats the statistics policy of the list sorted
+   */
+  template<class T, class Lessor = std::less<T>, class Metrics = NoSortMetrics<T>, class Stats = NoListStats>
+    class IncrementalListSort {
+  public:
+  /** Convenience typedef of the type of data in the list */
+  typedef T value_type;
+
+  /** Convenience typedef of the type of list sorted */
+  typedef DoubleLinkedList<T, Stats> DataList;
+
+  private:
+  /** Convenience typedef of the non-tracking iterator of DataList */
+  typedef typename DataList::unsafe_iterator DataCursor;
+
+  /** What the next step() works on */
+  enum Phase { COUNT, COLLECT, MERGE, PLACE, DONE };
+
+  public:
+  /** Values of work stepFor() does between looks at the clock */
+  static const size_t STEP_GRANULE = 4096;
+
+  /** Start sorting theData, doing no work until step()
+   *
+   * \param theData the list to sort, which must outlive this sort
+   * \param theLessor to compare values
+   */
+  explicit IncrementalListSort(DataList& theData, const Lessor& theLessor = Lessor())
+    : lessor(theLessor), data(theData), phase(COUNT), uncollected(theData.unsafeBegin()),
+      counted(0), bounds(1, 0), run(0), left(0), leftEnd(0), right(0), rightEnd(0), placed(0)
+  {
+    metrics.reset();
+  }
+
+  /** Do up to budget values of work
+   *
+   * \param budget the most values to collect, merge or place
+   *
+   * \return true if the sort is done, otherwise false
+   */
+  bool step(size_t budget) {
+    size_t work = 0;
+    while(work < budget && DONE != phase) {
+      switch(phase) {
+      case COUNT:
+	work += count(budget - work);
+	break;
+      case COLLECT:
+	work += collect(budget - work);
+	break;
+      case MERGE:
+	work += merge(budget - work);
+	break;
+      default:
+	work += place(budget - work);
+	break;
+      }
+    }
+    return DONE == phase;
+  }
+
+  /** Do work until budget has elapsed, looking at the clock every
+   * STEP_GRANULE values of work
+   *
+   * \param budget the time to work for
+   *
+   * \return true if the sort is done, otherwise false
+   *
+   * \tparam Rep the representation of budget
+   * \tparam Period the period of budget
+   */
+  template<class Rep, class Period>
+    bool stepFor(const std::chrono::duration<Rep, Period>& budget) {
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + budget;
+    while(!step(STEP_GRANULE)) {
+      if(deadline <= std::chrono::steady_clock::now()) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+  /** Do all remaining work */
+  void finish() {
+    step(SIZE_MAX);
+  }
+
+  /** \return true if the sort is done, otherwise false */
+  bool isDone() const {
+    return DONE == phase;
+  }
+
+  /** To compare values */
+  Lessor lessor;
+
+  /** To collect metrics on the sort */
+  Metrics metrics;
+
+  private:
+  /** Count up to budget values, reserving storage for all once counted
+   *
+   * \param budget the most values to count
+   *
+   * \return the values counted
+   */
+  size_t count(size_t budget) {
+    size_t work = 0;
+    for( ; work < budget && data.unsafeEnd() != uncollected; ++work, ++uncollected) {
+    }
+    counted += work;
+    if(data.unsafeEnd() == uncollected) {
+      order.reserve(counted);
+      merged.reserve(counted);
+      uncollected = data.unsafeBegin();
+      phase = COLLECT;
+    }
+    return work;
+  }
+
+  /** Collect up to budget values, noting where each natural run starts
+   *
+   * \param budget the most values to collect
+   *
+   * \return the values collected
+   */
+  size_t collect(size_t budget) {
+    size_t work = 0;
+    for( ; work < budget && data.unsafeEnd() != uncollected; ++work, ++uncollected) {
+      if(!order.empty() && less(*uncollected, *order.back())) {
+	bounds.push_back(order.size());
+      }
+      order.push_back(uncollected);
+    }
+    if(data.unsafeEnd() == uncollected) {
+      bounds.push_back(order.size());
+      if(bounds.size() <= 2) {
+	// One run or none: already sorted
+	finished();
+      } else {
+	startPair();
+	phase = MERGE;
+      }
+    }
+    return work;
+  }
+
+  /** Merge up to budget values of the runs of order into merged
+   *
+   * \param budget the most values to merge
+   *
+   * \return the values merged
+   */
+  size_t merge(size_t budget) {
+    size_t work = 0;
+    while(work < budget) {
+      for( ; work < budget && merged.size() < rightEnd; ++work) {
+	if(left < leftEnd && (right == rightEnd || !less(*order[right], *order[left]))) {
+	  merged.push_back(order[left++]);
+	} else {
+	  merged.push_back(order[right++]);
+	  metrics.swap();
+	}
+      }
+      if(merged.size() < rightEnd) {
+	break;
+      }
+
+      // Next pair, or next pass
+      run += 2;
+      if(bounds.size() - 1 <= run) {
+	mergedBounds.push_back(order.size());
+	order.swap(merged);
+	merged.clear();
+	bounds.swap(mergedBounds);
+	mergedBounds.clear();
+	run = 0;
+	if(bounds.size() <= 2) {
+	  phase = PLACE;
+	  break;
+	}
+      }
+      startPair();
+    }
+    return work;
+  }
+
+  /** Set up merging the runs starting at bounds[run] and bounds[run + 1], or
+   * copying the last run if it has no pair
+   */
+  void startPair() {
+    left = bounds[run];
+    leftEnd = bounds[run + 1];
+    right = leftEnd;
+    rightEnd = run + 2 < bounds.size() ? bounds[run + 2] : leftEnd;
+    mergedBounds.push_back(left);
+  }
+
+  /** Place up to budget Nodes after those placed, in sorted order
+   *
+   * \param budget the most Nodes to place
+   *
+   * \return the Nodes placed
+   */
+  size_t place(size_t budget) {
+    size_t work = 0;
+    for( ; work < budget && placed < order.size(); ++work, ++placed) {
+      DataCursor before = 0 == placed ? data.unsafeBegin() : next(order[placed - 1]);
+      order[placed].getNode()->moveBefore(before.getNode());
+    }
+    if(order.size() == placed) {
+      finished();
+    }
+    return work;
+  }
+
+  /** \return next of cursor \param cursor to return the next of */
+  static DataCursor next(DataCursor cursor) {
+    return ++cursor;
+  }
+
+  /** Release the sort's storage and end the sort */
+  void finished() {
+    std::vector<DataCursor>().swap(order);
+    std::vector<DataCursor>().swap(merged);
+    phase = DONE;
+    metrics.done();
+  }
+
+  /** \return true if a is less than b, noting the comparison in metrics
+   *
+   * \param a the value to compare with b
+   * \param b the value to compare with a
+   */
+  bool less(const T& a, const T& b) {
+    metrics.compare(a, b);
+    return lessor(a, b);
+  }
+
+  /** The list sorted */
+  DataList& data;
+
+  /** What the next step() works on */
+  Phase phase;
+
+  /** The next value to count or collect */
+  DataCursor uncollected;
+
+  /** The values counted */
+  size_t counted;
+
+  /** The values, in runs bounded by bounds */
+  std::vector<DataCursor> order;
+
+  /** Runs of order merged so far, bounded by mergedBounds */
+  std::vector<DataCursor> merged;
+
+  /** The start of each run of order, and its size */
+  std::vector<size_t> bounds;
+
+  /** The start of each run of merged so far */
+  std::vector<size_t> mergedBounds;
+
+  /** The index in bounds of the left run being merged */
+  size_t run;
+
+  /** The next value of the left run */
+  size_t left;
+
+  /** The end of the left run */
+  size_t leftEnd;
+
+  /** The next value of the right run */
+  size_t right;
+
+  /** The end of the right run */
+  size_t rightEnd;
+
+  /** The number of Nodes placed */
+  size_t placed;
+  };
+
+} // namespace Experiment
+
+#endif // INCREMENTAL_LIST_SORT_H
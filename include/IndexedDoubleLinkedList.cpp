@@ -0,0 +1,434 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INDEXED_DOUBLE_LINKED_LIST_CPP
+#define INDEXED_DOUBLE_LINKED_LIST_CPP
+
+/** \file
+ *
+ * Implementations of longer template methods of the IndexedDoubleLinkedList.h file.
+ *
+ * \note This file to be included at the end of IndexedDoubleLinkedList.h
+ */
+
+namespace Experiment {
+
+  template<typename T, typename Positions>
+  const uint32_t IndexedDoubleLinkedList<T, Positions>::NONE;
+
+  /** Create a new list. */
+  template<typename T, typename Positions>
+  IndexedDoubleLinkedList<T, Positions>::IndexedDoubleLinkedList()
+    : freeHead(NONE), length(0), head(NONE), tail(NONE)
+  {
+  }
+
+  /** Remove all data from this list, invalidating all iterators.
+   *
+   * \note If the value_type is a pointer, the pointers will not be deleted.
+   */
+  template<typename T, typename Positions>
+  void IndexedDoubleLinkedList<T, Positions>::clear() {
+    nodes.clear();
+    freeHead = NONE;
+    length = 0;
+    head = NONE;
+    tail = NONE;
+    Positions::cleared();
+  }
+
+  /** \return true if this list has no data, otherwise false */
+  template<typename T, typename Positions>
+  bool IndexedDoubleLinkedList<T, Positions>::isEmpty() const {
+    return NONE == head;
+  }
+
+  /** \return the number of values in this list */
+  template<typename T, typename Positions>
+  size_t IndexedDoubleLinkedList<T, Positions>::size() const {
+    return length;
+  }
+
+  /** Allocate storage for count values so that adding up to count values does
+   * not reallocate.
+   *
+   * \param count of values to allocate storage for
+   */
+  template<typename T, typename Positions>
+  void IndexedDoubleLinkedList<T, Positions>::reserve(size_t count) {
+    nodes.reserve(count);
+    Positions::reserved(count);
+  }
+
+  /** \return an iterator pointing to the first element of this list */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::iterator IndexedDoubleLinkedList<T, Positions>::begin() {
+    return iterator(this, head);
+  }
+  
+  /** \return an iterator pointing beyond the last element of this list */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::iterator IndexedDoubleLinkedList<T, Positions>::end() {
+    return iterator(this, NONE);
+  }
+
+  /** \return a read-only iterator pointing to the first element of this list */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::const_iterator IndexedDoubleLinkedList<T, Positions>::begin() const {
+    return const_iterator(this, head);
+  }
+  
+  /** \return a read-only iterator pointing beyond the last element of this list */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::const_iterator IndexedDoubleLinkedList<T, Positions>::end() const {
+    return const_iterator(this, NONE);
+  }
+
+  /** \return a read-only iterator pointing to the first element of this list */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::const_iterator IndexedDoubleLinkedList<T, Positions>::cbegin() const {
+    return begin();
+  }
+  
+  /** \return a read-only iterator pointing beyond the last element of this list */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::const_iterator IndexedDoubleLinkedList<T, Positions>::cend() const {
+    return end();
+  }
+
+  /** \return an iterator at position of this list, or end() for position of size()
+   *
+   * \param position of the element
+   *
+   * \throw std::out_of_range if position is more than size()
+   */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::iterator IndexedDoubleLinkedList<T, Positions>::at(size_t position) {
+    if(length < position) {
+      throw std::out_of_range("position is past the end of the list");
+    }
+    return iterator(this, Positions::at(*this, position));
+  }
+
+  /** \return a read-only iterator at position of this list, or end() for position of size()
+   *
+   * \param position of the element
+   *
+   * \throw std::out_of_range if position is more than size()
+   */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::const_iterator IndexedDoubleLinkedList<T, Positions>::at(size_t position) const {
+    if(length < position) {
+      throw std::out_of_range("position is past the end of the list");
+    }
+    return const_iterator(this, Positions::at(*this, position));
+  }
+
+  /** \return the position of iter in this list, or size() for end()
+   *
+   * \param iter an iterator of this list
+   */
+  template<typename T, typename Positions>
+  size_t IndexedDoubleLinkedList<T, Positions>::positionOf(const const_iterator& iter) const {
+    return Positions::positionOf(*this, iter.getIndex());
+  }
+
+  /** Insert value as the first item in this list
+   *
+   * \param value to insert at the start of the list
+   *
+   * \throw std::length_error if the list cannot be indexed with 32 bits
+   */
+  template<typename T, typename Positions>
+  void IndexedDoubleLinkedList<T, Positions>::push_front(const value_type& value) {
+    linkBefore(append(value), head);
+  }
+
+  /** Insert value as the last item in this list
+   *
+   * \param value to insert at the end of the list
+   *
+   * \throw std::length_error if the list cannot be indexed with 32 bits
+   */
+  template<typename T, typename Positions>
+  void IndexedDoubleLinkedList<T, Positions>::push_back(const value_type& value) {
+    linkBefore(append(value), NONE);
+  }
+
+  /** Remove the value at at, keeping its node for reuse.
+   *
+   * Iterators at other values stay with their values; those at at are invalidated.
+   *
+   * \param at the iterator at the value to remove, which must not be end()
+   *
+   * \return an iterator at the value after the one removed, or end() for none
+   */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::iterator IndexedDoubleLinkedList<T, Positions>::erase(const iterator& at) {
+    const uint32_t index = at.getIndex();
+    const uint32_t next = nodes[index].theNext;
+    unlink(index);
+
+    nodes[index].theNext = freeHead;
+    freeHead = index;
+    --length;
+    return iterator(this, next);
+  }
+
+  /** Move the value at move before the value at before.
+   *
+   * Iterators stay with their values.
+   *
+   * \param move the iterator at the value to move, which must not be end()
+   * \param before the iterator at the value to move before, or end()
+   */
+  template<typename T, typename Positions>
+  void IndexedDoubleLinkedList<T, Positions>::moveBefore(const iterator& move, const iterator& before) {
+    const uint32_t index = move.getIndex();
+    if(index == before.getIndex() || nodes[index].theNext == before.getIndex()) {
+      return;
+    }
+    
+    unlink(index);
+    linkBefore(index, before.getIndex());
+  }
+
+  /** Swap the positions of the values at a and b.
+   *
+   * Iterators stay with their values.
+   *
+   * \param a the iterator at the value to swap with b, which must not be end()
+   * \param b the iterator at the value to swap with a, which must not be end()
+   */
+  template<typename T, typename Positions>
+  void IndexedDoubleLinkedList<T, Positions>::swapWith(const iterator& a, const iterator& b) {
+    const uint32_t aIndex = a.getIndex();
+    const uint32_t bIndex = b.getIndex();
+    if(aIndex == bIndex) {
+      return;
+    }
+
+    // Adjacent: ... a b ... or ... b a ...
+    const uint32_t afterA = nodes[aIndex].theNext;
+    if(afterA == bIndex) {
+      unlink(bIndex);
+      linkBefore(bIndex, aIndex);
+      return;
+    }
+    const uint32_t afterB = nodes[bIndex].theNext;
+    if(afterB == aIndex) {
+      unlink(aIndex);
+      linkBefore(aIndex, bIndex);
+      return;
+    }
+
+    // Disjoint: put each where the other was
+    unlink(aIndex);
+    linkBefore(aIndex, afterB);
+    unlink(bIndex);
+    linkBefore(bIndex, afterA);
+  }
+
+  /** Relink all values of this list into the order given by [first, last).
+   *
+   * Only the links are rewritten, in a single pass; no value is copied.
+   * Iterators stay with their values.
+   *
+   * \param first the first iterator of the new order
+   * \param last the position after the last iterator of the new order
+   *
+   * \tparam CursorIter an input iterator over iterators of this list, which must
+   * hold each element of this list exactly once
+   */
+  template<typename T, typename Positions>
+  template<class CursorIter>
+  void IndexedDoubleLinkedList<T, Positions>::relink(CursorIter first, CursorIter last) {
+    uint32_t previous = NONE;
+    for( ; first != last; ++first) {
+      const uint32_t index = first->getIndex();
+      nodes[index].thePrevious = previous;
+      if(NONE == previous) {
+	head = index;
+      } else {
+	nodes[previous].theNext = index;
+      }
+      previous = index;
+    }
+    
+    if(NONE != previous) {
+      nodes[previous].theNext = NONE;
+    }
+    tail = previous;
+    Positions::rebuilt(*this);
+  }
+
+  /** Reorder storage so that it matches list order, such as after a sort, so
+   * that traversal walks memory sequentially, and release erased nodes.
+   *
+   * This moves every value once and invalidates all iterators.
+   */
+  template<typename T, typename Positions>
+  void IndexedDoubleLinkedList<T, Positions>::compact() {
+    std::vector<Node> ordered;
+    ordered.reserve(nodes.size());
+    
+    uint32_t position = 0;
+    for(uint32_t index = head; NONE != index; index = nodes[index].theNext, ++position) {
+      ordered.push_back(Node(0 == position ? NONE : position - 1, position + 1, nodes[index].theT));
+    }
+
+    if(!ordered.empty()) {
+      ordered.back().theNext = NONE;
+      head = 0;
+      tail = position - 1;
+    }
+    nodes.swap(ordered);
+    freeHead = NONE;
+    Positions::rebuilt(*this);
+  }
+
+  /** \return the index after index, or NONE for none
+   *
+   * \param index of the element to find the next of, or NONE to remain at NONE
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T, typename Positions>
+  uint32_t IndexedDoubleLinkedList<T, Positions>::nextOf(uint32_t index) const {
+    return NONE == index ? NONE : nodes[index].theNext;
+  }
+
+  /** \return the index before index, or NONE for none
+   *
+   * \param index of the element to find the previous of, or NONE for the last element
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T, typename Positions>
+  uint32_t IndexedDoubleLinkedList<T, Positions>::previousOf(uint32_t index) const {
+    return NONE == index ? tail : nodes[index].thePrevious;
+  }
+
+  /** \return the index positions after index, or before it for negative
+   * positions, where NONE is the position after the last element
+   *
+   * \param index of the element to start from, or NONE
+   * \param positions to advance
+   *
+   * \throw std::out_of_range if that is before the first element or after NONE
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T, typename Positions>
+  uint32_t IndexedDoubleLinkedList<T, Positions>::advanceFrom(uint32_t index, std::ptrdiff_t positions) const {
+    return Positions::advance(*this, index, positions);
+  }
+
+  /** \return a reference to the value at index, which must not be NONE
+   *
+   * \param index of the element
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T, typename Positions>
+  typename IndexedDoubleLinkedList<T, Positions>::value_type& IndexedDoubleLinkedList<T, Positions>::valueAt(uint32_t index) {
+    return nodes[index].theT;
+  }
+
+  /** \return a const reference to the value at index, which must not be NONE
+   *
+   * \param index of the element
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T, typename Positions>
+  const typename IndexedDoubleLinkedList<T, Positions>::value_type& IndexedDoubleLinkedList<T, Positions>::valueAt(uint32_t index) const {
+    return nodes[index].theT;
+  }
+
+  /** Store value in a new, unlinked Node, reusing an erased one if any.
+   *
+   * \param value to store
+   *
+   * \return the index of the new Node
+   *
+   * \throw std::length_error if the list cannot be indexed with 32 bits
+   */
+  template<typename T, typename Positions>
+  uint32_t IndexedDoubleLinkedList<T, Positions>::append(const value_type& value) {
+    if(NONE != freeHead) {
+      const uint32_t index = freeHead;
+      freeHead = nodes[index].theNext;
+      nodes[index] = Node(NONE, NONE, value);
+      ++length;
+      return index;
+    }
+
+    if(NONE <= nodes.size()) {
+      throw std::length_error("IndexedDoubleLinkedList is full");
+    }
+    
+    nodes.push_back(Node(NONE, NONE, value));
+    ++length;
+    return static_cast<uint32_t>(nodes.size() - 1);
+  }
+
+  /** Unlink the Node at index from its neighbours, linking them to each other.
+   *
+   * \param index of the linked Node to unlink
+   */
+  template<typename T, typename Positions>
+  void IndexedDoubleLinkedList<T, Positions>::unlink(uint32_t index) {
+    Node& node = nodes[index];
+    if(NONE == node.thePrevious) {
+      head = node.theNext;
+    } else {
+      nodes[node.thePrevious].theNext = node.theNext;
+    }
+    
+    if(NONE == node.theNext) {
+      tail = node.thePrevious;
+    } else {
+      nodes[node.theNext].thePrevious = node.thePrevious;
+    }
+    Positions::unlinked(index);
+  }
+
+  /** Link the unlinked Node at index before the Node at before.
+   *
+   * \param index of the unlinked Node to link
+   * \param before the index of the Node to link before, or NONE to link last
+   */
+  template<typename T, typename Positions>
+  void IndexedDoubleLinkedList<T, Positions>::linkBefore(uint32_t index, uint32_t before) {
+    Node& node = nodes[index];
+    node.theNext = before;
+    node.thePrevious = (NONE == before) ? tail : nodes[before].thePrevious;
+    
+    if(NONE == node.thePrevious) {
+      head = index;
+    } else {
+      nodes[node.thePrevious].theNext = index;
+    }
+    
+    if(NONE == before) {
+      tail = index;
+    } else {
+      nodes[before].thePrevious = index;
+    }
+    Positions::linked(index, before);
+  }
+
+} // namespace Experiment
+
+#endif // INDEXED_DOUBLE_LINKED_LIST_CPP
@@ -0,0 +1,392 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INDEXED_DOUBLE_LINKED_LIST_H
+#define INDEXED_DOUBLE_LINKED_LIST_H
+
+/** \file
+ * Indexed Double Linked List definition.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <stdint.h>
+
+#ifndef POSITION_INDEX_H
+#include "PositionIndex.h"
+#endif // POSITION_INDEX_H
+
+namespace Experiment {
+
+  /** Lightweight iterator over an IndexedDoubleLinkedList.
+   *
+   * This is a list and an index, trivially copyable, and stays with its element
+   * as the list is relinked.  It is invalidated by IndexedDoubleLinkedList::compact()
+   * and IndexedDoubleLinkedList::clear().
+   *
+   * These are created by the lists themselves.
+   *
+   * \note operator+=, operator+, operator-= and operator- find the position
+   * through the list, as IndexedDoubleLinkedList::advanceFrom(): in O(log n)
+   * with a PositionIndex, otherwise, as for a MappedDoubleLinkedList, by
+   * walking.
+   *
+   * \tparam T the type of data held by the list, const for a read-only IndexedCursor
+   * \tparam List the type of list this iterates, const for a read-only IndexedCursor
+   */
+  template <class T, class List>
+    class IndexedCursor {
+  public:
+    /** IndexedCursors move forward and backward one position at a time */
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+    /** The type of data held by the list */
+    typedef typename std::remove_const<T>::type value_type;
+
+    /** The type of the distance between two IndexedCursors */
+    typedef std::ptrdiff_t difference_type;
+
+    /** The type of a pointer to the data at an IndexedCursor */
+    typedef T* pointer;
+
+    /** The type of a reference to the data at an IndexedCursor */
+    typedef T& reference;
+
+  public:
+    /** Create an IndexedCursor at no position of no list */
+    IndexedCursor()
+      : list(NULL), index(0)
+    {
+    }
+
+    /** Create an IndexedCursor at index of theList
+     *
+     * \param theList to iterate
+     * \param at the index of the element to point at, or List::NONE for end()
+     */
+    IndexedCursor(List* theList, uint32_t at)
+      : list(theList), index(at)
+    {
+    }
+
+    /** Create an IndexedCursor at the same position as rhs, such as a read-only
+     * IndexedCursor from a modifiable one.
+     *
+     * \param rhs the IndexedCursor to copy the position of
+     */
+    template <class OtherT, class OtherList>
+      IndexedCursor(const IndexedCursor<OtherT, OtherList>& rhs,
+		    typename std::enable_if<std::is_convertible<OtherList*, List*>::value>::type* = NULL)
+      : list(rhs.getList()), index(rhs.getIndex())
+    {
+    }
+
+    // All other constructors, destructors, and assignment operators = default
+
+  public:
+    /** \return true if this is at the same position as rhs, otherwise false
+     *
+     * \param rhs to compare position against
+     */
+    bool operator==(const IndexedCursor& rhs) const {
+      return index == rhs.index;
+    }
+
+    /** \return true if this is not at the same position as rhs, otherwise false
+     *
+     * \param rhs to compare position against
+     */
+    bool operator!=(const IndexedCursor& rhs) const {
+      return index != rhs.index;
+    }
+
+    /** Advance this IndexedCursor one position, stopping at end().
+     *
+     * \return this IndexedCursor after advancement
+     */
+    IndexedCursor& operator++() {
+      index = list->nextOf(index);
+      return *this;
+    }
+
+    /** Advance this IndexedCursor one position, stopping at end().
+     *
+     * \return an IndexedCursor at the original position
+     */
+    IndexedCursor operator++(int) {
+      IndexedCursor copy(*this);
+      ++(*this);
+      return copy;
+    }
+
+    /** Decrement this IndexedCursor one position, where end() moves to the last
+     * element.
+     *
+     * \return this IndexedCursor after decrement
+     */
+    IndexedCursor& operator--() {
+      index = list->previousOf(index);
+      return *this;
+    }
+
+    /** Decrement this IndexedCursor one position, where end() moves to the last
+     * element.
+     *
+     * \return an IndexedCursor at the original position
+     */
+    IndexedCursor operator--(int) {
+      IndexedCursor copy(*this);
+      --(*this);
+      return copy;
+    }
+
+    /** Advance this IndexedCursor positions, or move it back for negative positions.
+     *
+     * \param positions to advance
+     *
+     * \return this IndexedCursor after advancement
+     *
+     * \throw std::out_of_range if that is before begin() or after end()
+     */
+    IndexedCursor& operator+=(difference_type positions) {
+      index = list->advanceFrom(index, positions);
+      return *this;
+    }
+
+    /** \return an IndexedCursor advanced positions from this one
+     *
+     * \param positions to advance the returned IndexedCursor
+     *
+     * \throw std::out_of_range if that is before begin() or after end()
+     */
+    IndexedCursor operator+(difference_type positions) const {
+      IndexedCursor iter(*this);
+      iter += positions;
+      return iter;
+    }
+
+    /** Move this IndexedCursor back positions, or advance it for negative positions.
+     *
+     * \param positions to move back
+     *
+     * \return this IndexedCursor after the move
+     *
+     * \throw std::out_of_range if that is before begin() or after end()
+     */
+    IndexedCursor& operator-=(difference_type positions) {
+      return (*this) += -positions;
+    }
+
+    /** \return an IndexedCursor moved back positions from this one
+     *
+     * \param positions to move the returned IndexedCursor back
+     *
+     * \throw std::out_of_range if that is before begin() or after end()
+     */
+    IndexedCursor operator-(difference_type positions) const {
+      IndexedCursor iter(*this);
+      iter -= positions;
+      return iter;
+    }
+
+    /** \return the value at this IndexedCursor, which must be at a valid position */
+    T& operator*() const {
+      return list->valueAt(index);
+    }
+
+    /** \return a pointer to the value at this IndexedCursor, which must be at a valid position */
+    T* operator->() const {
+      return &operator*();
+    }
+
+    /** \return the list this iterates */
+    List* getList() const {
+      return list;
+    }
+
+    /** \return the index of the element this is at, or List::NONE for end() */
+    uint32_t getIndex() const {
+      return index;
+    }
+
+  private:
+    /** The list we are iterating */
+    List* list;
+
+    /** The index of the element we are pointing at */
+    uint32_t index;
+  };
+
+  /** Advance iter by positions, or move it back for negative positions, as
+   * IndexedCursor::operator+=().
+   *
+   * \param iter the IndexedCursor to advance
+   * \param positions to advance
+   *
+   * \tparam T the type of data held by the list
+   * \tparam List the type of list iter iterates
+   */
+  template <class T, class List>
+    void advance(IndexedCursor<T, List>& iter, typename IndexedCursor<T, List>::difference_type positions) {
+    iter += positions;
+  }
+  
+  /** Double linked list whose nodes live in a single growable array and link to
+   * each other by 32-bit index rather than by pointer.
+   *
+   * Compared to DoubleLinkedList, each node has no vptr and half-sized links, and
+   * all nodes are allocated together, so traversal stays within one block of
+   * memory.  Relinking (moveBefore(), swapWith(), sorting) changes only the links,
+   * so storage order drifts from list order -- compact() restores it.
+   *
+   * Elements cannot move between lists.  erase() keeps the node of the value
+   * removed for reuse by the next value added, until compact() or clear().
+   *
+   * at(), positionOf() and advanceFrom() find elements by position as the
+   * Positions policy does: NoPositionIndex walks the list and costs nothing
+   * otherwise, while PositionIndex finds them in O(log n) for O(log n) to
+   * add, erase or move each element.
+   *
+   * \tparam T the type of Data this IndexedDoubleLinkedList will hold
+   * \tparam Positions the policy finding elements by position, as
+   * NoPositionIndex or PositionIndex
+   */
+  template<class T, class Positions = NoPositionIndex>
+    class IndexedDoubleLinkedList : private Positions {
+  public:
+    /** Convenience typedef of the type of values in this list */
+    typedef T value_type;
+    
+    /** Convenience typedef of iterators of this list */
+    typedef IndexedCursor<value_type, IndexedDoubleLinkedList<value_type, Positions> > iterator;
+    
+    /** Convenience typedef of read-only iterators of this list */
+    typedef IndexedCursor<const value_type, const IndexedDoubleLinkedList<value_type, Positions> > const_iterator;
+
+    /** The index meaning no element, such as end() */
+    static const uint32_t NONE = 0xFFFFFFFFu;
+
+  private:
+    /** A node in the array of nodes: the links to its neighbours and its value */
+    struct Node {
+      /** Create a Node holding value between previous and next
+       *
+       * \param previous the index of the Node before this, or NONE for none
+       * \param next the index of the Node after this, or NONE for none
+       * \param value to copy into this Node
+       */
+      Node(uint32_t previous, uint32_t next, const value_type& value)
+	: thePrevious(previous), theNext(next), theT(value)
+      {
+      }
+
+      /** The index of the Node before this, or NONE for none */
+      uint32_t thePrevious;
+
+      /** The index of the Node after this, or NONE for none */
+      uint32_t theNext;
+
+      /** The value in this Node */
+      value_type theT;
+    };
+
+  public:
+    IndexedDoubleLinkedList();
+
+    // All other constructors, destructors, and assignment operators = default
+    
+    void clear();
+    
+    bool isEmpty() const;
+    
+    size_t size() const;
+    
+    void reserve(size_t count);
+    
+    iterator begin();
+    
+    iterator end();
+    
+    const_iterator begin() const;
+    
+    const_iterator end() const;
+    
+    const_iterator cbegin() const;
+    
+    const_iterator cend() const;
+    
+    iterator at(size_t position);
+    
+    const_iterator at(size_t position) const;
+    
+    size_t positionOf(const const_iterator& iter) const;
+    
+    void push_front(const value_type& value);
+    
+    void push_back(const value_type& value);
+    
+    iterator erase(const iterator& at);
+    
+    void moveBefore(const iterator& move, const iterator& before);
+    
+    void swapWith(const iterator& a, const iterator& b);
+    
+    template<class CursorIter>
+      void relink(CursorIter first, CursorIter last);
+    
+    void compact();
+    
+  public:
+    uint32_t nextOf(uint32_t index) const;
+    
+    uint32_t previousOf(uint32_t index) const;
+    
+    uint32_t advanceFrom(uint32_t index, std::ptrdiff_t positions) const;
+    
+    value_type& valueAt(uint32_t index);
+    
+    const value_type& valueAt(uint32_t index) const;
+    
+  private:
+    uint32_t append(const value_type& value);
+    
+    void unlink(uint32_t index);
+    
+    void linkBefore(uint32_t index, uint32_t before);
+    
+  private:
+    /** All nodes, in the order they were added (or list order after compact()) */
+    std::vector<Node> nodes;
+    
+    /** Index of the first erased Node, linked through theNext, or NONE for none */
+    uint32_t freeHead;
+    
+    /** Number of values in the list */
+    size_t length;
+    
+    /** Index of the first Node in the list, or NONE for none */
+    uint32_t head;
+    
+    /** Index of the last Node in the list, or NONE for none */
+    uint32_t tail;
+  };
+  
+} // namespace Experiment
+
+#include "IndexedDoubleLinkedList.cpp"
+
+#endif // INDEXED_DOUBLE_LINKED_LIST_H
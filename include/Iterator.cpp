@@ -23,7 +23,16 @@ namespace Experiment {
   /** Destroy iterator */
   template<typename T, typename List, typename Node>
   Iterator<T, List, Node>::~Iterator() {
-    list->removeIterator(this);
+    if(NULL != list) {
+      list->removeIterator(this);
+    }
+  }
+
+  /** Create Iterator at no position of no list, such as to be assigned later */
+  template<typename T, typename List, typename Node>
+  Iterator<T, List, Node>::Iterator()
+    : list(NULL), current(NULL)
+  {
   }
 
   /** Create Iterator for theList at the value of at
@@ -47,7 +56,9 @@ namespace Experiment {
   Iterator<T, List, Node>::Iterator(const Iterator& rhs)
     : list(rhs.list), current(rhs.current)
   {
-    list->addIterator(this);
+    if(NULL != list) {
+      list->addIterator(this);
+    }
   }
 
   /** Update Iterator to be at the same position of the same list as rhs
@@ -57,12 +68,20 @@ namespace Experiment {
   template<typename T, typename List, typename Node>
   Iterator<T, List, Node>& Iterator<T, List, Node>::operator=(const Iterator& rhs)
   {
-    list->removeIterator(this);
+    if(this == &rhs) {
+      return *this;
+    }
+    
+    if(NULL != list) {
+      list->removeIterator(this);
+    }
 
     list = rhs.list;
     current = rhs.current;
 
-    list->addIterator(this);
+    if(NULL != list) {
+      list->addIterator(this);
+    }
 
     return *this;
   }
@@ -135,7 +154,7 @@ namespace Experiment {
    * \param positions to advance the returned iterator
    */
   template<typename T, typename List, typename Node>
-  Iterator<T, List, Node> Iterator<T, List, Node>::operator+(int positions) {
+  Iterator<T, List, Node> Iterator<T, List, Node>::operator+(int positions) const {
     Iterator<T, List, Node> iter(list, current);
     iter += positions;
     return iter;
@@ -180,7 +199,7 @@ namespace Experiment {
    * \param positions to decrement the returned iterator
    */
   template<typename T, typename List, typename Node>
-  Iterator<T, List, Node> Iterator<T, List, Node>::operator-(int positions) {
+  Iterator<T, List, Node> Iterator<T, List, Node>::operator-(int positions) const {
     Iterator iter(list, current);
     iter -= positions;
     return iter;
@@ -224,7 +243,7 @@ namespace Experiment {
    * \throw std::out_of_range if this is not at a valid position
    */
   template<typename T, typename List, typename Node>
-  T& Iterator<T, List, Node>::operator*() {
+  T& Iterator<T, List, Node>::operator*() const {
     if(NULL == current) {
       throw std::out_of_range("this position has no value");
     }
@@ -237,10 +256,19 @@ namespace Experiment {
    * \throw std::out_of_range if this is not at a valid position
    */
   template<typename T, typename List, typename Node>
-  T* Iterator<T, List, Node>::operator->() {
+  T* Iterator<T, List, Node>::operator->() const {
     return &operator*();
   }
 
+  /** \return the Node this iterator is at
+   *
+   * \todo Conceal from public access.
+   */
+  template<typename T, typename List, typename Node>
+  Node* Iterator<T, List, Node>::getNode() const {
+    return current;
+  }
+
   /** Update this iterator, if appropriate, that the values at a and b
    * swapped positions.
    *
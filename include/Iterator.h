@@ -18,6 +18,9 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  * Iterator definition.
  */
 
+#include <cstddef>
+#include <iterator>
+
 namespace Experiment {
   
   /** Iterator class that works genericly on a List containing Node elements
@@ -25,15 +28,40 @@ namespace Experiment {
    *
    * These are created by the lists themselves.
    *
+   * Iterator is a standard bidirectional iterator, so it may be used with the
+   * standard algorithms.  Every Iterator registers with its list to be kept at its
+   * position, so the algorithms' copies are not free -- prefer the list's
+   * const_iterator for read-only traversal.
+   *
+   * \note operator+=, operator+, operator-= and operator- are conveniences which
+   * walk one position at a time, as do distance() and advance().
+   *
    * \tparam T the type of data held by the Nodes
    * \tparam List the type of list this iterates
    * \tparam Node the type of Node in the list
    */
   template <class T, class List, class Node>
     class Iterator {
+  public:
+    /** Iterators move forward and backward one position at a time */
+    typedef std::bidirectional_iterator_tag iterator_category;
+
+    /** The type of data held by the Nodes */
+    typedef T value_type;
+
+    /** The type of the distance between two Iterators */
+    typedef std::ptrdiff_t difference_type;
+
+    /** The type of a pointer to the data at an Iterator */
+    typedef T* pointer;
+
+    /** The type of a reference to the data at an Iterator */
+    typedef T& reference;
+
   public:
     ~Iterator();
     
+    Iterator();
     Iterator(List* theList, Node* at);
     Iterator(const Iterator& rhs);
     Iterator& operator=(const Iterator& rhs);
@@ -47,19 +75,21 @@ namespace Experiment {
     Iterator operator++(int);
     
     Iterator& operator+=(int positions);
-    Iterator operator+(int positions);
+    Iterator operator+(int positions) const;
     
     Iterator& operator--();
     Iterator operator--(int);
     
     Iterator& operator-=(int positions);
-    Iterator operator-(int positions);
+    Iterator operator-(int positions) const;
     
     void swapWith(Iterator& other);
     void moveBefore(Iterator& other);
     
-    T& operator*();
-    T* operator->();
+    T& operator*() const;
+    T* operator->() const;
+    
+    Node* getNode() const;
     
     void swapOccurred(Node* a, Node* b) ;
     void insertedBefore(Node* after, int count);
@@ -100,6 +130,44 @@ namespace Experiment {
     void moveBefore( Iterator<T, List, Node> & a, Iterator<T, List, Node> & b ) {
     a.moveBefore(b);
   }
+
+  /** Advance iter by positions, or move it back for negative positions.
+   *
+   * This walks one position at a time without creating any other Iterator.
+   *
+   * \param iter the Iterator to advance
+   * \param positions to advance
+   *
+   * \tparam T the type of data held by the Nodes
+   * \tparam List the type of list this iterates
+   * \tparam Node the type of Node in the list
+   */
+  template <class T, class List, class Node>
+    void advance(Iterator<T, List, Node>& iter, typename Iterator<T, List, Node>::difference_type positions) {
+    iter += static_cast<int>(positions);
+  }
+
+  /** \return the number of positions from first to last, which must be reachable
+   * by advancing first.
+   *
+   * This walks the Nodes without creating any other Iterator.
+   *
+   * \param first the Iterator to count from
+   * \param last the Iterator to count to
+   *
+   * \tparam T the type of data held by the Nodes
+   * \tparam List the type of list this iterates
+   * \tparam Node the type of Node in the list
+   */
+  template <class T, class List, class Node>
+    typename Iterator<T, List, Node>::difference_type distance(const Iterator<T, List, Node>& first,
+							       const Iterator<T, List, Node>& last) {
+    typename Iterator<T, List, Node>::difference_type count = 0;
+    for(const Node* node = first.getNode(); last.getNode() != node; node = node->getNext()) {
+      ++count;
+    }
+    return count;
+  }
   
 } // namespace Experiment
 
@@ -0,0 +1,190 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LIST_KEY_SORT_H
+#define LIST_KEY_SORT_H
+
+/** \file
+ * DoubleLinkedList-based sort by an extracted key
+ */
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+#ifndef LIST_MERGE_SORT_H
+#include "ListMergeSort.h"
+#endif // LIST_MERGE_SORT_H
+
+#ifndef RADIX_SORT_H
+#include "RadixSort.h"
+#endif // RADIX_SORT_H
+
+namespace Experiment {
+  
+  /** Stable sort by a key extracted from each value, for records sorted by one
+   * field.
+   *
+   * Each value is visited once to extract its key into a compact array of
+   * (key, position) entries.  Only that array is sorted -- by radix sort for
+   * arithmetic keys, otherwise by std::stable_sort using operator< -- so the
+   * records themselves are not dragged through the cache at each comparison.
+   * Finally, sort() taking a DoubleLinkedList relinks its nodes in the sorted
+   * order in a single pass, without copying any value.
+   *
+   * \tparam T the data type being sorted
+   * \tparam KeyExtractor callable returning the key of a const T& -- \see IdentityKey as an example
+   * \tparam Iterator the iterator of ranges given to sort(begin, end)
+   * \tparam Metrics to collect metrics on the sort -- \see NoSortMetrics as an example
+   */
+  template<class T, class KeyExtractor, class Iterator = T*, class Metrics = NoSortMetrics<T> >
+    class ListKeySort {
+  public:
+  /** Convenience typedef of the type of data in the list */
+  typedef T value_type;
+
+  /** The type of key KeyExtractor extracts */
+  typedef typename std::decay<decltype(std::declval<KeyExtractor&>()(std::declval<const T&>()))>::type key_type;
+
+  /** Convenience typedef of the type of list used in this sort */
+  typedef DoubleLinkedList<T> DataList;
+
+  private:
+  /** Convenience typedef of the non-tracking iterator of DataList */
+  typedef typename DataList::unsafe_iterator DataCursor;
+
+  public:
+  
+  /** Sort from begin to end by copying.
+   *
+   * The keys are sorted with the addresses of their values, then the values
+   * are copied once to temporary storage in sorted order and copied back.
+   *
+   * \param begin first value to sort
+   * \param end the position after the last value to sort
+   */ 
+  void sort(const Iterator begin, const Iterator end) {
+    metrics.reset();
+    
+    std::vector<const T*> order;
+    for(Iterator iter = begin; iter != end; ++iter) {
+      order.push_back(&*iter);
+    }
+    sortByKey(order, std::integral_constant<bool, RadixKey<key_type>::supported>());
+
+    std::vector<T> sorted;
+    sorted.reserve(order.size());
+    for(typename std::vector<const T*>::const_iterator iter = order.begin(); order.end() != iter; ++iter) {
+      sorted.push_back(**iter);
+    }
+
+    Iterator originalIter = begin;
+    for(typename std::vector<T>::const_iterator sortedIter = sorted.begin(); sorted.end() != sortedIter; ++sortedIter, ++originalIter) {
+      *originalIter = *sortedIter;
+    }
+    
+    metrics.done();
+  }
+
+  /** Sort the values in data by relinking its nodes once in sorted order.
+   *
+   * No value is copied.  As for other changes to a DoubleLinkedList, its
+   * iterators remain at the same positions.
+   *
+   * \param data the list to sort
+   *
+   * \tparam Stats the statistics policy of the list
+   */
+  template<class Stats>
+  void sort(DoubleLinkedList<T, Stats>& data) {
+    metrics.reset();
+    
+    std::vector<DataCursor> order;
+    for(DataCursor iter = data.unsafeBegin(); data.unsafeEnd() != iter; ++iter) {
+      order.push_back(iter);
+    }
+    sortByKey(order, std::integral_constant<bool, RadixKey<key_type>::supported>());
+    data.relink(order.begin(), order.end());
+    
+    metrics.done();
+  }
+
+  private:
+
+  /** Stable sort of positions by the radix-sortable key of the value at each.
+   *
+   * \param positions to sort, each dereferencing to a value
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  void sortByKey(std::vector<Position>& positions, std::true_type) {
+    typedef RadixKey<key_type> Radix;
+    typedef RadixEntry<typename Radix::unsigned_type, Position> Entry;
+
+    std::vector<Entry> entries(positions.size());
+    for(size_t i = 0; i < positions.size(); ++i) {
+      entries[i].key = Radix::toUnsigned(keyOf(*positions[i]));
+      entries[i].payload = positions[i];
+    }
+
+    radixSort(entries);
+
+    for(size_t i = 0; i < positions.size(); ++i) {
+      positions[i] = entries[i].payload;
+    }
+  }
+
+  /** Stable sort of positions by the key of the value at each using operator<.
+   *
+   * \param positions to sort, each dereferencing to a value
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  void sortByKey(std::vector<Position>& positions, std::false_type) {
+    typedef std::pair<key_type, Position> Entry;
+
+    std::vector<Entry> entries;
+    entries.reserve(positions.size());
+    for(size_t i = 0; i < positions.size(); ++i) {
+      entries.push_back(Entry(keyOf(*positions[i]), positions[i]));
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+	return a.first < b.first;
+      });
+
+    for(size_t i = 0; i < positions.size(); ++i) {
+      positions[i] = entries[i].second;
+    }
+  }
+
+  private:
+  /** Extractor of the key of each value */
+  KeyExtractor keyOf;
+ 
+  public:
+  /** Collection of metrics for the caller to inspect details of the sort */
+  Metrics metrics;
+  };
+
+} // namespace Experiment
+
+#endif // LIST_KEY_SORT_H
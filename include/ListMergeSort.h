@@ -18,11 +18,27 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  * DoubleLinkedList-based Merge Sort
  */
 
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
 #ifndef DOUBLE_LINKED_LIST_H
 #include "DoubleLinkedList.h"
 #endif // DOUBLE_LINKED_LIST_H
 
+#ifndef PREFETCH_H
+#include "Prefetch.h"
+#endif // PREFETCH_H
+
+#ifndef SORT_KERNELS_H
+#include "SortKernels.h"
+#endif // SORT_KERNELS_H
+
 namespace Experiment {
+
+  template<class T, class Positions> class IndexedDoubleLinkedList;
+  template<class T> class MappedDoubleLinkedList;
   
   /** Do-nothing Metric-collector for major actions done by ListMergeSort.
    *
@@ -52,6 +68,8 @@ namespace Experiment {
    * will sort without copying the values in the List -- the list will be
    * disassembled and reassembled in the correct order.
    *
+   * The sort is stable: equal values keep their order.
+   *
    * \tparam T the data type being sorted
    * \tparam Lessor to compare items
    * \tparam Metrics to collect metrics on the sort -- \see NoSortMetrics as an example
@@ -69,13 +87,33 @@ namespace Experiment {
   typedef typename DataList::iterator DataIter;
   
   private:
+  /** Convenience typedef of the non-tracking iterator of DataList */
+  typedef typename DataList::unsafe_iterator DataCursor;
+
   /** Convenience typedef of the type of a list of DataList used in this sort */  
   typedef DoubleLinkedList<DataList> ListList;
 
-  /** Convenience typedef of the iterator of ListList */
-  typedef typename ListList::iterator ListIter;
+  /** Convenience typedef of the non-tracking iterator of ListList.
+   *
+   * ListList and its DataLists are temporaries of this sort, so no iterator of
+   * them needs to keep its position.
+   */
+  typedef typename ListList::unsafe_iterator ListCursor;
+
+  /** Whether sort(begin, end) starts from runs sorted by SortKernels rather
+   * than from single values: for types the kernels support, compared by
+   * std::less and without metrics, which the kernels do not report to.
+   */
+  typedef std::integral_constant<bool, SortKernels::Supported<T>::value
+                                 && std::is_same<Lessor, std::less<T> >::value
+                                 && std::is_same<Metrics, NoSortMetrics<T> >::value> UseKernels;
   
   public:
+  /** Create a sort prefetching Prefetch::DEFAULT_DISTANCE Nodes ahead while merging */
+  ListMergeSort()
+    : prefetchDistance(Prefetch::DEFAULT_DISTANCE)
+  {
+  }
   
   /** Sort from begin to end by copying.
    *
@@ -85,6 +123,10 @@ namespace Experiment {
    * This avoids copying values at each stage of the sort as an array-based
    * merge sort would; however, it still copies the values twice.
    *
+   * For arithmetic values compared by std::less, the values are copied in
+   * runs of 2 * SortKernels::BLOCK sorted by sorting networks, rather than
+   * one by one, so merging starts from those runs.
+   *
    * \param begin first value to sort
    * \param end the position after the last value to sort
    */ 
@@ -95,11 +137,7 @@ namespace Experiment {
     
     // Load initial list
     ListList listA;
-    for(Iterator iter = begin; iter != end; ++iter) {
-      listA.push_back(DataList());
-      ListIter added = listA.end() - 1;
-      added->push_back(*iter);
-    }
+    load(listA, begin, end, UseKernels());
     
     // Create second ListList, location flag, and merge
     ListList listB;
@@ -110,8 +148,8 @@ namespace Experiment {
     // Overwrite original list
     {
       Iterator originalIter = begin;
-      DataIter sortedIter = sorted.begin();
-      for( ; originalIter != end && sorted.end() != sortedIter; ++originalIter, ++sortedIter) {
+      typename DataList::const_iterator sortedIter = sorted.cbegin();
+      for( ; originalIter != end && sorted.cend() != sortedIter; ++originalIter, ++sortedIter) {
 	*originalIter = *sortedIter; 
       }
 
@@ -122,19 +160,25 @@ namespace Experiment {
 
   /** Sort the values in data in constant memory by removing the disassembling
    * data, sorting the values and reassembling it.
+   *
+   * \param data the list to sort
+   *
+   * \tparam Stats the statistics policy of the list
    */
-  void sort(DataList& data) {
-    if(data.isEmpty() || data.end() == data.begin() + 1) {
+  template<class Stats>
+  void sort(DoubleLinkedList<T, Stats>& data) {
+    if(data.isEmpty() || data.unsafeEnd() == next(data.unsafeBegin())) {
       return;
     }
     
-    // Remove from argument
+    // Remove from argument, keeping the caller's iterators of data at their positions
     ListList listA;
-    for(Iterator iter = data.begin(); data.end() != data.begin(); iter = data.begin()) {
+    while(!data.isEmpty()) {
+      DataCursor iter = data.unsafeBegin();
+      DataCursor after = next(iter);
       listA.push_back(DataList());
-      ListIter added = listA.end() - 1;
-      DataIter dest = added->end();
-      moveBefore(iter, dest);
+      iter.moveBefore(last(listA)->unsafeEnd());
+      data.notifyItersRemovedBefore(1, after.getNode());
     }
 
     // Create second ListList, location flag, and merge
@@ -145,10 +189,123 @@ namespace Experiment {
 
     // Populate argument
     moveAll(sorted, data);
+    metrics.done();
+  }
+
+  /** Sort the values in data by relinking, without copying any value.
+   *
+   * The list's nodes already share one array, so this merge sorts an array of
+   * iterators to them and then relinks data once in the sorted order.  Call
+   * IndexedDoubleLinkedList::compact() afterwards to also put storage in order.
+   *
+   * \param data the list to sort
+   *
+   * \note IndexedDoubleLinkedList.h must be included to use this.
+   *
+   * \tparam Positions the position policy of the list
+   */
+  template<class Positions>
+  void sort(IndexedDoubleLinkedList<T, Positions>& data) {
+    sortByRelink(data);
+  }
+
+  /** Sort the values in data by relinking the nodes in its file, without
+   * copying any value.
+   *
+   * As for IndexedDoubleLinkedList, this merge sorts an array of iterators and
+   * then rewrites only the links, once, in the sorted order.
+   *
+   * \param data the list to sort
+   *
+   * \note MappedDoubleLinkedList.h must be included to use this.
+   */
+  void sort(MappedDoubleLinkedList<T>& data) {
+    sortByRelink(data);
   }
 
   private:
 
+  /** Sort data by stable sorting an array of its iterators and relinking data
+   * once in that order.
+   *
+   * \param data the list to sort
+   *
+   * \tparam List a list with iterators that stay with their values and relink()
+   */
+  template<class List>
+  void sortByRelink(List& data) {
+    typedef typename List::iterator ListIter;
+    
+    std::vector<ListIter> order;
+    order.reserve(data.size());
+    for(ListIter iter = data.begin(); data.end() != iter; ++iter) {
+      order.push_back(iter);
+    }
+
+    metrics.reset();
+    std::stable_sort(order.begin(), order.end(), [this](const ListIter& a, const ListIter& b) {
+	metrics.compare(*a, *b);
+	return lessor(*a, *b);
+      });
+    data.relink(order.begin(), order.end());
+    metrics.done();
+  }
+
+  /** Load listA with a DataList of each value from begin to end
+   *
+   * \param listA to load
+   * \param begin first value to load
+   * \param end the position after the last value to load
+   *
+   * \tparam Iter the type of iterator to load from
+   */
+  template<class Iter>
+  void load(ListList& listA, const Iter begin, const Iter end, std::false_type) {
+    for(Iter iter = begin; iter != end; ++iter) {
+      listA.push_back(DataList());
+      last(listA)->push_back(*iter);
+    }
+  }
+
+  /** Load listA with a sorted DataList of each run of 2 * SortKernels::BLOCK
+   * values from begin to end.
+   *
+   * \param listA to load
+   * \param begin first value to load
+   * \param end the position after the last value to load
+   */
+  void load(ListList& listA, const Iterator begin, const Iterator end, std::true_type) {
+    const size_t RUN = 2 * SortKernels::BLOCK;
+    T run[RUN];
+    
+    Iterator iter = begin;
+    while(iter != end) {
+      size_t length = 0;
+      for( ; iter != end && length < RUN; ++iter, ++length) {
+	run[length] = *iter;
+      }
+
+      // NaN would not sort before the padding of a partial run
+      if(length < RUN && !SortKernels::isPaddable(run, length)) {
+	load(listA, run, run + length, std::false_type());
+	break;
+      }
+      std::fill(run + length, run + RUN, SortKernels::padding<T>());
+
+      SortKernels::sortBlock(run);
+      if(SortKernels::BLOCK < length) {
+	SortKernels::sortBlock(run + SortKernels::BLOCK);
+	SortKernels::mergeBlocks(run);
+      }
+
+      listA.push_back(DataList());
+      DataList& sorted = *last(listA);
+      for(size_t index = 0; index < length; ++index) {
+	sorted.push_back(run[index]);
+      }
+    }
+  }
+
   /** merge listA and listB such that which list data is in at the start and
    * end is determined by dataInListA.
    *
@@ -178,7 +335,7 @@ namespace Experiment {
       ListList& input = dataInListA ? listA : listB;
       ListList& output = dataInListA ? listB : listA;
        
-      if(input.end() == input.begin() + 1) {
+      if(input.unsafeEnd() == next(input.unsafeBegin())) {
 	break;
       }
        
@@ -186,7 +343,7 @@ namespace Experiment {
       mergeLists(input, output);
     }
      
-    return *(dataInListA ? listA : listB).begin();
+    return *(dataInListA ? listA : listB).unsafeBegin();
   }
 
   /** Perform one iteration of merging of sequential pairs of lists in input
@@ -202,21 +359,21 @@ namespace Experiment {
   void mergeLists(ListList& input, ListList& output) {
     output.clear();
     // Pass across input list
-    ListIter listIter = input.begin();
-    while(input.end() != listIter) {
+    ListCursor listIter = input.unsafeBegin();
+    while(input.unsafeEnd() != listIter) {
       // Create new DataList for merge(DataList, DataList) -> DataList
       output.push_back(DataList());
-      ListIter current = output.end() - 1;
+      ListCursor current = last(output);
      
       // Grab next one or two (if available) from input
-      ListIter first = listIter;
+      ListCursor first = listIter;
       ++listIter;
      
-      ListIter second = listIter;
+      ListCursor second = listIter;
       ++listIter;
      
       // Merge the one and possible second list together
-      if(input.end() == second) {
+      if(input.unsafeEnd() == second) {
 	// No second list, copy first as new entry in output
 	moveAll(*first, *current);
       } else {
@@ -233,17 +390,22 @@ namespace Experiment {
    * \param out DataList containing the merge sort of first and second
    */
   void mergeTwo(DataList& first, DataList& second, DataList& out) {
-    // Merge first and second into new entry in output
-    DataIter dest = out.end();
+    // Merge first and second into new entry in output, prefetching ahead in each
+    DataCursor dest = out.unsafeEnd();
+    Prefetch::Lookahead<DataCursor> firstAhead(first.unsafeBegin(), first.unsafeEnd(), prefetchDistance, lessor);
+    Prefetch::Lookahead<DataCursor> secondAhead(second.unsafeBegin(), second.unsafeEnd(), prefetchDistance, lessor);
     while(!first.isEmpty() && !second.isEmpty()) {
-      DataIter firstIter = first.begin();
-      DataIter secondIter = second.begin();
-      metrics.compare(*firstIter, *secondIter);
-      if(lessor(*firstIter, *secondIter)) {
+      DataCursor firstIter = first.unsafeBegin();
+      DataCursor secondIter = second.unsafeBegin();
+      // Equal values take first, which came before second, keeping the sort stable
+      metrics.compare(*secondIter, *firstIter);
+      if(!lessor(*secondIter, *firstIter)) {
 	metrics.swap();
-	moveBefore(firstIter, dest);
+	firstIter.moveBefore(dest);
+	firstAhead.advance(lessor);
       } else {
-	moveBefore(secondIter, dest);
+	secondIter.moveBefore(dest);
+	secondAhead.advance(lessor);
       }
     }
 
@@ -257,15 +419,36 @@ namespace Experiment {
    *
    * \param from to move all values, if any, to the end of to
    * \param to to move all values, if any, from from to the end of
+   *
+   * \tparam ToList the type of to, a DoubleLinkedList of T
    */
-  void moveAll(DataList& from, DataList& to) {
+  template<class ToList>
+  void moveAll(DataList& from, ToList& to) {
+    DataCursor dest = to.unsafeEnd();
     while(!from.isEmpty()) {
-      DataIter iter = from.begin();
-      DataIter dest = to.end();
-      moveBefore(iter, dest);
+      from.unsafeBegin().moveBefore(dest);
     }
   }
 
+  /** \return a Cursor one position after at
+   *
+   * \param at the Cursor to advance from
+   *
+   * \tparam Cursor the type of Cursor
+   */
+  template<class Cursor>
+  static Cursor next(Cursor at) {
+    return ++at;
+  }
+
+  /** \return a Cursor at the last DataList of list, which must not be empty
+   *
+   * \param list to find the last DataList of
+   */
+  static ListCursor last(ListList& list) {
+    return --list.unsafeEnd();
+  }
+
   private:
   /** Comparator to decide if one value is less than another */
   Lessor lessor;
@@ -273,6 +456,13 @@ namespace Experiment {
   public:
   /** Collection of metrics for the caller to inspect details of the sort */
   Metrics metrics;
+
+  /** Nodes to prefetch ahead of each list being merged, 0 for none.
+   *
+   * Where Lessor has a payload hook -- \see Prefetch::Payload -- what the values
+   * refer to is prefetched as well.
+   */
+  size_t prefetchDistance;
   };
 
 } // namespace Experiment
@@ -0,0 +1,339 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LIST_PARALLEL_H
+#define LIST_PARALLEL_H
+
+/** \file
+ * Parallel algorithms over the values of a DoubleLinkedList
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+namespace Experiment {
+
+  /** Parallel algorithms over the values of a DoubleLinkedList, split into
+   * segments once by a single sequential walk and reused by every algorithm
+   * run after.
+   *
+   * The walk keeps every stride-th node as a segment start, doubling stride
+   * and dropping every other start whenever there are twice as many starts
+   * as wanted, so it needs neither the length of the list nor a second
+   * pass.  Segments are then taken by threads as each finishes its last, so
+   * uneven work per value still balances.
+   *
+   * Segments are kept as unsafe_iterators: after nodes are inserted into or
+   * removed from the list, call resegment() before running another
+   * algorithm.  Changing values, as transformInPlace() does, keeps them.
+   *
+   * \tparam T the type of values in the list
+   * \tparam Stats the statistics policy of the list
+   */
+  template<class T, class Stats = NoListStats>
+    class ListParallel {
+  public:
+  /** Convenience typedef of the type of data in the list */
+  typedef T value_type;
+
+  /** Convenience typedef of the type of list */
+  typedef DoubleLinkedList<T, Stats> DataList;
+
+  private:
+  /** Convenience typedef of the non-tracking iterator of DataList */
+  typedef typename DataList::unsafe_iterator DataCursor;
+
+  /** The result of one segment, wrapped so that each is an object of its
+   * own: the elements of a std::vector<bool> share words, so threads
+   * writing neighbouring results would race.
+   *
+   * \tparam Result the type of results
+   */
+  template<class Result>
+  struct SegmentResult {
+    /** Create holding theValue \param theValue the result so far */
+    explicit SegmentResult(const Result& theValue)
+      : value(theValue)
+    {
+    }
+
+    /** The result of the segment */
+    Result value;
+  };
+
+  public:
+  /** Segments wanted per thread, so threads finishing early take more */
+  static const size_t SEGMENTS_PER_THREAD = 4;
+
+  /** Create splitting the values of data into segments for threads.
+   *
+   * \param theData the list to run algorithms over
+   * \param theThreads the number of threads to run on, or 0 for one per
+   * hardware thread
+   */
+  explicit ListParallel(DataList& theData, unsigned int theThreads = 0)
+    : data(theData),
+      threads(0 == theThreads ? std::max(1u, std::thread::hardware_concurrency()) : theThreads)
+  {
+    resegment();
+  }
+
+  /** Split the values of the list into segments again, after nodes were
+   * inserted or removed.
+   */
+  void resegment() {
+    const size_t wanted = threads * SEGMENTS_PER_THREAD;
+    starts.clear();
+    size_t stride = 1;
+    size_t position = 0;
+    for(DataCursor iter = data.unsafeBegin(); data.unsafeEnd() != iter; ++iter, ++position) {
+      if(0 != position % stride) {
+	continue;
+      }
+      if(2 * wanted <= starts.size()) {
+	// Keep the starts at multiples of the doubled stride
+	for(size_t index = 0; 2 * index < starts.size(); ++index) {
+	  starts[index] = starts[2 * index];
+	}
+	starts.resize((starts.size() + 1) / 2);
+	stride *= 2;
+	if(0 != position % stride) {
+	  continue;
+	}
+      }
+      starts.push_back(iter);
+    }
+  }
+
+  /** \return the number of segments the values are split into */
+  size_t segments() const {
+    return starts.size();
+  }
+
+  /** Call function with each value, on several threads at once.
+   *
+   * \param function called as function(T& value) for each value, from any
+   * of the threads
+   *
+   * \throw the first exception of function, by segment, once all threads
+   * finish; values of other segments may have been visited
+   *
+   * \tparam Function callable with a T&, safely from several threads at once
+   */
+  template<class Function>
+  void forEach(Function function) {
+    run([this, &function](size_t segment) {
+	const DataCursor last = end(segment);
+	for(DataCursor iter = starts[segment]; last != iter; ++iter) {
+	  function(*iter);
+	}
+      });
+  }
+
+  /** Replace each value with function of it, on several threads at once.
+   *
+   * \param function called as function(const T& value), returning the
+   * replacement for value
+   *
+   * \throw the first exception of function, by segment, once all threads
+   * finish; values of other segments may have been replaced
+   *
+   * \tparam Function callable with a const T& returning a T, safely from
+   * several threads at once
+   */
+  template<class Function>
+  void transformInPlace(Function function) {
+    run([this, &function](size_t segment) {
+	const DataCursor last = end(segment);
+	for(DataCursor iter = starts[segment]; last != iter; ++iter) {
+	  *iter = function(*iter);
+	}
+      });
+  }
+
+  /** \return combine of map of each value, starting from identity, folded on
+   * several threads at once.
+   *
+   * Each segment is folded from identity on its own, then the segments'
+   * results are combined in list order, so combine must be associative with
+   * identity its identity, but need not be commutative.
+   *
+   * \param identity the result for no values
+   * \param map called as map(const T& value), returning the Result of value
+   * \param combine called as combine(Result, Result), returning the Result of both
+   *
+   * \throw the first exception of map or combine, by segment, once all
+   * threads finish
+   *
+   * \tparam Result the type of results
+   * \tparam Map callable with a const T& returning a Result, safely from
+   * several threads at once
+   * \tparam Combine callable with two Results returning a Result, safely
+   * from several threads at once
+   */
+  template<class Result, class Map, class Combine>
+  Result reduce(const Result& identity, Map map, Combine combine) {
+    std::vector<SegmentResult<Result> > results(starts.size(), SegmentResult<Result>(identity));
+    run([this, &results, &map, &combine](size_t segment) {
+	const DataCursor last = end(segment);
+	Result result = results[segment].value;
+	for(DataCursor iter = starts[segment]; last != iter; ++iter) {
+	  result = combine(result, map(*iter));
+	}
+	results[segment].value = result;
+      });
+
+    Result result = identity;
+    for(typename std::vector<SegmentResult<Result> >::const_iterator iter = results.begin(); results.end() != iter; ++iter) {
+      result = combine(result, iter->value);
+    }
+    return result;
+  }
+
+  private:
+  /** \return the position after the last value of segment
+   *
+   * \param segment the index of the segment
+   */
+  DataCursor end(size_t segment) {
+    return segment + 1 < starts.size() ? starts[segment + 1] : data.unsafeEnd();
+  }
+
+  /** Run work on each segment, taken in turn by threads as they finish their
+   * last, then rethrow the first exception of work, by segment.
+   *
+   * \param work called as work(size_t segment)
+   *
+   * \note Work of threads which cannot be started is done on this thread.
+   *
+   * \tparam Work callable with the index of a segment
+   */
+  template<class Work>
+  void run(Work work) {
+    const size_t workers = std::min(static_cast<size_t>(threads), starts.size());
+    std::vector<std::exception_ptr> errors(starts.size());
+    std::atomic<size_t> next(0);
+    auto worker = [this, &work, &errors, &next]() {
+      for(size_t segment = next++; segment < starts.size(); segment = next++) {
+	try {
+	  work(segment);
+	} catch(...) {
+	  errors[segment] = std::current_exception();
+	}
+      }
+    };
+
+    // Start as many threads as we can, and work on this one
+    std::vector<std::thread> started;
+    try {
+      for(size_t count = 1; count < workers; ++count) {
+	started.push_back(std::thread(worker));
+      }
+    } catch(...) {
+      // The threads started and this one take all segments
+    }
+    worker();
+    for(typename std::vector<std::thread>::iterator iter = started.begin(); started.end() != iter; ++iter) {
+      iter->join();
+    }
+
+    for(typename std::vector<std::exception_ptr>::const_iterator iter = errors.begin(); errors.end() != iter; ++iter) {
+      if(*iter) {
+	std::rethrow_exception(*iter);
+      }
+    }
+  }
+
+  private:
+  /** The list to run algorithms over */
+  DataList& data;
+
+  /** The number of threads to run on */
+  const unsigned int threads;
+
+  /** The first value of each segment, in list order */
+  std::vector<DataCursor> starts;
+  };
+
+  template<class T, class Stats>
+  const size_t ListParallel<T, Stats>::SEGMENTS_PER_THREAD;
+
+  /** Call function with each value of data, on several threads at once --
+   * \see ListParallel::forEach()
+   *
+   * \param data the list of values
+   * \param function called as function(T& value) for each value
+   * \param threads the number of threads to run on, or 0 for one per
+   * hardware thread
+   *
+   * \tparam T the type of values
+   * \tparam Stats the statistics policy of data
+   * \tparam Function callable with a T&, safely from several threads at once
+   */
+  template<class T, class Stats, class Function>
+    void parallelForEach(DoubleLinkedList<T, Stats>& data, Function function, unsigned int threads = 0) {
+    ListParallel<T, Stats>(data, threads).forEach(function);
+  }
+
+  /** Replace each value of data with function of it, on several threads at
+   * once -- \see ListParallel::transformInPlace()
+   *
+   * \param data the list of values
+   * \param function called as function(const T& value), returning the
+   * replacement for value
+   * \param threads the number of threads to run on, or 0 for one per
+   * hardware thread
+   *
+   * \tparam T the type of values
+   * \tparam Stats the statistics policy of data
+   * \tparam Function callable with a const T& returning a T, safely from
+   * several threads at once
+   */
+  template<class T, class Stats, class Function>
+    void parallelTransformInPlace(DoubleLinkedList<T, Stats>& data, Function function, unsigned int threads = 0) {
+    ListParallel<T, Stats>(data, threads).transformInPlace(function);
+  }
+
+  /** \return combine of map of each value of data, starting from identity,
+   * folded on several threads at once -- \see ListParallel::reduce()
+   *
+   * \param data the list of values
+   * \param identity the result for no values
+   * \param map called as map(const T& value), returning the Result of value
+   * \param combine called as combine(Result, Result), returning the Result of both
+   * \param threads the number of threads to run on, or 0 for one per
+   * hardware thread
+   *
+   * \tparam T the type of values
+   * \tparam Stats the statistics policy of data
+   * \tparam Result the type of results
+   * \tparam Map callable with a const T& returning a Result, safely from
+   * several threads at once
+   * \tparam Combine callable with two Results returning a Result, safely
+   * from several threads at once
+   */
+  template<class T, class Stats, class Result, class Map, class Combine>
+    Result parallelReduce(DoubleLinkedList<T, Stats>& data, const Result& identity, Map map, Combine combine, unsigned int threads = 0) {
+    return ListParallel<T, Stats>(data, threads).reduce(identity, map, combine);
+  }
+
+} // namespace Experiment
+
+#endif // LIST_PARALLEL_H
@@ -0,0 +1,272 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LIST_QUICK_SORT_H
+#define LIST_QUICK_SORT_H
+
+/** \file
+ * DoubleLinkedList-based three-way partitioning Quick Sort
+ */
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+#ifndef LIST_MERGE_SORT_H
+#include "ListMergeSort.h"
+#endif // LIST_MERGE_SORT_H
+
+namespace Experiment {
+  
+  /** Unstable Quick Sort partitioning into less, equal and greater, for data
+   * with few distinct values.
+   *
+   * Each partition step splits the values into those less than, equal to and
+   * greater than a median-of-three pivot, and only the less and greater parts
+   * are sorted further.  Every equal value is therefore final after one step,
+   * so data with k distinct values takes O(n k) comparisons rather than
+   * O(n log n).  Should partitioning recurse more than 2 log2(n) deep, the
+   * remaining part is merge sorted instead, bounding the worst case to
+   * O(n log n).
+   *
+   * Only positions of the values are partitioned, never the values.  sort()
+   * taking a DoubleLinkedList then relinks its nodes in a single pass,
+   * without copying any value.
+   *
+   * \tparam T the data type being sorted
+   * \tparam Iterator the iterator of ranges given to sort(begin, end)
+   * \tparam Lessor to compare items
+   * \tparam Metrics to collect metrics on the sort -- \see NoSortMetrics as an example
+   */
+  template<class T, class Iterator = T*, class Lessor = std::less<T>, class Metrics = NoSortMetrics<T> >
+    class ListQuickSort {
+  public:
+  /** Convenience typedef of the type of data in the list */
+  typedef T value_type;
+
+  /** Convenience typedef of the type of list used in this sort */
+  typedef DoubleLinkedList<T> DataList;
+
+  /** Parts of at most this many values are insertion sorted rather than partitioned */
+  static const size_t INSERTION_LIMIT = 16;
+
+  private:
+  /** Convenience typedef of the non-tracking iterator of DataList */
+  typedef typename DataList::unsafe_iterator DataCursor;
+
+  public:
+  
+  /** Sort from begin to end by copying.
+   *
+   * The addresses of the values are sorted, then the values are copied once to
+   * temporary storage in sorted order and copied back.
+   *
+   * \param begin first value to sort
+   * \param end the position after the last value to sort
+   */ 
+  void sort(const Iterator begin, const Iterator end) {
+    metrics.reset();
+    
+    std::vector<const T*> order;
+    for(Iterator iter = begin; iter != end; ++iter) {
+      order.push_back(&*iter);
+    }
+    sortPositions(order);
+
+    std::vector<T> sorted;
+    sorted.reserve(order.size());
+    for(typename std::vector<const T*>::const_iterator iter = order.begin(); order.end() != iter; ++iter) {
+      sorted.push_back(**iter);
+    }
+
+    Iterator originalIter = begin;
+    for(typename std::vector<T>::const_iterator sortedIter = sorted.begin(); sorted.end() != sortedIter; ++sortedIter, ++originalIter) {
+      *originalIter = *sortedIter;
+    }
+    
+    metrics.done();
+  }
+
+  /** Sort the values in data by relinking its nodes once in sorted order.
+   *
+   * No value is copied.  As for other changes to a DoubleLinkedList, its
+   * iterators remain at the same positions.
+   *
+   * \param data the list to sort
+   *
+   * \tparam Stats the statistics policy of the list
+   */
+  template<class Stats>
+  void sort(DoubleLinkedList<T, Stats>& data) {
+    metrics.reset();
+    
+    std::vector<DataCursor> order;
+    for(DataCursor iter = data.unsafeBegin(); data.unsafeEnd() != iter; ++iter) {
+      order.push_back(iter);
+    }
+    sortPositions(order);
+    data.relink(order.begin(), order.end());
+    
+    metrics.done();
+  }
+
+  private:
+
+  /** Sort positions by the values at them.
+   *
+   * \param positions to sort, each dereferencing to a value
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  void sortPositions(std::vector<Position>& positions) {
+    int depth = 0;
+    for(size_t count = positions.size(); 1 < count; count >>= 1) {
+      depth += 2;
+    }
+    quickSort(positions.data(), positions.data() + positions.size(), depth);
+  }
+
+  /** Sort [first, last) by partitioning, recursing into the smaller part and
+   * looping on the larger.
+   *
+   * \param first the first position to sort
+   * \param last the position after the last position to sort
+   * \param depth the partitions left before merge sorting instead
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  void quickSort(Position* first, Position* last, int depth) {
+    while(INSERTION_LIMIT < static_cast<size_t>(last - first)) {
+      if(0 == depth--) {
+	std::stable_sort(first, last, [this](const Position& a, const Position& b) {
+	    return less(*a, *b);
+	  });
+	return;
+      }
+
+      // Values never move, so the pivot's value stays put as positions do
+      const Position pivot = medianOfThree(first, first + (last - first) / 2, last - 1);
+
+      // Dijkstra's three-way partition: [first, lower) < pivot,
+      // [lower, scan) == pivot, [upper, last) > pivot
+      Position* lower = first;
+      Position* scan = first;
+      Position* upper = last;
+      while(scan != upper) {
+	if(less(*(*scan), *pivot)) {
+	  exchange(*lower++, *scan++);
+	} else if(less(*pivot, *(*scan))) {
+	  exchange(*scan, *--upper);
+	} else {
+	  ++scan;
+	}
+      }
+
+      if(lower - first < last - upper) {
+	quickSort(first, lower, depth);
+	first = upper;
+      } else {
+	quickSort(upper, last, depth);
+	last = lower;
+      }
+    }
+    insertionSort(first, last);
+  }
+
+  /** \return the position of the median value of those at a, b and c
+   *
+   * \param a a position to sample
+   * \param b a position to sample
+   * \param c a position to sample
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  Position medianOfThree(const Position* a, const Position* b, const Position* c) {
+    if(less(**a, **b)) {
+      if(less(**b, **c)) {
+	return *b;
+      }
+      return less(**a, **c) ? *c : *a;
+    }
+    if(less(**a, **c)) {
+      return *a;
+    }
+    return less(**b, **c) ? *c : *b;
+  }
+
+  /** Insertion sort of [first, last), for short parts.
+   *
+   * \param first the first position to sort
+   * \param last the position after the last position to sort
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  void insertionSort(Position* first, Position* last) {
+    for(Position* next = first + 1; next < last; ++next) {
+      const Position inserted = *next;
+      Position* hole = next;
+      for( ; first != hole && less(*inserted, **(hole - 1)); --hole) {
+	*hole = *(hole - 1);
+	metrics.swap();
+      }
+      *hole = inserted;
+    }
+  }
+
+  /** \return true if a is less than b, noting the comparison in metrics
+   *
+   * \param a the value to compare with b
+   * \param b the value to compare with a
+   */
+  bool less(const T& a, const T& b) {
+    metrics.compare(a, b);
+    return lessor(a, b);
+  }
+
+  /** Exchange positions a and b, noting the swap in metrics
+   *
+   * \param a the position to exchange with b
+   * \param b the position to exchange with a
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  void exchange(Position& a, Position& b) {
+    std::swap(a, b);
+    metrics.swap();
+  }
+
+  private:
+  /** Comparison of values */
+  Lessor lessor;
+ 
+  public:
+  /** Collection of metrics for the caller to inspect details of the sort */
+  Metrics metrics;
+  };
+
+  template<class T, class Iterator, class Lessor, class Metrics>
+  const size_t ListQuickSort<T, Iterator, Lessor, Metrics>::INSERTION_LIMIT;
+
+} // namespace Experiment
+
+#endif // LIST_QUICK_SORT_H
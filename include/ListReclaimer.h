@@ -0,0 +1,278 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LIST_RECLAIMER_H
+#define LIST_RECLAIMER_H
+
+/** \file
+ * Freeing the Nodes of cleared lists off the caller's thread, or in slices
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+namespace Experiment {
+
+  template<class T, size_t N>
+    class SmallDoubleLinkedList;
+
+  /** Implementation details of ListReclaimer
+   *
+   * \todo Conceal this from public access
+   */
+  namespace ListReclaimerImpl {
+
+    /** A chain of Nodes detached from a list, to be freed */
+    class Chain {
+    public:
+      virtual ~Chain() { }
+
+      /** Free up to budget Nodes from the front of this chain
+       *
+       * \param budget the most Nodes to free
+       *
+       * \return the number of Nodes freed
+       */
+      virtual size_t freeSome(size_t budget) = 0;
+
+      /** \return true if all Nodes of this chain are freed */
+      virtual bool isEmpty() const = 0;
+    };
+
+    /** A chain of Nodes of T, linked by next and ending in NULL
+     *
+     * \tparam T the type of values of the Nodes
+     */
+    template<class T>
+      class NodeChain : public Chain {
+    public:
+      /** Convenience typedef of the Nodes freed */
+      typedef DoubleLinkedListImpl::Node<T> Node;
+
+      /** Create with no Nodes */
+      NodeChain()
+	: next(NULL)
+      {
+      }
+
+      /** Free all remaining Nodes */
+      virtual ~NodeChain() {
+	freeSome(SIZE_MAX);
+      }
+
+      /** Take the Nodes from first on to free \param first of the chain, or NULL */
+      void take(Node* first) {
+	next = first;
+      }
+
+      virtual size_t freeSome(size_t budget) {
+	size_t freed = 0;
+	for( ; NULL != next && freed < budget; ++freed) {
+	  Node* tmp = next;
+	  next = next->getNext();
+	  delete tmp;
+	}
+	return freed;
+      }
+
+      virtual bool isEmpty() const {
+	return NULL == next;
+      }
+
+    private:
+      /** The next Node to free, or NULL when all are */
+      Node* next;
+    };
+
+  } // namespace ListReclaimerImpl
+
+  /** Frees the Nodes of cleared lists on a background thread, or in bounded
+   * slices by reclaimSome(), so clearing a list of any length costs its
+   * caller only the walk of the list's iterators.
+   *
+   * reclaim() empties a list as clear() does, but queues its Nodes here
+   * rather than freeing them.  A background reclaimer frees queued Nodes
+   * BACKGROUND_SLICE at a time; otherwise, or as well, reclaimSome() frees a
+   * given number on the calling thread.  Destruction frees all that remain.
+   *
+   * \note Values are destroyed on the thread freeing them, so their
+   * destructors must be safe to run on another thread than the list's.
+   */
+  class ListReclaimer {
+  public:
+    /** The most Nodes the background thread frees before letting other
+     * threads reclaim
+     */
+    static const size_t BACKGROUND_SLICE = 4096;
+
+    /** Create, with a background thread freeing Nodes if background
+     *
+     * \param background true to free on a background thread, false to free
+     * only in reclaimSome(), drain() and the destructor
+     */
+    explicit ListReclaimer(bool background = true)
+      : stopping(false), active(0)
+    {
+      if(background) {
+	thread = std::thread(&ListReclaimer::run, this);
+      }
+    }
+
+    /** Stop the background thread, if any, after it frees all queued Nodes,
+     * then free any remaining on this thread
+     */
+    ~ListReclaimer() {
+      if(thread.joinable()) {
+	{
+	  std::lock_guard<std::mutex> lock(mutex);
+	  stopping = true;
+	}
+	work.notify_all();
+	thread.join();
+      }
+      while(0 < reclaimSome(SIZE_MAX)) {
+      }
+    }
+
+    ListReclaimer(const ListReclaimer&) = delete;
+    ListReclaimer& operator=(const ListReclaimer&) = delete;
+
+    /** Empty list, as clear(), queueing its Nodes to be freed here.
+     *
+     * Iterators of list at values are moved to its end, as for clear().
+     *
+     * \param list to empty, which may then be used or destroyed at once
+     *
+     * \tparam T the type of values of list
+     * \tparam Stats the statistics policy of list, told all Nodes were freed
+     */
+    template<class T, class Stats>
+      void reclaim(DoubleLinkedList<T, Stats>& list) {
+      std::unique_ptr<ListReclaimerImpl::NodeChain<T> > chain(new ListReclaimerImpl::NodeChain<T>());
+      ListReclaimerImpl::NodeChain<T>* nodes = chain.get();
+      {
+	std::lock_guard<std::mutex> lock(mutex);
+	chains.push_back(std::move(chain));
+	nodes->take(list.detach());
+      }
+      work.notify_one();
+    }
+
+    /** SmallDoubleLinkedLists keep Nodes inside themselves, which may not
+     * outlive them: clear() them instead.
+     */
+    template<class T, size_t N>
+      void reclaim(SmallDoubleLinkedList<T, N>& list) = delete;
+
+    /** Free up to budget queued Nodes on this thread.
+     *
+     * \param budget the most Nodes to free
+     *
+     * \return the number of Nodes freed, 0 once none are queued
+     */
+    size_t reclaimSome(size_t budget) {
+      size_t freed = 0;
+      while(freed < budget) {
+	std::unique_ptr<ListReclaimerImpl::Chain> chain;
+	{
+	  std::lock_guard<std::mutex> lock(mutex);
+	  if(chains.empty()) {
+	    break;
+	  }
+	  chain = std::move(chains.front());
+	  chains.pop_front();
+	  ++active;
+	}
+
+	freed += chain->freeSome(budget - freed);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	--active;
+	if(!chain->isEmpty()) {
+	  // Put it back first in line, as only budget ran out
+	  chains.push_front(std::move(chain));
+	} else {
+	  chain.reset();
+	}
+	if(chains.empty() && 0 == active) {
+	  idle.notify_all();
+	}
+      }
+      return freed;
+    }
+
+    /** Free all queued Nodes, on this thread and the background thread, and
+     * wait until none are being freed
+     */
+    void drain() {
+      while(0 < reclaimSome(SIZE_MAX)) {
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      idle.wait(lock, [this]() { return chains.empty() && 0 == active; });
+    }
+
+    /** \return true if no Nodes are queued or being freed */
+    bool isIdle() const {
+      std::lock_guard<std::mutex> lock(mutex);
+      return chains.empty() && 0 == active;
+    }
+
+  private:
+    /** Free queued Nodes BACKGROUND_SLICE at a time until stopping with none queued */
+    void run() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while(true) {
+	work.wait(lock, [this]() { return stopping || !chains.empty(); });
+	if(chains.empty()) {
+	  return;
+	}
+	lock.unlock();
+	reclaimSome(BACKGROUND_SLICE);
+	lock.lock();
+      }
+    }
+
+    /** Guards all below but thread */
+    mutable std::mutex mutex;
+
+    /** Notified when chains are queued or stopping */
+    std::condition_variable work;
+
+    /** Notified when no chains are queued or being freed */
+    std::condition_variable idle;
+
+    /** The chains queued, in order */
+    std::deque<std::unique_ptr<ListReclaimerImpl::Chain> > chains;
+
+    /** True once the background thread should stop when none are queued */
+    bool stopping;
+
+    /** The number of chains being freed, out of chains */
+    size_t active;
+
+    /** The background thread, if any */
+    std::thread thread;
+  };
+
+} // namespace Experiment
+
+#endif // LIST_RECLAIMER_H
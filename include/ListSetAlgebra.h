@@ -0,0 +1,428 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LIST_SET_ALGEBRA_H
+#define LIST_SET_ALGEBRA_H
+
+/** \file
+ * Set algebra on sorted DoubleLinkedLists by relinking their nodes
+ */
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+namespace Experiment {
+
+  template<class T, size_t N>
+    class SmallDoubleLinkedList;
+
+  /** Whether lists of type List may hold Nodes stored inline: false but for
+   * SmallDoubleLinkedList
+   *
+   * \tparam List the type of list
+   */
+  template<class List>
+  struct HoldsInlineNodes : std::false_type {
+  };
+
+  /** SmallDoubleLinkedLists hold up to N Nodes inline
+   *
+   * \tparam T the type of values
+   * \tparam N the number of Nodes held inline
+   */
+  template<class T, size_t N>
+  struct HoldsInlineNodes<SmallDoubleLinkedList<T, N> > : std::true_type {
+  };
+
+  /** Set algebra on DoubleLinkedLists sorted by Lessor, as by ListMergeSort,
+   * which moves the nodes of its inputs to its output rather than copying
+   * their values.
+   *
+   * As the std::set_ algorithms, lists are multisets: each value of one
+   * input is matched with at most one equal value of the other, and equal
+   * values are taken from the first input.  Inputs are consumed, left empty
+   * with their iterators at their ends; the results are appended to the
+   * output, whose iterators stay where they are.  Nodes not output are freed
+   * together once the result is complete.
+   *
+   * Values stored inline in a SmallDoubleLinkedList cannot outlive it, so
+   * they are copied into nodes of their own rather than moved.  Only the
+   * Nodes of inputs of that type are checked for being inline, so inline
+   * Nodes moved into a list of another type must be moved back first.
+   *
+   * \tparam T the data type in the lists
+   * \tparam Lessor by which the lists are sorted
+   */
+  template<class T, class Lessor = std::less<T> >
+    class ListSetAlgebra {
+  public:
+  /** Convenience typedef of the type of data in the list */
+  typedef T value_type;
+
+  /** Convenience typedef of the type of list used */
+  typedef DoubleLinkedList<T> DataList;
+
+  private:
+  /** Convenience typedef of the Nodes of DataList */
+  typedef DoubleLinkedListImpl::Node<T> Node;
+
+  /** Convenience typedef of the Nodes with values of DataList */
+  typedef DoubleLinkedListImpl::DataNode<T> DataNode;
+
+  /** Convenience typedef of the Nodes stored inline in a SmallDoubleLinkedList */
+  typedef DoubleLinkedListImpl::InlineDataNode<T> InlineDataNode;
+
+  /** Which values of a merge of two lists are output */
+  enum Keep {
+    /** Values of the first list without an equal value in the second */
+    FIRST_ONLY = 1,
+
+    /** Values of the second list without an equal value in the first */
+    SECOND_ONLY = 2,
+
+    /** Values of the first list matched with an equal value in the second */
+    BOTH = 4
+  };
+
+  /** The Nodes taken from a list, read in order.  Nodes read are no longer
+   * linked by the chain, so may be linked elsewhere.
+   */
+  class Chain {
+  public:
+    /** Take all Nodes of list, leaving it empty with its iterators at its end.
+     *
+     * \param list to take the Nodes of
+     *
+     * \tparam List the type of list, a DoubleLinkedList of T
+     */
+    template<class List>
+    explicit Chain(List& list)
+      : node(list.head.getNext()),
+	end(&list.tail),
+	mayHoldInline(HoldsInlineNodes<List>::value)
+    {
+      static_assert(std::is_same<typename List::value_type, T>::value, "Set algebra needs lists of T");
+      const std::vector<std::pair<size_t, typename List::iterator*> > positions = list.iteratorPositions();
+      list.head.setNext(&list.tail);
+      list.tail.setPrevious(&list.head);
+      list.restoreIteratorPositions(positions);
+    }
+
+    /** \return true if all Nodes were read */
+    bool isEmpty() const {
+      return end == node;
+    }
+
+    /** \return the value of the next Node to read */
+    const T& value() const {
+      return static_cast<DataNode*>(node)->getValue();
+    }
+
+    /** \return the next Node, no longer linked by this chain */
+    Node* take() {
+      Node* const taken = node;
+      node = node->getNext();
+      return taken;
+    }
+
+    /** \return true if the Nodes may be stored inline in their list */
+    bool holdsInline() const {
+      return mayHoldInline;
+    }
+
+  private:
+    /** The next Node to read */
+    Node* node;
+
+    /** The Node after the last to read: the tail of the list taken from */
+    const Node* const end;
+
+    /** Whether the list taken from may store Nodes inline, decided by its type */
+    const bool mayHoldInline;
+  };
+
+  public:
+  /** Remove all but the first of each run of equal values of the sorted
+   * list data, as std::unique.  Iterators remain at the same positions.
+   *
+   * \param data the list to remove duplicates from
+   *
+   * \throw whatever Lessor throws, leaving data holding the values before
+   * the failed comparison
+   *
+   * \tparam List the type of data, a DoubleLinkedList of T
+   */
+  template<class List>
+  void unique(List& data) {
+    const std::vector<std::pair<size_t, typename List::iterator*> > positions = data.iteratorPositions();
+    Chain chain(data);
+    Node* discarded = NULL;
+    try {
+      while(!chain.isEmpty()) {
+	if(data.isEmpty() || lessor(static_cast<DataNode*>(data.tail.getPrevious())->getValue(), chain.value())) {
+	  data.linkBack(chain.take());
+	} else {
+	  discard(chain.take(), data, discarded);
+	}
+      }
+    } catch(...) {
+      discardAll(chain, data, discarded);
+      freeAll(discarded);
+      data.restoreIteratorPositions(positions);
+      throw;
+    }
+    freeAll(discarded);
+    data.restoreIteratorPositions(positions);
+  }
+
+  /** Append the union of the sorted lists first and second to out, as
+   * std::set_union, consuming first and second.
+   *
+   * \param first sorted list to unite, left empty
+   * \param second sorted list to unite, left empty
+   * \param out list to append the union to
+   *
+   * \throw std::invalid_argument if any two lists are the same list
+   * \throw whatever Lessor throws, with the values after the failed
+   * comparison freed
+   *
+   * \tparam First the type of first, a DoubleLinkedList of T
+   * \tparam Second the type of second, a DoubleLinkedList of T
+   * \tparam Out the type of out, a DoubleLinkedList of T
+   */
+  template<class First, class Second, class Out>
+  void setUnion(First& first, Second& second, Out& out) {
+    merge(first, second, out, FIRST_ONLY | SECOND_ONLY | BOTH);
+  }
+
+  /** Append the intersection of the sorted lists first and second to out, as
+   * std::set_intersection, consuming first and second.
+   *
+   * \param first sorted list to intersect, left empty
+   * \param second sorted list to intersect, left empty
+   * \param out list to append the intersection to
+   *
+   * \throw std::invalid_argument if any two lists are the same list
+   * \throw whatever Lessor throws, with the values after the failed
+   * comparison freed
+   *
+   * \tparam First the type of first, a DoubleLinkedList of T
+   * \tparam Second the type of second, a DoubleLinkedList of T
+   * \tparam Out the type of out, a DoubleLinkedList of T
+   */
+  template<class First, class Second, class Out>
+  void setIntersection(First& first, Second& second, Out& out) {
+    merge(first, second, out, BOTH);
+  }
+
+  /** Append the values of the sorted list first not in the sorted list
+   * second to out, as std::set_difference, consuming first and second.
+   *
+   * \param first sorted list to take values from, left empty
+   * \param second sorted list of values to remove, left empty
+   * \param out list to append the difference to
+   *
+   * \throw std::invalid_argument if any two lists are the same list
+   * \throw whatever Lessor throws, with the values after the failed
+   * comparison freed
+   *
+   * \tparam First the type of first, a DoubleLinkedList of T
+   * \tparam Second the type of second, a DoubleLinkedList of T
+   * \tparam Out the type of out, a DoubleLinkedList of T
+   */
+  template<class First, class Second, class Out>
+  void setDifference(First& first, Second& second, Out& out) {
+    merge(first, second, out, FIRST_ONLY);
+  }
+
+  /** Append the values in only one of the sorted lists first and second to
+   * out, as std::set_symmetric_difference, consuming first and second.
+   *
+   * \param first sorted list to compare, left empty
+   * \param second sorted list to compare, left empty
+   * \param out list to append the symmetric difference to
+   *
+   * \throw std::invalid_argument if any two lists are the same list
+   * \throw whatever Lessor throws, with the values after the failed
+   * comparison freed
+   *
+   * \tparam First the type of first, a DoubleLinkedList of T
+   * \tparam Second the type of second, a DoubleLinkedList of T
+   * \tparam Out the type of out, a DoubleLinkedList of T
+   */
+  template<class First, class Second, class Out>
+  void setSymmetricDifference(First& first, Second& second, Out& out) {
+    merge(first, second, out, FIRST_ONLY | SECOND_ONLY);
+  }
+
+  private:
+  /** Merge the sorted lists first and second, appending the values kept to
+   * out and freeing the rest.
+   *
+   * \param first sorted list to merge, left empty
+   * \param second sorted list to merge, left empty
+   * \param out list to append the values kept to
+   * \param keep the Keep flags of the values to append
+   *
+   * \throw std::invalid_argument if any two lists are the same list
+   *
+   * \tparam First the type of first, a DoubleLinkedList of T
+   * \tparam Second the type of second, a DoubleLinkedList of T
+   * \tparam Out the type of out, a DoubleLinkedList of T
+   */
+  template<class First, class Second, class Out>
+  void merge(First& first, Second& second, Out& out, const int keep) {
+    const void* const firstList = &first;
+    const void* const secondList = &second;
+    const void* const outList = &out;
+    if(firstList == secondList || firstList == outList || secondList == outList) {
+      throw std::invalid_argument("Set algebra needs three distinct lists");
+    }
+
+    Chain firstChain(first);
+    Chain secondChain(second);
+    Node* discarded = NULL;
+    try {
+      while(!firstChain.isEmpty() && !secondChain.isEmpty()) {
+	if(lessor(firstChain.value(), secondChain.value())) {
+	  keepOrDiscard(firstChain, keep & FIRST_ONLY, first, out, discarded);
+	} else if(lessor(secondChain.value(), firstChain.value())) {
+	  keepOrDiscard(secondChain, keep & SECOND_ONLY, second, out, discarded);
+	} else {
+	  keepOrDiscard(firstChain, keep & BOTH, first, out, discarded);
+	  discard(secondChain.take(), second, discarded);
+	}
+      }
+      while(!firstChain.isEmpty()) {
+	keepOrDiscard(firstChain, keep & FIRST_ONLY, first, out, discarded);
+      }
+      while(!secondChain.isEmpty()) {
+	keepOrDiscard(secondChain, keep & SECOND_ONLY, second, out, discarded);
+      }
+    } catch(...) {
+      discardAll(firstChain, first, discarded);
+      discardAll(secondChain, second, discarded);
+      freeAll(discarded);
+      throw;
+    }
+    freeAll(discarded);
+  }
+
+  /** Take the next Node of chain, appending it to out if kept, otherwise
+   * discarding it.
+   *
+   * \param chain to take the Node from
+   * \param kept whether to append the Node to out
+   * \param from the list chain was taken from
+   * \param out the list to append to
+   * \param discarded the Nodes discarded so far
+   *
+   * \tparam From the type of from
+   * \tparam Out the type of out
+   */
+  template<class From, class Out>
+  void keepOrDiscard(Chain& chain, const bool kept, From& from, Out& out, Node*& discarded) {
+    if(kept) {
+      output(chain.take(), chain.holdsInline(), from, out, discarded);
+    } else {
+      discard(chain.take(), from, discarded);
+    }
+  }
+
+  /** Append node to out, copying its value into a Node of its own if it is
+   * stored inline in a SmallDoubleLinkedList.
+   *
+   * Either way, from counts node freed and out counts the Node appended
+   * allocated, so each list's statistics hold only its own Nodes.
+   *
+   * \param node the unlinked Node
+   * \param mayBeInline whether node may be stored inline, so must be checked
+   * \param from the list node was taken from
+   * \param out the list to append to
+   * \param discarded the Nodes discarded so far, to which node is added if it
+   * is copied or if copying it throws
+   *
+   * \tparam From the type of from
+   * \tparam Out the type of out
+   */
+  template<class From, class Out>
+  void output(Node* node, const bool mayBeInline, From& from, Out& out, Node*& discarded) {
+    if(mayBeInline && NULL != dynamic_cast<InlineDataNode*>(node)) {
+      discard(node, from, discarded);
+      node = new DataNode(static_cast<DataNode*>(node)->getValue());
+    } else {
+      from.stats().freed(1, sizeof(DataNode));
+    }
+    out.stats().allocated(1, sizeof(DataNode));
+    out.linkBack(node);
+  }
+
+  /** Add node to the Nodes discarded, to be freed by freeAll(), counting it
+   * freed by from
+   *
+   * \param node the unlinked Node
+   * \param from the list node was taken from
+   * \param discarded the Nodes discarded so far, singly linked by next
+   *
+   * \tparam From the type of from
+   */
+  template<class From>
+  void discard(Node* node, From& from, Node*& discarded) {
+    from.stats().freed(1, sizeof(DataNode));
+    node->setNext(discarded);
+    discarded = node;
+  }
+
+  /** Discard the Nodes left in chain
+   *
+   * \param chain to discard the rest of
+   * \param from the list chain was taken from
+   * \param discarded the Nodes discarded so far
+   *
+   * \tparam From the type of from
+   */
+  template<class From>
+  void discardAll(Chain& chain, From& from, Node*& discarded) {
+    while(!chain.isEmpty()) {
+      discard(chain.take(), from, discarded);
+    }
+  }
+
+  /** Free all Nodes discarded
+   *
+   * \param discarded the Nodes discarded, singly linked by next
+   */
+  void freeAll(Node* discarded) {
+    while(NULL != discarded) {
+      Node* const next = discarded->getNext();
+      delete discarded;
+      discarded = next;
+    }
+  }
+
+  public:
+  /** Comparison of values */
+  Lessor lessor;
+  };
+
+} // namespace Experiment
+
+#endif // LIST_SET_ALGEBRA_H
@@ -0,0 +1,320 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LIST_SNAPSHOT_H
+#define LIST_SNAPSHOT_H
+
+/** \file
+ * Binary snapshots of a DoubleLinkedList of trivially copyable values.
+ *
+ * A snapshot is a ListSnapshotHeader followed by the values in list order as
+ * their raw bytes, in the byte order of the machine that saved them.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+namespace Experiment {
+
+  /** Header at the start of each snapshot */
+  struct ListSnapshotHeader {
+    /** Identifies a snapshot: "DLLSNAP" and a terminating NUL */
+    char magic[8];
+
+    /** Version of the snapshot format */
+    uint32_t version;
+
+    /** sizeof each value */
+    uint32_t valueSize;
+
+    /** Number of values following the header */
+    uint64_t count;
+  };
+
+  namespace DoubleLinkedListImpl {
+
+    /** Values gathered into, or read from, a file at a time by snapshots */
+    const size_t SNAPSHOT_BATCH = static_cast<size_t>(1) << 20;
+
+    /** The magic of ListSnapshotHeader */
+    const char SNAPSHOT_MAGIC[8] = "DLLSNAP";
+
+    /** The version of the snapshot format written */
+    const uint32_t SNAPSHOT_VERSION = 1;
+
+    /** Write all of buffers to fd, continuing after partial writes.
+     *
+     * \param fd to write to
+     * \param buffers to write, which are consumed
+     * \param count of buffers
+     *
+     * \throw std::system_error if writing fails
+     */
+    inline void writeAll(int fd, struct iovec* buffers, int count) {
+      while(0 < count) {
+	const ssize_t written = writev(fd, buffers, count);
+	if(written < 0) {
+	  if(EINTR == errno) {
+	    continue;
+	  }
+	  throw std::system_error(errno, std::generic_category(), "writing snapshot");
+	}
+
+	// Skip what was written
+	size_t remaining = static_cast<size_t>(written);
+	while(0 < count && buffers->iov_len <= remaining) {
+	  remaining -= buffers->iov_len;
+	  ++buffers;
+	  --count;
+	}
+	if(0 < count) {
+	  buffers->iov_base = static_cast<char*>(buffers->iov_base) + remaining;
+	  buffers->iov_len -= remaining;
+	}
+      }
+    }
+
+    /** Read exactly length bytes from fd into buffer
+     *
+     * \param fd to read from
+     * \param buffer to read into
+     * \param length to read
+     *
+     * \throw std::system_error if reading fails
+     * \throw std::invalid_argument if fd ends first, so is not a whole snapshot
+     */
+    inline void readAll(int fd, void* buffer, size_t length) {
+      char* at = static_cast<char*>(buffer);
+      while(0 < length) {
+	const ssize_t got = read(fd, at, length);
+	if(got < 0) {
+	  if(EINTR == errno) {
+	    continue;
+	  }
+	  throw std::system_error(errno, std::generic_category(), "reading snapshot");
+	}
+	if(0 == got) {
+	  throw std::invalid_argument("snapshot is truncated");
+	}
+	at += got;
+	length -= static_cast<size_t>(got);
+      }
+    }
+
+    /** Check header begins a snapshot of values of valueSize bytes
+     *
+     * \param header to check
+     * \param valueSize the sizeof the values expected
+     *
+     * \throw std::invalid_argument if header is not of a snapshot of such values
+     */
+    inline void checkSnapshotHeader(const ListSnapshotHeader& header, size_t valueSize) {
+      if(0 != std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic))) {
+	throw std::invalid_argument("not a list snapshot");
+      }
+      if(SNAPSHOT_VERSION != header.version) {
+	throw std::invalid_argument("unsupported list snapshot version");
+      }
+      if(valueSize != header.valueSize) {
+	throw std::invalid_argument("list snapshot values are of a different size");
+      }
+    }
+
+    /** Closes a file descriptor when destroyed */
+    class FileCloser {
+    public:
+      /** Close fd when destroyed \param theFd to close */
+      explicit FileCloser(int theFd)
+	: fd(theFd)
+      {
+      }
+
+      /** Close the file descriptor */
+      ~FileCloser() {
+	close(fd);
+      }
+
+    private:
+      FileCloser(const FileCloser& rhs);
+      FileCloser& operator=(const FileCloser& rhs);
+
+    private:
+      /** The file descriptor to close */
+      const int fd;
+    };
+
+  } // namespace DoubleLinkedListImpl
+
+  /** Write a snapshot of list to fd at its current offset.
+   *
+   * The header and the values go out together in one writev of the header
+   * and the values gathered from the nodes, in batches of SNAPSHOT_BATCH
+   * values for longer lists.  When fd is seekable, the count in the header
+   * is written afterwards so the list is walked only once.
+   *
+   * \param list to save
+   * \param fd open for writing
+   *
+   * \throw std::system_error if writing fails
+   *
+   * \tparam T the type of values, which must be trivially copyable
+   * \tparam Stats the statistics policy of the list
+   */
+  template<class T, class Stats>
+  void saveTo(const DoubleLinkedList<T, Stats>& list, int fd) {
+    static_assert(std::is_trivially_copyable<T>::value, "snapshots hold the bytes of trivially copyable values");
+    using namespace DoubleLinkedListImpl;
+
+    const off_t start = lseek(fd, 0, SEEK_CUR);
+    const bool seekable = 0 <= start;
+
+    ListSnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.valueSize = sizeof(T);
+    header.count = seekable ? 0 : static_cast<uint64_t>(std::distance(list.cbegin(), list.cend()));
+
+    // Room for the values when their count is known, otherwise grown with them
+    std::vector<T> batch;
+    batch.reserve(std::min(static_cast<size_t>(header.count), SNAPSHOT_BATCH));
+
+    struct iovec buffers[2];
+    buffers[0].iov_base = &header;
+    buffers[0].iov_len = sizeof(header);
+    int count = 1;
+
+    uint64_t written = 0;
+    typename DoubleLinkedList<T, Stats>::const_iterator iter = list.cbegin();
+    do {
+      batch.clear();
+      for( ; list.cend() != iter && batch.size() < SNAPSHOT_BATCH; ++iter) {
+	batch.push_back(*iter);
+      }
+      written += batch.size();
+      if(seekable && list.cend() == iter && 1 == count) {
+	// All values are in the first batch, so the count is known in time
+	header.count = written;
+      }
+      buffers[count].iov_base = batch.data();
+      buffers[count].iov_len = batch.size() * sizeof(T);
+      writeAll(fd, buffers, count + 1);
+      count = 0;
+    } while(list.cend() != iter);
+
+    if(header.count != written) {
+      header.count = written;
+      const off_t countOffset = start + static_cast<off_t>(offsetof(ListSnapshotHeader, count));
+      if(static_cast<ssize_t>(sizeof(header.count)) != pwrite(fd, &header.count, sizeof(header.count), countOffset)) {
+	throw std::system_error(errno, std::generic_category(), "writing snapshot");
+      }
+    }
+  }
+
+  /** Write a snapshot of list to a file at path, replacing any file there.
+   *
+   * \param list to save
+   * \param path of the file to write
+   *
+   * \throw std::system_error if the file cannot be written
+   *
+   * \tparam T the type of values, which must be trivially copyable
+   * \tparam Stats the statistics policy of the list
+   */
+  template<class T, class Stats>
+  void saveTo(const DoubleLinkedList<T, Stats>& list, const std::string& path) {
+    const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "opening " + path);
+    }
+    DoubleLinkedListImpl::FileCloser closer(fd);
+    saveTo(list, fd);
+  }
+
+  /** Replace the values of list with those of the snapshot read from fd at
+   * its current offset.
+   *
+   * The nodes are built by DoubleLinkedList::append(), in large chunks and
+   * linked in a single pass, rather than allocated one by one.
+   *
+   * \param list to load into
+   * \param fd open for reading
+   *
+   * \throw std::invalid_argument if fd does not hold a snapshot of values of type T
+   * \throw std::system_error if reading fails
+   *
+   * \note If the snapshot is truncated or reading fails, list holds the values
+   * read before the failure.
+   *
+   * \tparam T the type of values, which must be trivially copyable
+   * \tparam Stats the statistics policy of the list
+   */
+  template<class T, class Stats>
+  void loadFrom(DoubleLinkedList<T, Stats>& list, int fd) {
+    static_assert(std::is_trivially_copyable<T>::value, "snapshots hold the bytes of trivially copyable values");
+    using namespace DoubleLinkedListImpl;
+
+    ListSnapshotHeader header;
+    readAll(fd, &header, sizeof(header));
+    checkSnapshotHeader(header, sizeof(T));
+
+    list.clear();
+    std::vector<T> batch(std::min(static_cast<size_t>(header.count), SNAPSHOT_BATCH));
+    for(uint64_t remaining = header.count; 0 < remaining; ) {
+      const size_t length = static_cast<size_t>(std::min(remaining, static_cast<uint64_t>(batch.size())));
+      readAll(fd, batch.data(), length * sizeof(T));
+      list.append(batch.data(), batch.data() + length);
+      remaining -= length;
+    }
+  }
+
+  /** Replace the values of list with those of the snapshot in the file at path.
+   *
+   * \param list to load into
+   * \param path of the file to read
+   *
+   * \throw std::invalid_argument if the file does not hold a snapshot of values of type T
+   * \throw std::system_error if the file cannot be read
+   *
+   * \tparam T the type of values, which must be trivially copyable
+   * \tparam Stats the statistics policy of the list
+   */
+  template<class T, class Stats>
+  void loadFrom(DoubleLinkedList<T, Stats>& list, const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "opening " + path);
+    }
+    DoubleLinkedListImpl::FileCloser closer(fd);
+    loadFrom(list, fd);
+  }
+
+} // namespace Experiment
+
+#endif // LIST_SNAPSHOT_H
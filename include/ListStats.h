@@ -0,0 +1,244 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LIST_STATS_H
+#define LIST_STATS_H
+
+/** \file
+ * Policies collecting statistics on what a DoubleLinkedList itself costs
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+
+namespace Experiment {
+
+  /** Statistics policy of DoubleLinkedList collecting nothing, and the
+   * example of the calls a policy receives.
+   *
+   * Every call is empty and inline, and a DoubleLinkedList inherits its
+   * policy, so this policy costs neither time nor space.  The calls are
+   * const, as some come from const methods of the list: policies keep their
+   * counts mutable.
+   */
+  class NoListStats {
+  public:
+    /** count Nodes of bytes in all were allocated */
+    void allocated(size_t count, size_t bytes) const { }
+
+    /** count Nodes of bytes in all were freed */
+    void freed(size_t count, size_t bytes) const { }
+
+    /** All Nodes were detached, to be freed elsewhere */
+    void detachedAll() const { }
+
+    /** An iterator was registered, in a Node of bytes */
+    void iteratorAdded(size_t bytes) const { }
+
+    /** An iterator was unregistered, freeing its Node of bytes */
+    void iteratorRemoved(size_t bytes) const { }
+
+    /** Iterators were notified of a swap, with callbacks to iterators */
+    void swapNotified(size_t callbacks) const { }
+
+    /** Iterators were notified of an insert, with callbacks to iterators */
+    void insertNotified(size_t callbacks) const { }
+
+    /** Iterators were notified of a removal, with callbacks to iterators */
+    void removalNotified(size_t callbacks) const { }
+
+    /** count Nodes were relinked into a new order */
+    void relinked(size_t count) const { }
+  };
+
+  /** The counts of CountingListStats at one time */
+  struct ListStatsSnapshot {
+    /** Nodes allocated */
+    size_t nodesAllocated;
+
+    /** Nodes freed */
+    size_t nodesFreed;
+
+    /** Iterators registered, each in an IterDataNode */
+    size_t iteratorsAdded;
+
+    /** Iterators unregistered */
+    size_t iteratorsRemoved;
+
+    /** Notifications of swaps to the iterators */
+    size_t swapNotifications;
+
+    /** Notifications of inserts to the iterators */
+    size_t insertNotifications;
+
+    /** Notifications of removals to the iterators */
+    size_t removalNotifications;
+
+    /** Callbacks to single iterators made by all notifications */
+    size_t iteratorCallbacks;
+
+    /** Relinks of the list into a new order */
+    size_t relinks;
+
+    /** Nodes relinked by all relinks */
+    size_t nodesRelinked;
+
+    /** Bytes of the Nodes and IterDataNodes now allocated */
+    size_t liveBytes;
+
+    /** The most liveBytes has been */
+    size_t peakBytes;
+
+    /** \return the Nodes now allocated */
+    size_t liveNodes() const {
+      return nodesAllocated - nodesFreed;
+    }
+
+    /** \return the iterators now registered */
+    size_t liveIterators() const {
+      return iteratorsAdded - iteratorsRemoved;
+    }
+  };
+
+  /** Write the counts of snapshot to out, as one line of name=value pairs
+   *
+   * \param out to write to
+   * \param snapshot to write
+   *
+   * \return out
+   */
+  inline std::ostream& operator<<(std::ostream& out, const ListStatsSnapshot& snapshot) {
+    return out << "nodesAllocated=" << snapshot.nodesAllocated
+	       << " nodesFreed=" << snapshot.nodesFreed
+	       << " iteratorsAdded=" << snapshot.iteratorsAdded
+	       << " iteratorsRemoved=" << snapshot.iteratorsRemoved
+	       << " swapNotifications=" << snapshot.swapNotifications
+	       << " insertNotifications=" << snapshot.insertNotifications
+	       << " removalNotifications=" << snapshot.removalNotifications
+	       << " iteratorCallbacks=" << snapshot.iteratorCallbacks
+	       << " relinks=" << snapshot.relinks
+	       << " nodesRelinked=" << snapshot.nodesRelinked
+	       << " liveBytes=" << snapshot.liveBytes
+	       << " peakBytes=" << snapshot.peakBytes;
+  }
+
+  /** Statistics policy of DoubleLinkedList counting every call -- \see
+   * NoListStats for the calls.
+   *
+   * Counts are kept per list and are not synchronized, as the list is not.
+   * Nodes moved to another list by Iterator::moveBefore() are counted as
+   * allocated by the list they came from and freed by the list freeing them.
+   * ListSetAlgebra instead counts the Nodes it moves as freed by the list
+   * they leave and allocated by the list they join.
+   */
+  class CountingListStats {
+  public:
+    /** Create with all counts zero */
+    CountingListStats()
+      : counts(), nodeBytes(0)
+    {
+    }
+
+    /** \return the counts now */
+    ListStatsSnapshot snapshot() const {
+      return counts;
+    }
+
+    /** Zero all counts but the bytes now live, from which the peak restarts */
+    void reset() {
+      const size_t liveBytes = counts.liveBytes;
+      counts = ListStatsSnapshot();
+      counts.liveBytes = liveBytes;
+      counts.peakBytes = liveBytes;
+    }
+
+    /** count Nodes of bytes in all were allocated */
+    void allocated(size_t count, size_t bytes) const {
+      counts.nodesAllocated += count;
+      nodeBytes += bytes;
+      grow(bytes);
+    }
+
+    /** count Nodes of bytes in all were freed */
+    void freed(size_t count, size_t bytes) const {
+      counts.nodesFreed += count;
+      nodeBytes -= std::min(bytes, nodeBytes);
+      shrink(bytes);
+    }
+
+    /** All Nodes were detached, to be freed elsewhere: count them freed */
+    void detachedAll() const {
+      counts.nodesFreed = counts.nodesAllocated;
+      shrink(nodeBytes);
+      nodeBytes = 0;
+    }
+
+    /** An iterator was registered, in a Node of bytes */
+    void iteratorAdded(size_t bytes) const {
+      ++counts.iteratorsAdded;
+      grow(bytes);
+    }
+
+    /** An iterator was unregistered, freeing its Node of bytes */
+    void iteratorRemoved(size_t bytes) const {
+      ++counts.iteratorsRemoved;
+      shrink(bytes);
+    }
+
+    /** Iterators were notified of a swap, with callbacks to iterators */
+    void swapNotified(size_t callbacks) const {
+      ++counts.swapNotifications;
+      counts.iteratorCallbacks += callbacks;
+    }
+
+    /** Iterators were notified of an insert, with callbacks to iterators */
+    void insertNotified(size_t callbacks) const {
+      ++counts.insertNotifications;
+      counts.iteratorCallbacks += callbacks;
+    }
+
+    /** Iterators were notified of a removal, with callbacks to iterators */
+    void removalNotified(size_t callbacks) const {
+      ++counts.removalNotifications;
+      counts.iteratorCallbacks += callbacks;
+    }
+
+    /** count Nodes were relinked into a new order */
+    void relinked(size_t count) const {
+      ++counts.relinks;
+      counts.nodesRelinked += count;
+    }
+
+  private:
+    /** Note bytes more are live */
+    void grow(size_t bytes) const {
+      counts.liveBytes += bytes;
+      counts.peakBytes = std::max(counts.peakBytes, counts.liveBytes);
+    }
+
+    /** Note bytes fewer are live, not below none */
+    void shrink(size_t bytes) const {
+      counts.liveBytes -= std::min(bytes, counts.liveBytes);
+    }
+
+    /** The counts */
+    mutable ListStatsSnapshot counts;
+
+    /** The bytes of Nodes, but not IterDataNodes, now allocated */
+    mutable size_t nodeBytes;
+  };
+
+} // namespace Experiment
+
+#endif // LIST_STATS_H
@@ -0,0 +1,257 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LRU_CACHE_CPP
+#define LRU_CACHE_CPP
+
+/** \file
+ *
+ * Implementations of longer template methods of the LruCache.h file.
+ *
+ * \note This file to be included at the end of LruCache.h
+ */
+
+namespace Experiment {
+
+  /** Create an empty cache.
+   *
+   * \param capacity maximum total weight of the entries, in the units of theWeigher
+   * \param theHasher to hash keys
+   * \param theWeigher to weigh entries
+   * \param theKeyEqual to compare keys
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  LruCache<K, V, Hash, Weigher, KeyEqual>::LruCache(size_t capacity, const Hash& theHasher, const Weigher& theWeigher, const KeyEqual& theKeyEqual)
+    : buckets(16, NULL), bucketBits(4), entries(0), totalWeight(0), maximumWeight(capacity),
+      hasher(theHasher), weigher(theWeigher), keyEqual(theKeyEqual)
+  {
+    // Setup the marker nodes as DoubleLinkedList does
+    head.setPrevious(&head);
+    head.setNext(&tail);
+    tail.setPrevious(&head);
+    tail.setNext(&tail);
+  }
+
+  /** Destroy a cache and all its entries. */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  LruCache<K, V, Hash, Weigher, KeyEqual>::~LruCache() {
+    clear();
+  }
+
+  /** Find the value of key, making it the most recently used.
+   *
+   * \param key to find the value of
+   *
+   * \return the value of key, valid until it is evicted or erased, or NULL if not cached
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  V* LruCache<K, V, Hash, Weigher, KeyEqual>::get(const K& key) {
+    Entry* entry = find(key, hasher(key));
+    if(NULL == entry) {
+      return NULL;
+    }
+
+    entry->moveBefore(head.getNext());
+    return &entry->getValue().second;
+  }
+
+  /** Find the value of key without changing its recency.
+   *
+   * \param key to find the value of
+   *
+   * \return the value of key, valid until it is evicted or erased, or NULL if not cached
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  const V* LruCache<K, V, Hash, Weigher, KeyEqual>::peek(const K& key) const {
+    const Entry* entry = find(key, hasher(key));
+    return NULL == entry ? NULL : &entry->getValue().second;
+  }
+
+  /** Cache value for key, replacing any value of key, as the most recently
+   * used entry.  The least recently used entries are evicted until it fits.
+   *
+   * \param key to cache value for
+   * \param value to cache
+   *
+   * \return true if cached, false if the entry alone weighs more than capacity()
+   * in which case key is no longer cached.
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  bool LruCache<K, V, Hash, Weigher, KeyEqual>::put(const K& key, const V& value) {
+    const size_t hash = hasher(key);
+    const size_t entryWeight = weigher(key, value);
+
+    // A replaced entry's node is reused, as is the first evicted one
+    Entry* reuse = find(key, hash);
+    if(NULL != reuse) {
+      unlink(reuse);
+    }
+
+    if(maximumWeight < entryWeight) {
+      delete reuse;
+      return false;
+    }
+
+    while(maximumWeight - totalWeight < entryWeight) {
+      Entry* victim = entryOf(tail.getPrevious());
+      unlink(victim);
+      if(NULL == reuse) {
+	reuse = victim;
+      } else {
+	delete victim;
+      }
+    }
+
+    Entry* entry = NULL;
+    if(NULL == reuse) {
+      entry = new Entry(key, value, hash, entryWeight);
+    } else {
+      reuse->~Entry();
+      try {
+	entry = new (reuse) Entry(key, value, hash, entryWeight);
+      } catch(...) {
+	::operator delete(reuse);
+	throw;
+      }
+    }
+    linkFront(entry);
+    return true;
+  }
+
+  /** Remove the entry of key, if any.
+   *
+   * \param key to remove the entry of
+   *
+   * \return true if key was cached, otherwise false
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  bool LruCache<K, V, Hash, Weigher, KeyEqual>::erase(const K& key) {
+    Entry* entry = find(key, hasher(key));
+    if(NULL == entry) {
+      return false;
+    }
+
+    unlink(entry);
+    delete entry;
+    return true;
+  }
+
+  /** Remove all entries from this cache. */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  void LruCache<K, V, Hash, Weigher, KeyEqual>::clear() {
+    Node* curr = head.getNext();
+    while(curr != &tail) {
+      Node* tmp = curr;
+      curr = curr->getNext();
+      delete entryOf(tmp);
+    }
+
+    head.setNext(&tail);
+    tail.setPrevious(&head);
+    std::fill(buckets.begin(), buckets.end(), static_cast<Entry*>(NULL));
+    entries = 0;
+    totalWeight = 0;
+  }
+
+  /** \return the entry of key, or NULL if none
+   *
+   * \param key to find the entry of
+   * \param hash of key
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  typename LruCache<K, V, Hash, Weigher, KeyEqual>::Entry* LruCache<K, V, Hash, Weigher, KeyEqual>::find(const K& key, size_t hash) const {
+    for(Entry* entry = buckets[bucketOf(hash)]; NULL != entry; entry = entry->hashNext) {
+      if(hash == entry->hash && keyEqual(key, entry->getValue().first)) {
+	return entry;
+      }
+    }
+    return NULL;
+  }
+
+  /** \return the index in buckets of the bucket of hash
+   *
+   * \param hash to find the bucket of
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  size_t LruCache<K, V, Hash, Weigher, KeyEqual>::bucketOf(size_t hash) const {
+    // Fibonacci hashing spreads hashes such as std::hash of integers, which
+    // are the integers themselves, across the top bits
+    return static_cast<size_t>((static_cast<unsigned long long>(hash) * 0x9E3779B97F4A7C15ULL) >> (64 - bucketBits));
+  }
+
+  /** Remove entry from its bucket and from the recency order, without deleting it.
+   *
+   * \param entry to remove
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  void LruCache<K, V, Hash, Weigher, KeyEqual>::unlink(Entry* entry) {
+    Entry** link = &buckets[bucketOf(entry->hash)];
+    while(entry != *link) {
+      link = &(*link)->hashNext;
+    }
+    *link = entry->hashNext;
+
+    entry->getPrevious()->setNext(entry->getNext());
+    entry->getNext()->setPrevious(entry->getPrevious());
+
+    --entries;
+    totalWeight -= entry->weight;
+  }
+
+  /** Add entry to its bucket and as the most recently used.
+   *
+   * \param entry to add
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  void LruCache<K, V, Hash, Weigher, KeyEqual>::linkFront(Entry* entry) {
+    Entry*& bucket = buckets[bucketOf(entry->hash)];
+    entry->hashNext = bucket;
+    bucket = entry;
+
+    Node* first = head.getNext();
+    entry->setPrevious(&head);
+    entry->setNext(first);
+    head.setNext(entry);
+    first->setPrevious(entry);
+
+    ++entries;
+    totalWeight += entry->weight;
+
+    if(buckets.size() < entries) {
+      rehash(2 * buckets.size());
+    }
+  }
+
+  /** Rebuild the buckets with bucketCount buckets.
+   *
+   * \param bucketCount the new number of buckets, a power of 2
+   */
+  template<class K, class V, class Hash, class Weigher, class KeyEqual>
+  void LruCache<K, V, Hash, Weigher, KeyEqual>::rehash(size_t bucketCount) {
+    buckets.assign(bucketCount, NULL);
+    bucketBits = 0;
+    while((static_cast<size_t>(1) << bucketBits) < bucketCount) {
+      ++bucketBits;
+    }
+
+    for(Node* node = head.getNext(); &tail != node; node = node->getNext()) {
+      Entry* entry = entryOf(node);
+      Entry*& bucket = buckets[bucketOf(entry->hash)];
+      entry->hashNext = bucket;
+      bucket = entry;
+    }
+  }
+
+} // namespace Experiment
+
+#endif // LRU_CACHE_CPP
@@ -0,0 +1,255 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+/** \file
+ * Least-Recently-Used cache definition.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifndef DOUBLE_LINKED_LIST_IMPL_H
+#include "DoubleLinkedListImpl.h"
+#endif // DOUBLE_LINKED_LIST_IMPL_H
+
+#ifndef CURSOR_H
+#include "Cursor.h"
+#endif // CURSOR_H
+
+namespace Experiment {
+
+  /** Weigher of an LruCache counting each entry as 1, for a capacity in entries.
+   *
+   * \tparam K the type of key
+   * \tparam V the type of value
+   */
+  template<class K, class V>
+    struct EntryWeigher {
+    /** \return 1 for any entry */
+    size_t operator()(const K&, const V&) const {
+      return 1;
+    }
+  };
+
+  /** Weigher of an LruCache counting the bytes of each entry's key and value,
+   * for a capacity in bytes.
+   *
+   * This counts sizeof only; for keys or values owning memory, such as
+   * std::string, write a weigher adding the memory they own.
+   *
+   * \tparam K the type of key
+   * \tparam V the type of value
+   */
+  template<class K, class V>
+    struct ByteWeigher {
+    /** \return the bytes of an entry */
+    size_t operator()(const K&, const V&) const {
+      return sizeof(K) + sizeof(V);
+    }
+  };
+
+  namespace DoubleLinkedListImpl {
+
+    /** LruCache internal entry: a DataNode of the key and value, linked in
+     * recency order, which is also the entry of its hash bucket.
+     *
+     * \tparam K the type of key
+     * \tparam V the type of value
+     *
+     * \note This class is not accessible to the users of LruCache.
+     */
+    template<class K, class V>
+      class LruEntry : public DataNode<std::pair<const K, V> > {
+    public:
+      /** Create an entry of key and value
+       *
+       * \param key of the entry
+       * \param value of the entry
+       * \param theHash of key
+       * \param theWeight of the entry, from the Weigher
+       */
+      LruEntry(const K& key, const V& value, size_t theHash, size_t theWeight)
+	: DataNode<std::pair<const K, V> >(std::pair<const K, V>(key, value)),
+	  hashNext(NULL), hash(theHash), weight(theWeight)
+      {
+      }
+
+      /** The next entry in the same hash bucket, or NULL for none */
+      LruEntry* hashNext;
+
+      /** The hash of the key */
+      const size_t hash;
+
+      /** The weight of the entry, from the Weigher */
+      const size_t weight;
+    };
+
+  } // namespace DoubleLinkedListImpl
+
+  /** Least-Recently-Used cache of values by key, evicting the least recently
+   * used entries to stay within a capacity.
+   *
+   * Each entry is a single node linked both in recency order and in its hash
+   * bucket, so a hit only unlinks and relinks the node at the front: it
+   * neither allocates nor walks anything.  When an insert must evict, the
+   * evicted node is reused for the new entry rather than freed and
+   * allocated again.
+   *
+   * Capacity is in the units of Weigher: entries for EntryWeigher, bytes for
+   * ByteWeigher or a weigher of your own.
+   *
+   * \tparam K the type of key
+   * \tparam V the type of value
+   * \tparam Hash to hash keys
+   * \tparam Weigher to weigh entries against the capacity -- \see EntryWeigher
+   * \tparam KeyEqual to compare keys
+   */
+  template<class K, class V, class Hash = std::hash<K>, class Weigher = EntryWeigher<K, V>, class KeyEqual = std::equal_to<K> >
+    class LruCache {
+  private:
+    /** Convenience typedef of the marker Nodes of the recency order */
+    typedef DoubleLinkedListImpl::Node<std::pair<const K, V> > Node;
+
+    /** Convenience typedef of Nodes of the recency order with an entry */
+    typedef DoubleLinkedListImpl::DataNode<std::pair<const K, V> > DataNode;
+
+    /** Convenience typedef of the entries */
+    typedef DoubleLinkedListImpl::LruEntry<K, V> Entry;
+
+  public:
+    /** Convenience typedef of the type of keys */
+    typedef K key_type;
+
+    /** Convenience typedef of the type of values */
+    typedef V mapped_type;
+
+    /** Convenience typedef of an entry of key and value */
+    typedef std::pair<const K, V> value_type;
+
+    /** Convenience typedef of read-only iterators, from most to least recently used */
+    typedef Experiment::Cursor<const value_type, const Node, const DataNode> const_iterator;
+
+  public:
+    LruCache(size_t capacity, const Hash& theHasher = Hash(), const Weigher& theWeigher = Weigher(), const KeyEqual& theKeyEqual = KeyEqual());
+    ~LruCache();
+
+  private:
+    LruCache(const LruCache& rhs);
+    LruCache& operator=(const LruCache& rhs);
+
+  public:
+    V* get(const K& key);
+
+    const V* peek(const K& key) const;
+
+    bool put(const K& key, const V& value);
+
+    bool erase(const K& key);
+
+    void clear();
+
+    /** \return true if this cache has no entries, otherwise false */
+    bool isEmpty() const {
+      return 0 == entries;
+    }
+
+    /** \return the number of entries in this cache */
+    size_t size() const {
+      return entries;
+    }
+
+    /** \return the total weight of the entries in this cache */
+    size_t weight() const {
+      return totalWeight;
+    }
+
+    /** \return the maximum total weight of the entries in this cache */
+    size_t capacity() const {
+      return maximumWeight;
+    }
+
+    /** \return a read-only iterator to the most recently used entry */
+    const_iterator begin() const {
+      return const_iterator(head.getNext());
+    }
+
+    /** \return a read-only iterator beyond the least recently used entry */
+    const_iterator end() const {
+      return const_iterator(&tail);
+    }
+
+  private:
+    Entry* find(const K& key, size_t hash) const;
+
+    size_t bucketOf(size_t hash) const;
+
+    void unlink(Entry* entry);
+
+    void linkFront(Entry* entry);
+
+    void rehash(size_t bucketCount);
+
+    /** \return the entry at node, which must not be a marker \param node at an entry */
+    static Entry* entryOf(Node* node) {
+      return static_cast<Entry*>(node);
+    }
+
+  private:
+    /** Marker Node before the most recently used entry */
+    Node head;
+
+    /** Marker Node after the least recently used entry */
+    Node tail;
+
+    /** Hash buckets, each the first of a chain of entries through Entry::hashNext.
+     *
+     * The count is a power of 2, so a bucket is found by the top bits of the
+     * mixed hash.
+     */
+    std::vector<Entry*> buckets;
+
+    /** Number of bits in the index of buckets */
+    unsigned int bucketBits;
+
+    /** Number of entries */
+    size_t entries;
+
+    /** Total weight of the entries */
+    size_t totalWeight;
+
+    /** Maximum total weight of the entries */
+    const size_t maximumWeight;
+
+    /** Hashes keys */
+    Hash hasher;
+
+    /** Weighs entries */
+    Weigher weigher;
+
+    /** Compares keys */
+    KeyEqual keyEqual;
+  };
+
+} // namespace Experiment
+
+#include "LruCache.cpp"
+
+#endif // LRU_CACHE_H
@@ -0,0 +1,523 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef MAPPED_DOUBLE_LINKED_LIST_CPP
+#define MAPPED_DOUBLE_LINKED_LIST_CPP
+
+/** \file
+ *
+ * Implementations of longer template methods of the MappedDoubleLinkedList.h file.
+ *
+ * \note This file to be included at the end of MappedDoubleLinkedList.h
+ */
+
+namespace Experiment {
+
+  namespace DoubleLinkedListImpl {
+
+    /** The magic of MappedDoubleLinkedList files */
+    const char MAPPED_MAGIC[8] = "DLLMAP";
+
+    /** The version of the MappedDoubleLinkedList file format written */
+    const uint32_t MAPPED_VERSION = 1;
+
+    /** Nodes a new MappedDoubleLinkedList file has room for */
+    const uint32_t MAPPED_INITIAL_CAPACITY = 1024;
+
+  } // namespace DoubleLinkedListImpl
+
+  template<typename T>
+  const uint32_t MappedDoubleLinkedList<T>::NONE;
+
+  template<typename T>
+  const size_t MappedDoubleLinkedList<T>::NODES_OFFSET;
+
+  /** Open the list in the file at path, creating an empty list if there is no
+   * file or it is empty.
+   *
+   * Only the file is mapped; no value is read.
+   *
+   * \param path of the file holding the list
+   *
+   * \throw std::system_error if the file cannot be opened, sized or mapped
+   * \throw std::invalid_argument if the file is not a list of values of type T
+   */
+  template<typename T>
+  MappedDoubleLinkedList<T>::MappedDoubleLinkedList(const std::string& path)
+    : fd(open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)), mapping(MAP_FAILED), mappedLength(0)
+  {
+    using namespace DoubleLinkedListImpl;
+    
+    if(fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "opening " + path);
+    }
+
+    size_t length = 0;
+    try {
+      struct stat status;
+      if(0 != fstat(fd, &status)) {
+	throw std::system_error(errno, std::generic_category(), "examining " + path);
+      }
+
+      length = static_cast<size_t>(status.st_size);
+      const bool created = 0 == length;
+      if(created) {
+	length = fileSize(MAPPED_INITIAL_CAPACITY);
+	if(0 != ftruncate(fd, static_cast<off_t>(length))) {
+	  throw std::system_error(errno, std::generic_category(), "sizing " + path);
+	}
+      } else if(length < sizeof(Header)) {
+	throw std::invalid_argument(path + " is not a list file");
+      }
+
+      mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if(MAP_FAILED == mapping) {
+	throw std::system_error(errno, std::generic_category(), "mapping " + path);
+      }
+      mappedLength = length;
+
+      Header& h = header();
+      if(created) {
+	std::memcpy(h.magic, MAPPED_MAGIC, sizeof(h.magic));
+	h.version = MAPPED_VERSION;
+	h.valueSize = sizeof(T);
+	h.head = NONE;
+	h.tail = NONE;
+	h.freeHead = NONE;
+	h.count = 0;
+	h.used = 0;
+	h.capacity = MAPPED_INITIAL_CAPACITY;
+      } else if(0 != std::memcmp(h.magic, MAPPED_MAGIC, sizeof(h.magic))) {
+	throw std::invalid_argument(path + " is not a list file");
+      } else if(MAPPED_VERSION != h.version) {
+	throw std::invalid_argument(path + " has an unsupported list file version");
+      } else if(sizeof(T) != h.valueSize) {
+	throw std::invalid_argument(path + " holds values of a different size");
+      } else if(length < fileSize(h.capacity)) {
+	throw std::invalid_argument(path + " is truncated");
+      }
+    } catch(...) {
+      if(MAP_FAILED != mapping) {
+	munmap(mapping, length);
+      }
+      close(fd);
+      throw;
+    }
+  }
+
+  /** Unmap and close the file, leaving the list in it.
+   *
+   * \note This does not wait for changes to reach the disk -- \see sync()
+   */
+  template<typename T>
+  MappedDoubleLinkedList<T>::~MappedDoubleLinkedList() {
+    munmap(mapping, mappedLength);
+    close(fd);
+  }
+
+  /** Remove all data from this list, invalidating all iterators.
+   *
+   * The file keeps its size for the values added next.
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::clear() {
+    Header& h = header();
+    h.head = NONE;
+    h.tail = NONE;
+    h.freeHead = NONE;
+    h.count = 0;
+    h.used = 0;
+  }
+
+  /** \return true if this list has no data, otherwise false */
+  template<typename T>
+  bool MappedDoubleLinkedList<T>::isEmpty() const {
+    return NONE == header().head;
+  }
+
+  /** \return the number of values in this list */
+  template<typename T>
+  size_t MappedDoubleLinkedList<T>::size() const {
+    return header().count;
+  }
+
+  /** Grow the file so that adding up to count values in total does not grow it.
+   *
+   * \param count of values to make room for
+   *
+   * \throw std::length_error if count values cannot be indexed with 32 bits
+   * \throw std::system_error if the file cannot be grown
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::reserve(size_t count) {
+    if(NONE <= count) {
+      throw std::length_error("MappedDoubleLinkedList cannot hold so many values");
+    }
+    if(header().capacity < count) {
+      grow(count);
+    }
+  }
+
+  /** Wait for all changes to this list to be written to the file.
+   *
+   * \throw std::system_error if writing fails
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::sync() {
+    if(0 != msync(mapping, mappedLength, MS_SYNC)) {
+      throw std::system_error(errno, std::generic_category(), "syncing list file");
+    }
+  }
+
+  /** \return an iterator pointing to the first element of this list */
+  template<typename T>
+  typename MappedDoubleLinkedList<T>::iterator MappedDoubleLinkedList<T>::begin() {
+    return iterator(this, header().head);
+  }
+  
+  /** \return an iterator pointing beyond the last element of this list */
+  template<typename T>
+  typename MappedDoubleLinkedList<T>::iterator MappedDoubleLinkedList<T>::end() {
+    return iterator(this, NONE);
+  }
+
+  /** \return a read-only iterator pointing to the first element of this list */
+  template<typename T>
+  typename MappedDoubleLinkedList<T>::const_iterator MappedDoubleLinkedList<T>::begin() const {
+    return const_iterator(this, header().head);
+  }
+  
+  /** \return a read-only iterator pointing beyond the last element of this list */
+  template<typename T>
+  typename MappedDoubleLinkedList<T>::const_iterator MappedDoubleLinkedList<T>::end() const {
+    return const_iterator(this, NONE);
+  }
+
+  /** \return a read-only iterator pointing to the first element of this list */
+  template<typename T>
+  typename MappedDoubleLinkedList<T>::const_iterator MappedDoubleLinkedList<T>::cbegin() const {
+    return begin();
+  }
+  
+  /** \return a read-only iterator pointing beyond the last element of this list */
+  template<typename T>
+  typename MappedDoubleLinkedList<T>::const_iterator MappedDoubleLinkedList<T>::cend() const {
+    return end();
+  }
+
+  /** Insert value as the first item in this list
+   *
+   * \param value to insert at the start of the list
+   *
+   * \throw std::length_error if the list cannot be indexed with 32 bits
+   * \throw std::system_error if the file cannot be grown
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::push_front(const value_type& value) {
+    const uint32_t index = allocate(value);
+    linkBefore(index, header().head);
+  }
+
+  /** Insert value as the last item in this list
+   *
+   * \param value to insert at the end of the list
+   *
+   * \throw std::length_error if the list cannot be indexed with 32 bits
+   * \throw std::system_error if the file cannot be grown
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::push_back(const value_type& value) {
+    linkBefore(allocate(value), NONE);
+  }
+
+  /** Remove the value at at, keeping its node for reuse.
+   *
+   * \param at the iterator at the value to remove, which must not be end()
+   *
+   * \return an iterator at the value after the one removed
+   */
+  template<typename T>
+  typename MappedDoubleLinkedList<T>::iterator MappedDoubleLinkedList<T>::erase(const iterator& at) {
+    const uint32_t index = at.getIndex();
+    const uint32_t next = node(index).theNext;
+    unlink(index);
+
+    Header& h = header();
+    node(index).thePrevious = NONE;
+    node(index).theNext = h.freeHead;
+    h.freeHead = index;
+    --h.count;
+    return iterator(this, next);
+  }
+
+  /** Move the value at move before the value at before.
+   *
+   * Iterators stay with their values.
+   *
+   * \param move the iterator at the value to move, which must not be end()
+   * \param before the iterator at the value to move before, or end()
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::moveBefore(const iterator& move, const iterator& before) {
+    const uint32_t index = move.getIndex();
+    if(index == before.getIndex() || node(index).theNext == before.getIndex()) {
+      return;
+    }
+    
+    unlink(index);
+    linkBefore(index, before.getIndex());
+  }
+
+  /** Swap the positions of the values at a and b.
+   *
+   * Iterators stay with their values.
+   *
+   * \param a the iterator at the value to swap with b, which must not be end()
+   * \param b the iterator at the value to swap with a, which must not be end()
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::swapWith(const iterator& a, const iterator& b) {
+    const uint32_t aIndex = a.getIndex();
+    const uint32_t bIndex = b.getIndex();
+    if(aIndex == bIndex) {
+      return;
+    }
+
+    // Adjacent: ... a b ... or ... b a ...
+    const uint32_t afterA = node(aIndex).theNext;
+    if(afterA == bIndex) {
+      unlink(bIndex);
+      linkBefore(bIndex, aIndex);
+      return;
+    }
+    const uint32_t afterB = node(bIndex).theNext;
+    if(afterB == aIndex) {
+      unlink(aIndex);
+      linkBefore(aIndex, bIndex);
+      return;
+    }
+
+    // Disjoint: put each where the other was
+    unlink(aIndex);
+    linkBefore(aIndex, afterB);
+    unlink(bIndex);
+    linkBefore(bIndex, afterA);
+  }
+
+  /** Relink all values of this list into the order given by [first, last).
+   *
+   * Only the links in the file are rewritten, in a single pass; no value is
+   * copied.  Iterators stay with their values.
+   *
+   * \param first the first iterator of the new order
+   * \param last the position after the last iterator of the new order
+   *
+   * \tparam CursorIter an input iterator over iterators of this list, which must
+   * hold each element of this list exactly once
+   */
+  template<typename T>
+  template<class CursorIter>
+  void MappedDoubleLinkedList<T>::relink(CursorIter first, CursorIter last) {
+    Header& h = header();
+    uint32_t previous = NONE;
+    for( ; first != last; ++first) {
+      const uint32_t index = first->getIndex();
+      node(index).thePrevious = previous;
+      if(NONE == previous) {
+	h.head = index;
+      } else {
+	node(previous).theNext = index;
+      }
+      previous = index;
+    }
+    
+    if(NONE != previous) {
+      node(previous).theNext = NONE;
+    }
+    h.tail = previous;
+  }
+
+  /** \return the index after index, or NONE for none
+   *
+   * \param index of the element to find the next of, or NONE to remain at NONE
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T>
+  uint32_t MappedDoubleLinkedList<T>::nextOf(uint32_t index) const {
+    return NONE == index ? NONE : node(index).theNext;
+  }
+
+  /** \return the index before index, or NONE for none
+   *
+   * \param index of the element to find the previous of, or NONE for the last element
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T>
+  uint32_t MappedDoubleLinkedList<T>::previousOf(uint32_t index) const {
+    return NONE == index ? header().tail : node(index).thePrevious;
+  }
+
+  /** \return the index positions after index, or before it for negative
+   * positions, where NONE is the position after the last element, found by
+   * walking the links
+   *
+   * \param index of the element to start from, or NONE
+   * \param positions to advance
+   *
+   * \throw std::out_of_range if that is before the first element or after NONE
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T>
+  uint32_t MappedDoubleLinkedList<T>::advanceFrom(uint32_t index, std::ptrdiff_t positions) const {
+    return NoPositionIndex().advance(*this, index, positions);
+  }
+
+  /** \return a reference to the value at index, which must not be NONE
+   *
+   * \param index of the element
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T>
+  typename MappedDoubleLinkedList<T>::value_type& MappedDoubleLinkedList<T>::valueAt(uint32_t index) {
+    return node(index).theT;
+  }
+
+  /** \return a const reference to the value at index, which must not be NONE
+   *
+   * \param index of the element
+   *
+   * \todo Conceal this from public access
+   */
+  template<typename T>
+  const typename MappedDoubleLinkedList<T>::value_type& MappedDoubleLinkedList<T>::valueAt(uint32_t index) const {
+    return node(index).theT;
+  }
+
+  /** Store value in an unlinked Node, reusing a removed one if any.
+   *
+   * \param value to store
+   *
+   * \return the index of the Node
+   *
+   * \throw std::length_error if the list cannot be indexed with 32 bits
+   * \throw std::system_error if the file cannot be grown
+   */
+  template<typename T>
+  uint32_t MappedDoubleLinkedList<T>::allocate(const value_type& value) {
+    // value may be in this list, whose mapping grow() may move
+    const value_type copy = value;
+    uint32_t index = header().freeHead;
+    if(NONE != index) {
+      header().freeHead = node(index).theNext;
+    } else {
+      if(header().used == header().capacity) {
+	if(NONE - 1 <= header().capacity) {
+	  throw std::length_error("MappedDoubleLinkedList is full");
+	}
+	grow(std::min(static_cast<size_t>(header().capacity) * 2, static_cast<size_t>(NONE - 1)));
+      }
+      index = header().used++;
+    }
+
+    Node& created = node(index);
+    created.thePrevious = NONE;
+    created.theNext = NONE;
+    created.theT = copy;
+    ++header().count;
+    return index;
+  }
+
+  /** Grow the file and its mapping to room for capacity Nodes, unless the
+   * file is already that large.
+   *
+   * The mapping may move, which the index links do not mind.
+   *
+   * \param capacity in Nodes, more than the current capacity
+   *
+   * \throw std::system_error if the file cannot be grown
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::grow(size_t capacity) {
+    const size_t newLength = fileSize(capacity);
+    if(mappedLength < newLength) {
+      if(0 != ftruncate(fd, static_cast<off_t>(newLength))) {
+	throw std::system_error(errno, std::generic_category(), "growing list file");
+      }
+
+      void* moved = mremap(mapping, mappedLength, newLength, MREMAP_MAYMOVE);
+      if(MAP_FAILED == moved) {
+	const int error = errno;
+	if(0 != ftruncate(fd, static_cast<off_t>(mappedLength))) {
+	  // Keep the first error; the file is only larger than needed
+	}
+	throw std::system_error(error, std::generic_category(), "mapping grown list file");
+      }
+      mapping = moved;
+      mappedLength = newLength;
+    }
+    header().capacity = static_cast<uint32_t>(capacity);
+  }
+
+  /** Unlink the Node at index from its neighbours, linking them to each other.
+   *
+   * \param index of the linked Node to unlink
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::unlink(uint32_t index) {
+    Header& h = header();
+    Node& unlinked = node(index);
+    if(NONE == unlinked.thePrevious) {
+      h.head = unlinked.theNext;
+    } else {
+      node(unlinked.thePrevious).theNext = unlinked.theNext;
+    }
+    
+    if(NONE == unlinked.theNext) {
+      h.tail = unlinked.thePrevious;
+    } else {
+      node(unlinked.theNext).thePrevious = unlinked.thePrevious;
+    }
+  }
+
+  /** Link the unlinked Node at index before the Node at before.
+   *
+   * \param index of the unlinked Node to link
+   * \param before the index of the Node to link before, or NONE to link last
+   */
+  template<typename T>
+  void MappedDoubleLinkedList<T>::linkBefore(uint32_t index, uint32_t before) {
+    Header& h = header();
+    Node& linked = node(index);
+    linked.theNext = before;
+    linked.thePrevious = (NONE == before) ? h.tail : node(before).thePrevious;
+    
+    if(NONE == linked.thePrevious) {
+      h.head = index;
+    } else {
+      node(linked.thePrevious).theNext = index;
+    }
+    
+    if(NONE == before) {
+      h.tail = index;
+    } else {
+      node(before).thePrevious = index;
+    }
+  }
+
+} // namespace Experiment
+
+#endif // MAPPED_DOUBLE_LINKED_LIST_CPP
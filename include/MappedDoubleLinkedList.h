@@ -0,0 +1,219 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef MAPPED_DOUBLE_LINKED_LIST_H
+#define MAPPED_DOUBLE_LINKED_LIST_H
+
+/** \file
+ * Memory-mapped, persistent Double Linked List definition.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef INDEXED_DOUBLE_LINKED_LIST_H
+#include "IndexedDoubleLinkedList.h"
+#endif // INDEXED_DOUBLE_LINKED_LIST_H
+
+namespace Experiment {
+
+  /** Double linked list whose nodes live directly in a memory-mapped file.
+   *
+   * The file starts with a Header holding the head, tail and free list, and
+   * is followed by an array of nodes which link to each other by their 32-bit
+   * index in that array -- an offset in units of nodes -- rather than by
+   * pointer, so the links stay valid wherever the file is mapped.
+   *
+   * Opening a list maps the file without reading it: pages are faulted in as
+   * they are used.  Changes are written to the file by the operating system;
+   * call sync() to wait for them to reach the disk.  Sorting with
+   * ListMergeSort relinks the nodes in place, as for IndexedDoubleLinkedList.
+   *
+   * Values are stored as their bytes, so must be trivially copyable, and are
+   * read back by a machine with the same byte order.  Removed nodes are kept
+   * on a free list in the file for reuse; the file grows and never shrinks.
+   *
+   * \tparam T the type of Data this MappedDoubleLinkedList will hold
+   */
+  template<class T>
+    class MappedDoubleLinkedList {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedDoubleLinkedList stores the bytes of trivially copyable values");
+
+  public:
+    /** Convenience typedef of the type of values in this list */
+    typedef T value_type;
+    
+    /** Convenience typedef of iterators of this list */
+    typedef IndexedCursor<value_type, MappedDoubleLinkedList<value_type> > iterator;
+    
+    /** Convenience typedef of read-only iterators of this list */
+    typedef IndexedCursor<const value_type, const MappedDoubleLinkedList<value_type> > const_iterator;
+
+    /** The index meaning no element, such as end() */
+    static const uint32_t NONE = 0xFFFFFFFFu;
+
+  private:
+    /** The start of the file */
+    struct Header {
+      /** Identifies the file: "DLLMAP" and terminating NULs */
+      char magic[8];
+
+      /** Version of the file format */
+      uint32_t version;
+
+      /** sizeof each value */
+      uint32_t valueSize;
+
+      /** Index of the first Node in the list, or NONE for none */
+      uint32_t head;
+
+      /** Index of the last Node in the list, or NONE for none */
+      uint32_t tail;
+
+      /** Index of the first removed Node, linked through theNext, or NONE for none */
+      uint32_t freeHead;
+
+      /** Number of values in the list */
+      uint32_t count;
+
+      /** Number of Nodes ever used, linked or free */
+      uint32_t used;
+
+      /** Number of Nodes the file has room for */
+      uint32_t capacity;
+    };
+
+    /** A node in the file: the links to its neighbours and its value */
+    struct Node {
+      /** The index of the Node before this, or NONE for none */
+      uint32_t thePrevious;
+
+      /** The index of the Node after this, or NONE for none */
+      uint32_t theNext;
+
+      /** The value in this Node */
+      value_type theT;
+    };
+
+  public:
+    explicit MappedDoubleLinkedList(const std::string& path);
+
+    ~MappedDoubleLinkedList();
+
+  private:
+    MappedDoubleLinkedList(const MappedDoubleLinkedList& rhs);
+    MappedDoubleLinkedList& operator=(const MappedDoubleLinkedList& rhs);
+
+  public:
+    void clear();
+    
+    bool isEmpty() const;
+    
+    size_t size() const;
+    
+    void reserve(size_t count);
+    
+    void sync();
+    
+    iterator begin();
+    
+    iterator end();
+    
+    const_iterator begin() const;
+    
+    const_iterator end() const;
+    
+    const_iterator cbegin() const;
+    
+    const_iterator cend() const;
+    
+    void push_front(const value_type& value);
+    
+    void push_back(const value_type& value);
+    
+    iterator erase(const iterator& at);
+    
+    void moveBefore(const iterator& move, const iterator& before);
+    
+    void swapWith(const iterator& a, const iterator& b);
+    
+    template<class CursorIter>
+      void relink(CursorIter first, CursorIter last);
+    
+  public:
+    uint32_t nextOf(uint32_t index) const;
+    
+    uint32_t previousOf(uint32_t index) const;
+    
+    uint32_t advanceFrom(uint32_t index, std::ptrdiff_t positions) const;
+    
+    value_type& valueAt(uint32_t index);
+    
+    const value_type& valueAt(uint32_t index) const;
+    
+  private:
+    /** \return the Header at the start of the mapping */
+    Header& header() const {
+      return *static_cast<Header*>(mapping);
+    }
+
+    /** \return the Node at index \param index of the Node */
+    Node& node(uint32_t index) const {
+      return reinterpret_cast<Node*>(static_cast<char*>(mapping) + NODES_OFFSET)[index];
+    }
+
+    /** \return the bytes of a file with room for capacity Nodes \param capacity in Nodes */
+    static size_t fileSize(size_t capacity) {
+      return NODES_OFFSET + capacity * sizeof(Node);
+    }
+
+    uint32_t allocate(const value_type& value);
+    
+    void grow(size_t capacity);
+    
+    void unlink(uint32_t index);
+    
+    void linkBefore(uint32_t index, uint32_t before);
+    
+  private:
+    /** Offset of the first Node in the file, after the Header */
+    static const size_t NODES_OFFSET = (sizeof(Header) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+
+    /** The file descriptor of the file */
+    int fd;
+
+    /** The mapping of the whole file */
+    void* mapping;
+
+    /** The bytes mapped: the size of the file, which may be more than its
+     * capacity needs */
+    size_t mappedLength;
+  };
+  
+} // namespace Experiment
+
+#include "MappedDoubleLinkedList.cpp"
+
+#endif // MAPPED_DOUBLE_LINKED_LIST_H
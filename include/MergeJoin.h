@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef MERGE_JOIN_H
+#define MERGE_JOIN_H
+
+/** \file
+ * Sort-merge join of two sorted sequences of records
+ */
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+namespace Experiment {
+
+  /** The records mergeJoin() emits */
+  enum JoinKind {
+    /** Each pair of left and right records with equal keys */
+    INNER_JOIN,
+
+    /** As INNER_JOIN, and each left record without a right record of equal
+     * key, with no right record
+     */
+    LEFT_OUTER_JOIN,
+
+    /** Each left record with at least one right record of equal key, once,
+     * with the first such right record
+     */
+    SEMI_JOIN,
+
+    /** Each left record without a right record of equal key, with no right
+     * record
+     */
+    ANTI_JOIN
+  };
+
+  /** Join the records from leftFirst to leftLast with those from rightFirst
+   * to rightLast on equal keys, both sorted by key, emitting the results
+   * as they are found.
+   *
+   * Each pass over the right records moves forward only.  A run of right
+   * records of equal key is found once and joined with every left record
+   * of that key, so duplicate keys on either side cost no rescanning
+   * beyond emitting their pairs.  Keys are equal when neither is less.
+   *
+   * emit is called with each left record and the right record it is joined
+   * with, or NULL for none, in left record order:
+   * \code
+   * emit(const Left& left, const Right* right)
+   * \endcode
+   *
+   * \param leftFirst the first left record
+   * \param leftLast the position after the last left record
+   * \param rightFirst the first right record
+   * \param rightLast the position after the last right record
+   * \param keyLeft returning the key of a left record
+   * \param keyRight returning the key of a right record
+   * \param emit called with each result
+   * \param lessor comparing keys, by which both sequences are sorted
+   *
+   * \tparam kind the JoinKind of results emitted
+   * \tparam LeftIter forward iterator over left records
+   * \tparam RightIter forward iterator over right records
+   * \tparam LeftKey callable returning the key of a left record
+   * \tparam RightKey callable returning the key of a right record
+   * \tparam Emit callable given each result
+   * \tparam Lessor comparing keys of left and right records either way
+   */
+  template<JoinKind kind, class LeftIter, class RightIter, class LeftKey, class RightKey, class Emit, class Lessor = std::less<> >
+    void mergeJoin(LeftIter leftFirst, const LeftIter leftLast, const RightIter rightFirst, const RightIter rightLast,
+		   LeftKey keyLeft, RightKey keyRight, Emit emit, Lessor lessor = Lessor()) {
+    const typename std::iterator_traits<RightIter>::value_type* const none = NULL;
+
+    // The right records of the key of groupLeft: [groupFirst, groupLast)
+    LeftIter groupLeft = leftLast;
+    RightIter groupFirst = rightFirst;
+    RightIter groupLast = rightFirst;
+
+    for( ; leftLast != leftFirst; ++leftFirst) {
+      const auto& key = keyLeft(*leftFirst);
+      if(leftLast == groupLeft || lessor(keyLeft(*groupLeft), key)) {
+	groupLeft = leftFirst;
+	groupFirst = groupLast;
+	while(rightLast != groupFirst && lessor(keyRight(*groupFirst), key)) {
+	  ++groupFirst;
+	}
+	groupLast = groupFirst;
+	while(rightLast != groupLast && !lessor(key, keyRight(*groupLast))) {
+	  ++groupLast;
+	}
+      }
+
+      if(groupFirst == groupLast) {
+	if(LEFT_OUTER_JOIN == kind || ANTI_JOIN == kind) {
+	  emit(*leftFirst, none);
+	}
+      } else if(SEMI_JOIN == kind) {
+	emit(*leftFirst, &*groupFirst);
+      } else if(INNER_JOIN == kind || LEFT_OUTER_JOIN == kind) {
+	for(RightIter right = groupFirst; groupLast != right; ++right) {
+	  emit(*leftFirst, &*right);
+	}
+      }
+    }
+  }
+
+  /** Join the records of left with those of right on equal keys, both
+   * sorted by key, emitting the results as they are found -- \see
+   * mergeJoin(LeftIter, LeftIter, RightIter, RightIter, LeftKey, RightKey, Emit, Lessor)
+   *
+   * \param left the left records, sorted by key
+   * \param right the right records, sorted by key
+   * \param keyLeft returning the key of a left record
+   * \param keyRight returning the key of a right record
+   * \param emit called with each result
+   * \param lessor comparing keys, by which both lists are sorted
+   *
+   * \tparam kind the JoinKind of results emitted
+   * \tparam Left the type of left records
+   * \tparam Right the type of right records
+   * \tparam LeftKey callable returning the key of a left record
+   * \tparam RightKey callable returning the key of a right record
+   * \tparam Emit callable given each result
+   * \tparam Lessor comparing keys of left and right records either way
+   */
+  template<JoinKind kind, class Left, class Right, class LeftKey, class RightKey, class Emit, class Lessor = std::less<> >
+    void mergeJoin(const DoubleLinkedList<Left>& left, const DoubleLinkedList<Right>& right,
+		   LeftKey keyLeft, RightKey keyRight, Emit emit, Lessor lessor = Lessor()) {
+    mergeJoin<kind>(left.cbegin(), left.cend(), right.cbegin(), right.cend(), keyLeft, keyRight, emit, lessor);
+  }
+
+} // namespace Experiment
+
+#endif // MERGE_JOIN_H
@@ -0,0 +1,368 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+/** \file
+ * Hardware performance counters of this thread, and sort Metrics reading them
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+
+#if defined(__linux__)
+/** Defined to 1 when counters are read by Linux perf_event_open, else 0 and
+ * only time is measured
+ */
+#define PERF_COUNTERS_HAVE_PERF_EVENT 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define PERF_COUNTERS_HAVE_PERF_EVENT 0
+#endif
+
+namespace Experiment {
+
+  /** The hardware events PerfCounters counts */
+  enum PerfCounter {
+    /** CPU cycles */
+    CYCLES,
+    /** Instructions retired */
+    INSTRUCTIONS,
+    /** Reads missing the level 1 data cache */
+    L1D_MISSES,
+    /** References missing the last level cache */
+    LLC_MISSES,
+    /** Branches mispredicted */
+    BRANCH_MISSES,
+    /** The number of counters, not a counter */
+    PERF_COUNTERS
+  };
+
+  /** \return the name of counter, as reported \param counter to name */
+  inline const char* perfCounterName(PerfCounter counter) {
+    static const char* const names[PERF_COUNTERS] = {
+      "cycles", "instructions", "l1dMisses", "llcMisses", "branchMisses"
+    };
+    return names[counter];
+  }
+
+  /** The counts of PerfCounters over one measurement */
+  struct PerfCounts {
+    /** Wall-clock seconds measured, always available */
+    double seconds;
+
+    /** The count of each counter, scaled for the time it was scheduled, or 0
+     * if not available
+     */
+    uint64_t values[PERF_COUNTERS];
+
+    /** Whether each counter was counted */
+    bool available[PERF_COUNTERS];
+
+    /** \return the count of counter \param counter to return */
+    uint64_t operator[](PerfCounter counter) const {
+      return values[counter];
+    }
+
+    /** \return true if any counter was counted, else only seconds were */
+    bool anyAvailable() const {
+      for(int counter = 0; counter < PERF_COUNTERS; ++counter) {
+	if(available[counter]) {
+	  return true;
+	}
+      }
+      return false;
+    }
+  };
+
+  /** Write counts to out, as one line of name=value pairs, with "-" for
+   * counters not available
+   *
+   * \param out to write to
+   * \param counts to write
+   *
+   * \return out
+   */
+  inline std::ostream& operator<<(std::ostream& out, const PerfCounts& counts) {
+    out << "seconds=" << counts.seconds;
+    for(int counter = 0; counter < PERF_COUNTERS; ++counter) {
+      out << ' ' << perfCounterName(static_cast<PerfCounter>(counter)) << '=';
+      if(counts.available[counter]) {
+	out << counts.values[counter];
+      } else {
+	out << '-';
+      }
+    }
+    return out;
+  }
+
+  /** Hardware performance counters of the thread creating them, with time.
+   *
+   * Each counter is opened on its own, so those the hardware, kernel or
+   * perf_event_paranoid setting refuse are left out and the rest still count;
+   * should all be refused, only time is measured.  Only user-space events are
+   * counted.  When the kernel multiplexes counters, counts are scaled up by
+   * the share of time each was scheduled.
+   *
+   * Not copyable, as it owns the counters' file descriptors.
+   */
+  class PerfCounters {
+  public:
+    /** Start counting on creation and stop on destruction, into counts */
+    class Scope {
+    public:
+      /** Start counters, which are read into theCounts on destruction
+       *
+       * \param theCounters to start
+       * \param theCounts to read into
+       */
+      Scope(PerfCounters& theCounters, PerfCounts& theCounts)
+	: counters(theCounters), counts(theCounts)
+      {
+	counters.start();
+      }
+
+      /** Stop the counters, reading them into counts */
+      ~Scope() {
+	counts = counters.stop();
+      }
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+
+    private:
+      /** The counters counting */
+      PerfCounters& counters;
+
+      /** To read into */
+      PerfCounts& counts;
+    };
+
+    /** Open the counters of this thread, stopped */
+    PerfCounters()
+      : running(false), last()
+    {
+      for(int counter = 0; counter < PERF_COUNTERS; ++counter) {
+	descriptors[counter] = open(static_cast<PerfCounter>(counter));
+	last.available[counter] = 0 <= descriptors[counter];
+      }
+    }
+
+    /** Close the counters */
+    ~PerfCounters() {
+#if PERF_COUNTERS_HAVE_PERF_EVENT
+      for(int counter = 0; counter < PERF_COUNTERS; ++counter) {
+	if(0 <= descriptors[counter]) {
+	  close(descriptors[counter]);
+	}
+      }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /** \return true if counter is counted \param counter to check */
+    bool available(PerfCounter counter) const {
+      return last.available[counter];
+    }
+
+    /** \return true if any counter is counted, else only time is */
+    bool anyAvailable() const {
+      return last.anyAvailable();
+    }
+
+    /** Zero and start all counters and time */
+    void start() {
+#if PERF_COUNTERS_HAVE_PERF_EVENT
+      for(int counter = 0; counter < PERF_COUNTERS; ++counter) {
+	if(0 <= descriptors[counter]) {
+	  ioctl(descriptors[counter], PERF_EVENT_IOC_RESET, 0);
+	  ioctl(descriptors[counter], PERF_EVENT_IOC_ENABLE, 0);
+	}
+      }
+#endif
+      running = true;
+      started = std::chrono::steady_clock::now();
+    }
+
+    /** Stop all counters and time, if started, and read them.
+     *
+     * \return the counts since start(), or again the last counts if stopped
+     */
+    PerfCounts stop() {
+      if(!running) {
+	return last;
+      }
+      last.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+      running = false;
+#if PERF_COUNTERS_HAVE_PERF_EVENT
+      for(int counter = 0; counter < PERF_COUNTERS; ++counter) {
+	if(0 <= descriptors[counter]) {
+	  ioctl(descriptors[counter], PERF_EVENT_IOC_DISABLE, 0);
+	}
+      }
+      for(int counter = 0; counter < PERF_COUNTERS; ++counter) {
+	last.values[counter] = read(descriptors[counter]);
+      }
+#endif
+      return last;
+    }
+
+  private:
+    /** \return the descriptor of counter opened for this thread, or -1 if
+     * refused \param counter to open
+     */
+    static int open(PerfCounter counter) {
+#if PERF_COUNTERS_HAVE_PERF_EVENT
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      switch(counter) {
+      case CYCLES:
+	attr.config = PERF_COUNT_HW_CPU_CYCLES;
+	break;
+      case INSTRUCTIONS:
+	attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+	break;
+      case L1D_MISSES:
+	attr.type = PERF_TYPE_HW_CACHE;
+	attr.config = PERF_COUNT_HW_CACHE_L1D
+	  | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+	  | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	break;
+      case LLC_MISSES:
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	break;
+      default:
+	attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+	break;
+      }
+      return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+      return -1;
+#endif
+    }
+
+    /** \return the count of the counter of descriptor, scaled for the time
+     * it was scheduled, or 0 if not available \param descriptor to read
+     */
+    static uint64_t read(int descriptor) {
+#if PERF_COUNTERS_HAVE_PERF_EVENT
+      // value, time enabled, time running
+      uint64_t format[3] = { 0, 0, 0 };
+      if(descriptor < 0 || static_cast<ssize_t>(sizeof(format)) != ::read(descriptor, format, sizeof(format))) {
+	return 0;
+      }
+      if(0 == format[2] || format[1] == format[2]) {
+	return format[0];
+      }
+      return static_cast<uint64_t>(static_cast<double>(format[0]) * format[1] / format[2]);
+#else
+      return 0;
+#endif
+    }
+
+    /** The descriptor of each counter, or -1 where not available */
+    int descriptors[PERF_COUNTERS];
+
+    /** True between start() and stop() */
+    bool running;
+
+    /** When start() last was */
+    std::chrono::steady_clock::time_point started;
+
+    /** The counts last read, and which are available */
+    PerfCounts last;
+  };
+
+  /** Metrics for the sorts counting compares and swaps, and reading hardware
+   * performance counters from reset() to done() -- \see NoSortMetrics.
+   *
+   * The counters are opened by the first reset() and shared by copies, as
+   * Sort copies the metrics of the engine it chose.  Should no counter be
+   * available, counts holds only the time.
+   *
+   * \note Sorts with kernels for NoSortMetrics, as ListMergeSort, do not use
+   * them with these Metrics: the code measured is that counting compares.
+   *
+   * \tparam T type of data being sorted
+   */
+  template<class T>
+    class PerfCounterSortMetrics {
+  public:
+    /** Create with nothing counted and no counters opened */
+    PerfCounterSortMetrics()
+      : compares(0), swaps(0), counts()
+    {
+    }
+
+    /** a and b are compared */
+    void compare(const T& a, const T& b) {
+      ++compares;
+    }
+
+    /** Two items were swapped */
+    void swap() {
+      ++swaps;
+    }
+
+    /** The sort completed: stop the counters and read them into counts */
+    void done() {
+      if(counters) {
+	counts = counters->stop();
+      }
+    }
+
+    /** Metrics should be reset due to starting a new sort: zero the counts
+     * and start the counters, opening them if not yet open
+     */
+    void reset() {
+      if(!counters) {
+	counters = std::make_shared<PerfCounters>();
+      }
+      compares = 0;
+      swaps = 0;
+      counters->start();
+    }
+
+    /** Compares since reset() */
+    size_t compares;
+
+    /** Swaps since reset() */
+    size_t swaps;
+
+    /** The counters from reset() to done() */
+    PerfCounts counts;
+
+  private:
+    /** The counters, shared by copies */
+    std::shared_ptr<PerfCounters> counters;
+  };
+
+} // namespace Experiment
+
+#endif // PERF_COUNTERS_H
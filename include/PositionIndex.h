@@ -0,0 +1,467 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef POSITION_INDEX_H
+#define POSITION_INDEX_H
+
+/** \file
+ * Policies finding elements of an IndexedDoubleLinkedList by position
+ */
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <stdint.h>
+
+namespace Experiment {
+
+  /** Position policy of IndexedDoubleLinkedList keeping no index, and the
+   * example of the calls a policy receives.
+   *
+   * Changes to the list cost nothing, and finding a position walks the
+   * list: at() and positionOf() from its start, and advance() from where it
+   * is.  Elements are identified by their index in the list's storage, and
+   * the list's NONE is no element.
+   */
+  class NoPositionIndex {
+  public:
+    /** Room for count elements was reserved */
+    void reserved(size_t count) { }
+
+    /** The element at index was linked before the element at before, or last for NONE */
+    void linked(uint32_t index, uint32_t before) { }
+
+    /** The element at index was unlinked */
+    void unlinked(uint32_t index) { }
+
+    /** All elements were removed */
+    void cleared() { }
+
+    /** All elements were relinked or moved, as list now orders them */
+    template<class List>
+      void rebuilt(const List& list) { }
+
+    /** \return the index of the element at position of list, or NONE for
+     * position of list.size()
+     *
+     * \param list to find the element in
+     * \param position of the element, which must not be more than list.size()
+     *
+     * \tparam List the type of list
+     */
+    template<class List>
+      uint32_t at(const List& list, size_t position) const {
+      uint32_t index = list.cbegin().getIndex();
+      for( ; 0 < position; --position) {
+	index = list.nextOf(index);
+      }
+      return index;
+    }
+
+    /** \return the position in list of the element at index, or list.size()
+     * for NONE
+     *
+     * \param list to find the element in
+     * \param index of the element
+     *
+     * \tparam List the type of list
+     */
+    template<class List>
+      size_t positionOf(const List& list, uint32_t index) const {
+      if(List::NONE == index) {
+	return list.size();
+      }
+
+      size_t position = 0;
+      for(uint32_t at = list.cbegin().getIndex(); index != at; at = list.nextOf(at)) {
+	++position;
+      }
+      return position;
+    }
+
+    /** \return the index of the element positions after the element at
+     * index of list, or before it for negative positions, where NONE is the
+     * position after the last element
+     *
+     * \param list to find the element in
+     * \param index of the element to start from, or NONE
+     * \param positions to advance
+     *
+     * \throw std::out_of_range if that is before the first element or after NONE
+     *
+     * \tparam List the type of list
+     */
+    template<class List>
+      uint32_t advance(const List& list, uint32_t index, std::ptrdiff_t positions) const {
+      const uint32_t head = list.cbegin().getIndex();
+      for( ; 0 < positions; --positions) {
+	if(List::NONE == index) {
+	  throw std::out_of_range("advanced past the end of the list");
+	}
+	index = list.nextOf(index);
+      }
+      for( ; positions < 0; ++positions) {
+	if(head == index) {
+	  throw std::out_of_range("advanced before the start of the list");
+	}
+	index = list.previousOf(index);
+      }
+      return index;
+    }
+  };
+
+  /** Position policy of IndexedDoubleLinkedList keeping an order statistics
+   * tree of its elements, so that finding a position takes O(log n) rather
+   * than a walk, for O(log n) rather than O(1) to link or unlink each
+   * element.
+   *
+   * The tree is a treap ordered by list position, in arrays beside the
+   * list's own, with 20 bytes for each element.  Each entry counts the
+   * elements below it, so the position of an element is found by climbing
+   * to the root, and the element at a position by descending from it.
+   * Relinking the whole list, as by sorting, rebuilds the tree in O(n).
+   */
+  class PositionIndex {
+  public:
+    /** The index meaning no element, as the list's */
+    static const uint32_t NONE = 0xFFFFFFFFu;
+
+    /** Create an empty index */
+    PositionIndex()
+      : root(NONE), seed(SEED)
+    {
+    }
+
+    /** Room for count elements was reserved */
+    void reserved(size_t count) {
+      tree.reserve(count);
+    }
+
+    /** The element at index was linked before the element at before, or last for NONE */
+    void linked(uint32_t index, uint32_t before) {
+      if(tree.size() <= index) {
+	tree.resize(index + 1);
+      }
+
+      const size_t position = positionOf(before);
+      tree[index] = Entry(random());
+      uint32_t left = NONE;
+      uint32_t right = NONE;
+      split(root, position, left, right);
+      root = merge(merge(left, index), right);
+      tree[root].parent = NONE;
+    }
+
+    /** The element at index was unlinked */
+    void unlinked(uint32_t index) {
+      const Entry& entry = tree[index];
+      const uint32_t parent = entry.parent;
+      const uint32_t joined = merge(entry.left, entry.right);
+      if(NONE != joined) {
+	tree[joined].parent = parent;
+      }
+
+      if(NONE == parent) {
+	root = joined;
+	return;
+      }
+      if(index == tree[parent].left) {
+	tree[parent].left = joined;
+      } else {
+	tree[parent].right = joined;
+      }
+      for(uint32_t above = parent; NONE != above; above = tree[above].parent) {
+	--tree[above].size;
+      }
+    }
+
+    /** All elements were removed */
+    void cleared() {
+      tree.clear();
+      root = NONE;
+    }
+
+    /** All elements were relinked or moved, as list now orders them.
+     *
+     * This builds the treap of the list order in one pass, with a stack of
+     * its right spine, then counts each entry's elements bottom up.
+     *
+     * \param list whose elements to index
+     *
+     * \tparam List the type of list
+     */
+    template<class List>
+      void rebuilt(const List& list) {
+      tree.clear();
+      std::vector<uint32_t> spine;
+      for(uint32_t index = list.cbegin().getIndex(); NONE != index; index = list.nextOf(index)) {
+	if(tree.size() <= index) {
+	  tree.resize(index + 1);
+	}
+	tree[index] = Entry(random());
+
+	// Entries of lower priority on the spine become the left of this one
+	uint32_t below = NONE;
+	while(!spine.empty() && tree[spine.back()].priority < tree[index].priority) {
+	  below = spine.back();
+	  spine.pop_back();
+	}
+	tree[index].left = below;
+	if(NONE != below) {
+	  tree[below].parent = index;
+	}
+	if(!spine.empty()) {
+	  tree[spine.back()].right = index;
+	  tree[index].parent = spine.back();
+	}
+	spine.push_back(index);
+      }
+      root = spine.empty() ? NONE : spine.front();
+
+      // Parents come before their children in preorder, so count in reverse of it
+      std::vector<uint32_t> preorder;
+      std::vector<uint32_t> pending;
+      if(NONE != root) {
+	pending.push_back(root);
+      }
+      while(!pending.empty()) {
+	const uint32_t index = pending.back();
+	pending.pop_back();
+	preorder.push_back(index);
+	if(NONE != tree[index].left) {
+	  pending.push_back(tree[index].left);
+	}
+	if(NONE != tree[index].right) {
+	  pending.push_back(tree[index].right);
+	}
+      }
+      for(std::vector<uint32_t>::const_reverse_iterator iter = preorder.rbegin(); preorder.rend() != iter; ++iter) {
+	update(*iter);
+      }
+    }
+
+    /** \return the index of the element at position, or NONE for position of
+     * list.size()
+     *
+     * \param list to find the element in
+     * \param position of the element, which must not be more than list.size()
+     *
+     * \tparam List the type of list
+     */
+    template<class List>
+      uint32_t at(const List& list, size_t position) const {
+      return at(position);
+    }
+
+    /** \return the position in list of the element at index, or list.size()
+     * for NONE
+     *
+     * \param list to find the element in
+     * \param index of the element
+     *
+     * \tparam List the type of list
+     */
+    template<class List>
+      size_t positionOf(const List& list, uint32_t index) const {
+      return positionOf(index);
+    }
+
+    /** \return the index of the element positions after the element at
+     * index of list, or before it for negative positions, where NONE is the
+     * position after the last element
+     *
+     * \param list to find the element in
+     * \param index of the element to start from, or NONE
+     * \param positions to advance
+     *
+     * \throw std::out_of_range if that is before the first element or after NONE
+     *
+     * \tparam List the type of list
+     */
+    template<class List>
+      uint32_t advance(const List& list, uint32_t index, std::ptrdiff_t positions) const {
+      const std::ptrdiff_t position = static_cast<std::ptrdiff_t>(positionOf(index)) + positions;
+      if(position < 0) {
+	throw std::out_of_range("advanced before the start of the list");
+      }
+      if(static_cast<std::ptrdiff_t>(sizeOf(root)) < position) {
+	throw std::out_of_range("advanced past the end of the list");
+      }
+      return at(static_cast<size_t>(position));
+    }
+
+  private:
+    /** The entry of an element in the tree */
+    struct Entry {
+      /** Create an entry alone in its tree \param thePriority of the entry */
+      explicit Entry(uint32_t thePriority = 0)
+	: left(NONE), right(NONE), parent(NONE), size(1), priority(thePriority)
+      {
+      }
+
+      /** The entry of the elements before this one, or NONE for none */
+      uint32_t left;
+
+      /** The entry of the elements after this one, or NONE for none */
+      uint32_t right;
+
+      /** The entry this is the left or right of, or NONE for the root */
+      uint32_t parent;
+
+      /** The number of entries in the tree from this one */
+      uint32_t size;
+
+      /** Random priority, no greater than the parent's, to keep the tree shallow */
+      uint32_t priority;
+    };
+
+    /** \return the number of entries in the tree from index, or 0 for NONE \param index of the entry */
+    uint32_t sizeOf(uint32_t index) const {
+      return NONE == index ? 0 : tree[index].size;
+    }
+
+    /** Recount the entries in the tree from index \param index of the entry */
+    void update(uint32_t index) {
+      tree[index].size = 1 + sizeOf(tree[index].left) + sizeOf(tree[index].right);
+    }
+
+    /** \return the position of the element at index, or the number of
+     * elements for NONE
+     *
+     * \param index of the element
+     */
+    size_t positionOf(uint32_t index) const {
+      if(NONE == index) {
+	return sizeOf(root);
+      }
+
+      size_t position = sizeOf(tree[index].left);
+      for(uint32_t below = index, above = tree[index].parent; NONE != above; below = above, above = tree[above].parent) {
+	if(below == tree[above].right) {
+	  position += sizeOf(tree[above].left) + 1;
+	}
+      }
+      return position;
+    }
+
+    /** \return the index of the element at position, or NONE for the number
+     * of elements
+     *
+     * \param position of the element
+     */
+    uint32_t at(size_t position) const {
+      uint32_t index = root;
+      while(NONE != index) {
+	const size_t before = sizeOf(tree[index].left);
+	if(position < before) {
+	  index = tree[index].left;
+	} else if(position == before) {
+	  return index;
+	} else {
+	  position -= before + 1;
+	  index = tree[index].right;
+	}
+      }
+      return NONE;
+    }
+
+    /** Split the tree from index into left, its first position entries, and
+     * right, the rest.
+     *
+     * \param index of the entry to split from, or NONE
+     * \param position the number of entries to put in left
+     * \param left set to the tree of the first position entries
+     * \param right set to the tree of the rest
+     */
+    void split(uint32_t index, size_t position, uint32_t& left, uint32_t& right) {
+      if(NONE == index) {
+	left = NONE;
+	right = NONE;
+	return;
+      }
+
+      Entry& entry = tree[index];
+      const size_t before = sizeOf(entry.left);
+      if(position <= before) {
+	split(entry.left, position, left, tree[index].left);
+	setParent(tree[index].left, index);
+	right = index;
+      } else {
+	split(entry.right, position - before - 1, tree[index].right, right);
+	setParent(tree[index].right, index);
+	left = index;
+      }
+      update(index);
+    }
+
+    /** \return the tree of the entries of left then those of right
+     *
+     * \param left the tree of the entries to put first, or NONE
+     * \param right the tree of the entries to put after, or NONE
+     */
+    uint32_t merge(uint32_t left, uint32_t right) {
+      if(NONE == left) {
+	return right;
+      }
+      if(NONE == right) {
+	return left;
+      }
+
+      if(tree[right].priority < tree[left].priority) {
+	tree[left].right = merge(tree[left].right, right);
+	setParent(tree[left].right, left);
+	update(left);
+	return left;
+      }
+      tree[right].left = merge(left, tree[right].left);
+      setParent(tree[right].left, right);
+      update(right);
+      return right;
+    }
+
+    /** Make parent the parent of the entry at index, if any
+     *
+     * \param index of the entry, or NONE
+     * \param parent of the entry
+     */
+    void setParent(uint32_t index, uint32_t parent) {
+      if(NONE != index) {
+	tree[index].parent = parent;
+      }
+    }
+
+    /** \return the next priority, from a xorshift generator */
+    uint32_t random() {
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      return seed;
+    }
+
+    /** The seed of priorities, fixed so that runs repeat */
+    static const uint32_t SEED = 2463534242u;
+
+    /** The entry of each element, by its index in the list */
+    std::vector<Entry> tree;
+
+    /** The entry at the root of the tree, or NONE for none */
+    uint32_t root;
+
+    /** The state of the priority generator */
+    uint32_t seed;
+  };
+
+} // namespace Experiment
+
+#endif // POSITION_INDEX_H
@@ -18,6 +18,10 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  * A collection of helpful predicates for comparison, etc.
  */
 
+#ifndef PREFETCH_H
+#include "Prefetch.h"
+#endif // PREFETCH_H
+
 namespace Experiment {
 
   /** Comparison of two pointers values using operator<.
@@ -39,6 +43,31 @@ namespace Experiment {
     bool operator()(const T* const a, const T* const b) {
       return *a < *b; // existing operator<() calls
     }
+
+    /** Prefetch the value compared through pointer value, as the payload hook
+     * of Prefetch::Lookahead.
+     *
+     * \param value the pointer to the value to prefetch
+     */
+    void prefetch(const T* const value) const {
+      Prefetch::prefetch(value);
+    }
+  };
+
+  /** Key extractor using the whole value as its own key.
+   *
+   * \tparam T the type of value
+   */
+  template<class T>
+    class IdentityKey {
+  public:
+    /** \return value as its own key
+     *
+     * \param value to return the key of
+     */
+    const T& operator()(const T& value) const {
+      return value;
+    }
   };
   
 } // namespace Experiment
@@ -0,0 +1,176 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+/** \file
+ * Software prefetching ahead of list traversal.
+ *
+ * Each step along a list is a load from wherever the next Node was allocated,
+ * which for a list far larger than the cache is a miss that the step after it
+ * depends on.  A Lookahead walks a second cursor some Nodes ahead of the work,
+ * prefetching each Node it reaches, so that the work finds its Nodes already
+ * in cache.
+ *
+ * Values that are pointers, such as those compared by PointerLess, cost a
+ * second miss on what they point to.  Anything with a method
+ * \code void prefetch(const T& value) const \endcode -- typically the Lessor --
+ * is used as a payload hook: the Lookahead calls it with each value it passes.
+ */
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Experiment {
+
+  namespace Prefetch {
+
+    /** Default number of Nodes to prefetch ahead of the work */
+    const size_t DEFAULT_DISTANCE = 8;
+
+    /** Prefetch the cache line at address for reading and writing soon.
+     *
+     * \param address to prefetch
+     */
+    inline void prefetch(const void* address) {
+      __builtin_prefetch(address, 1, 3);
+    }
+
+    /** Payload hook with no prefetch method, for values not worth prefetching
+     * through.
+     */
+    class NoPayload {
+    };
+
+    /** Prefetching of what a value refers to, by a Hook without a prefetch method:
+     * nothing.
+     *
+     * \tparam Hook the type of payload hook
+     * \tparam T the type of value
+     */
+    template<class Hook, class T, class = void>
+      class Payload {
+    public:
+      /** Do nothing */
+      static void prefetch(const Hook&, const T&) { }
+    };
+
+    /** Prefetching of what a value refers to, by a Hook with a prefetch method.
+     *
+     * \tparam Hook the type of payload hook
+     * \tparam T the type of value
+     */
+    template<class Hook, class T>
+      class Payload<Hook, T, decltype(std::declval<const Hook&>().prefetch(std::declval<const T&>()), void())> {
+    public:
+      /** Prefetch what value refers to with hook.
+       *
+       * \param hook with prefetch(value)
+       * \param value to prefetch the payload of
+       */
+      static void prefetch(const Hook& hook, const T& value) {
+	hook.prefetch(value);
+      }
+    };
+
+    /** A cursor walking a fixed distance ahead of another on the same list,
+     * prefetching each Node it reaches.
+     *
+     * The Nodes from the one behind up to the Lookahead must stay in the list;
+     * the one behind may be moved elsewhere once passed.
+     *
+     * \tparam Cursor the type of cursor, which must have getNode()
+     */
+    template<class Cursor>
+      class Lookahead {
+    public:
+      /** Create a Lookahead distance Nodes after from.
+       *
+       * The Nodes walked to get there are loaded now, not prefetched.
+       *
+       * \param from the position of the work
+       * \param theEnd the end of the list, where the Lookahead stops
+       * \param distance Nodes to stay ahead by, 0 for no prefetching
+       * \param hook to prefetch the payload of each value passed -- \see Payload
+       *
+       * \tparam Hook the type of payload hook
+       */
+      template<class Hook>
+	Lookahead(Cursor from, Cursor theEnd, size_t distance, const Hook& hook)
+	: ahead(0 == distance ? theEnd : from), end(theEnd)
+      {
+	for(size_t i = 0; i < distance; ++i) {
+	  advance(hook);
+	}
+      }
+
+      /** Advance one Node, as the work does, prefetching the Node reached and
+       * the payload of the value passed.
+       *
+       * \param hook to prefetch the payload of the value passed -- \see Payload
+       *
+       * \tparam Hook the type of payload hook
+       */
+      template<class Hook>
+	void advance(const Hook& hook) {
+	if(end == ahead) {
+	  return;
+	}
+	
+	Payload<Hook, typename std::remove_const<typename std::remove_reference<decltype(*ahead)>::type>::type>::prefetch(hook, *ahead);
+	++ahead;
+	if(end != ahead) {
+	  prefetch(ahead.getNode());
+	}
+      }
+
+    private:
+      /** The position ahead of the work */
+      Cursor ahead;
+
+      /** The end of the list */
+      Cursor end;
+    };
+
+    /** Call function with each value from begin to end, prefetching distance
+     * Nodes ahead.
+     *
+     * \param begin the first position to visit
+     * \param end the position after the last to visit
+     * \param function to call with each value
+     * \param distance Nodes to prefetch ahead, 0 for none
+     * \param hook to prefetch the payload of each value -- \see Payload
+     *
+     * \return function, after all calls
+     *
+     * \tparam Cursor the type of cursor, which must have getNode()
+     * \tparam Function the type of function
+     * \tparam Hook the type of payload hook
+     */
+    template<class Cursor, class Function, class Hook = NoPayload>
+      Function forEach(Cursor begin, Cursor end, Function function, size_t distance = DEFAULT_DISTANCE, const Hook& hook = Hook()) {
+      Lookahead<Cursor> lookahead(begin, end, distance, hook);
+      for( ; end != begin; ++begin) {
+	function(*begin);
+	lookahead.advance(hook);
+      }
+      return function;
+    }
+
+  } // namespace Prefetch
+
+} // namespace Experiment
+
+#endif // PREFETCH_H
@@ -0,0 +1,190 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+/** \file
+ * Least-significant-digit radix sort of arithmetic keys with payloads.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <stdint.h>
+
+namespace Experiment {
+
+  /** Traits mapping an arithmetic Key to an unsigned integer of the same width
+   * whose order matches the order of the Key.
+   *
+   * supported is false for types which cannot be radix sorted.
+   *
+   * \tparam Key the type of key to map
+   */
+  template<class Key, class Enable = void>
+    struct RadixKey {
+      /** Key cannot be radix sorted */
+      static const bool supported = false;
+    };
+
+  /** RadixKey for unsigned integers, which are already in order */
+  template<class Key>
+    struct RadixKey<Key, typename std::enable_if<std::is_integral<Key>::value && std::is_unsigned<Key>::value>::type> {
+      /** Key can be radix sorted */
+      static const bool supported = true;
+
+      /** The unsigned integer Keys map to */
+      typedef Key unsigned_type;
+
+      /** \return key as an unsigned_type in the same order
+       *
+       * \param key to map
+       */
+      static unsigned_type toUnsigned(Key key) {
+	return key;
+      }
+    };
+
+  /** RadixKey for signed integers, which are ordered by flipping the sign bit */
+  template<class Key>
+    struct RadixKey<Key, typename std::enable_if<std::is_integral<Key>::value && std::is_signed<Key>::value>::type> {
+      /** Key can be radix sorted */
+      static const bool supported = true;
+
+      /** The unsigned integer Keys map to */
+      typedef typename std::make_unsigned<Key>::type unsigned_type;
+
+      /** \return key as an unsigned_type in the same order
+       *
+       * \param key to map
+       */
+      static unsigned_type toUnsigned(Key key) {
+	return static_cast<unsigned_type>(key) ^ (unsigned_type(1) << (std::numeric_limits<unsigned_type>::digits - 1));
+      }
+    };
+
+  /** RadixKey for IEEE-754 float and double.
+   *
+   * Positive values are ordered by setting the sign bit, negative values by
+   * flipping all bits.  -0.0 takes the key of 0.0, as std::less holds them
+   * equal, so a stable sort keeps them in their order.
+   */
+  template<class Key>
+    struct RadixKey<Key, typename std::enable_if<std::is_floating_point<Key>::value && std::numeric_limits<Key>::is_iec559
+					       && (sizeof(Key) == sizeof(uint32_t) || sizeof(Key) == sizeof(uint64_t))>::type> {
+      /** Key can be radix sorted */
+      static const bool supported = true;
+
+      /** The unsigned integer Keys map to */
+      typedef typename std::conditional<sizeof(Key) == sizeof(uint32_t), uint32_t, uint64_t>::type unsigned_type;
+
+      /** \return key as an unsigned_type in the same order
+       *
+       * \param key to map
+       */
+      static unsigned_type toUnsigned(Key key) {
+	const unsigned_type signBit = unsigned_type(1) << (std::numeric_limits<unsigned_type>::digits - 1);
+	unsigned_type bits;
+	std::memcpy(&bits, &key, sizeof(bits));
+	if(signBit == bits) {
+	  // -0.0
+	  return signBit;
+	}
+	return (bits & signBit) ? ~bits : (bits | signBit);
+      }
+    };
+
+  /** A key and what it is the key of, as sorted by radixSort().
+   *
+   * \tparam Unsigned the unsigned integer type of the key
+   * \tparam Payload the type of what the key is the key of
+   */
+  template<class Unsigned, class Payload>
+    struct RadixEntry {
+      /** The key to sort by */
+      Unsigned key;
+
+      /** What the key is the key of */
+      Payload payload;
+    };
+
+  /** Stable sort of entries by key, one byte per pass.
+   *
+   * All byte histograms are counted in one pass over the keys, and passes in
+   * which every key has the same byte are skipped.  Each pass is a branch-free
+   * scatter to a second array of the same size.
+   *
+   * \param entries to sort
+   *
+   * \tparam Unsigned the unsigned integer type of the key
+   * \tparam Payload the type of what the key is the key of
+   */
+  template<class Unsigned, class Payload>
+    void radixSort(std::vector<RadixEntry<Unsigned, Payload> >& entries) {
+    typedef RadixEntry<Unsigned, Payload> Entry;
+    static const size_t BYTES = sizeof(Unsigned);
+    static const size_t BUCKETS = 256;
+
+    const size_t count = entries.size();
+    if(count < 2) {
+      return;
+    }
+
+    // Histogram of every byte in one pass
+    std::vector<size_t> histograms(BYTES * BUCKETS, 0);
+    for(size_t i = 0; i < count; ++i) {
+      const Unsigned key = entries[i].key;
+      for(size_t byte = 0; byte < BYTES; ++byte) {
+	++histograms[byte * BUCKETS + ((key >> (8 * byte)) & 0xFF)];
+      }
+    }
+
+    std::vector<Entry> buffer(count);
+    Entry* from = &entries[0];
+    Entry* to = &buffer[0];
+    for(size_t byte = 0; byte < BYTES; ++byte) {
+      size_t* histogram = &histograms[byte * BUCKETS];
+      
+      // Skip bytes which do not distinguish any keys
+      if(count == histogram[(from[0].key >> (8 * byte)) & 0xFF]) {
+	continue;
+      }
+
+      // Histogram to starting offsets
+      size_t offset = 0;
+      for(size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+	const size_t inBucket = histogram[bucket];
+	histogram[bucket] = offset;
+	offset += inBucket;
+      }
+
+      for(size_t i = 0; i < count; ++i) {
+	to[histogram[(from[i].key >> (8 * byte)) & 0xFF]++] = from[i];
+      }
+      std::swap(from, to);
+    }
+
+    // Odd number of passes leave the results in buffer
+    if(from != &entries[0]) {
+      entries.swap(buffer);
+    }
+  }
+
+} // namespace Experiment
+
+#endif // RADIX_SORT_H
@@ -0,0 +1,289 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SAMPLE_SORT_H
+#define SAMPLE_SORT_H
+
+/** \file
+ * Sample sort of values spread over several workers, as processes,
+ * connected by a SampleSortTransport.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+#ifndef LIST_MERGE_SORT_H
+#include "ListMergeSort.h"
+#endif // LIST_MERGE_SORT_H
+
+#ifndef LIST_SNAPSHOT_H
+#include "ListSnapshot.h"
+#endif // LIST_SNAPSHOT_H
+
+#ifndef SAMPLE_SORT_TRANSPORT_H
+#include "SampleSortTransport.h"
+#endif // SAMPLE_SORT_TRANSPORT_H
+
+#ifndef SORT_H
+#include "Sort.h"
+#endif // SORT_H
+
+namespace Experiment {
+
+  /** Sends and receives values over a SampleSortTransport, each message
+   * being a list snapshot: a ListSnapshotHeader then the values' bytes.
+   *
+   * \tparam T the type of values, which must be trivially copyable
+   */
+  template<class T>
+    class SampleSortWire {
+  public:
+    static_assert(std::is_trivially_copyable<T>::value, "values are sent as their bytes");
+
+    /** Send count values from first on to the worker of rank to
+     *
+     * \param transport to send over
+     * \param to the rank of the worker to send to
+     * \param first the first value to send
+     * \param count the number of values to send
+     *
+     * \throw std::system_error if sending fails
+     *
+     * \tparam InputIter an input iterator over values of T
+     */
+    template<class InputIter>
+      static void send(SampleSortTransport& transport, size_t to, InputIter first, uint64_t count) {
+      using namespace DoubleLinkedListImpl;
+
+      ListSnapshotHeader header;
+      std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+      header.version = SNAPSHOT_VERSION;
+      header.valueSize = sizeof(T);
+      header.count = count;
+      transport.send(to, &header, sizeof(header));
+
+      std::vector<T> batch;
+      batch.reserve(static_cast<size_t>(std::min(count, static_cast<uint64_t>(SNAPSHOT_BATCH))));
+      while(0 < count) {
+	batch.clear();
+	for( ; 0 < count && batch.size() < SNAPSHOT_BATCH; --count, ++first) {
+	  batch.push_back(*first);
+	}
+	transport.send(to, batch.data(), batch.size() * sizeof(T));
+      }
+    }
+
+    /** Receive values from the worker of rank from, appending them to list
+     *
+     * \param transport to receive over
+     * \param from the rank of the worker to receive from
+     * \param list to append to
+     *
+     * \throw std::invalid_argument if what is received is not values of type T
+     * \throw std::system_error if receiving fails
+     * \throw std::runtime_error if the worker closed its connection first
+     */
+    static void receive(SampleSortTransport& transport, size_t from, DoubleLinkedList<T>& list) {
+      using namespace DoubleLinkedListImpl;
+
+      ListSnapshotHeader header;
+      transport.receive(from, &header, sizeof(header));
+      checkSnapshotHeader(header, sizeof(T));
+
+      std::vector<T> batch(static_cast<size_t>(std::min(header.count, static_cast<uint64_t>(SNAPSHOT_BATCH))));
+      for(uint64_t remaining = header.count; 0 < remaining; ) {
+	const size_t length = static_cast<size_t>(std::min(remaining, static_cast<uint64_t>(batch.size())));
+	transport.receive(from, batch.data(), length * sizeof(T));
+	list.append(batch.data(), batch.data() + length);
+	remaining -= length;
+      }
+    }
+  };
+
+  /** Sample sort of the values of several workers, each calling sort() with
+   * its own values and its own transport to the others.  Afterwards each
+   * worker holds a sorted partition, every value of which is no greater
+   * than any value held by the worker of the next rank.
+   *
+   * Each worker sorts its values by ListMergeSort and sends oversampling
+   * evenly spaced ones to worker 0.  Worker 0 chooses workers - 1 splitters,
+   * evenly spaced among all samples, and sends them to all.  Each worker
+   * then sends each other the run of its values between their splitters, in
+   * workers - 1 rounds of sending to one worker while receiving from
+   * another, and merges the sorted runs it receives by Sort, which merges
+   * natural runs.
+   *
+   * Equal values all go to one worker, so many of one value unbalance the
+   * partitions.  Should a worker fail, those waiting on it fail in turn as
+   * its transport closes.
+   *
+   * \tparam T the type of values, which must be trivially copyable
+   * \tparam Lessor to compare values, default constructed as for ListMergeSort
+   */
+  template<class T, class Lessor = std::less<T> >
+    class SampleSort {
+  public:
+  /** Convenience typedef of the type of data in the list */
+  typedef T value_type;
+
+  /** Convenience typedef of the type of list sorted */
+  typedef DoubleLinkedList<T> DataList;
+
+  /** The default samples sent by each worker */
+  static const size_t DEFAULT_OVERSAMPLING = 64;
+
+  /** Create a sort sending DEFAULT_OVERSAMPLING samples from each worker */
+  SampleSort()
+    : oversampling(DEFAULT_OVERSAMPLING)
+  {
+  }
+
+  /** Replace data, this worker's values, with this worker's partition of
+   * the values of all workers, sorted.
+   *
+   * \param data the values of this worker
+   * \param transport connecting this worker to the others, all of which
+   * must call sort() with the same oversampling
+   *
+   * \throw std::system_error if sending or receiving fails
+   * \throw std::runtime_error if another worker fails
+   */
+  void sort(DataList& data, SampleSortTransport& transport) {
+    ListMergeSort<T, T*, Lessor> local;
+    local.sort(data);
+
+    const size_t workers = transport.workers();
+    if(workers < 2) {
+      return;
+    }
+    const std::vector<T> splitters = chooseSplitters(data, transport);
+
+    // The first value of each worker's run of data, and its length
+    typedef typename DataList::const_iterator DataIter;
+    std::vector<DataIter> starts(workers, data.cend());
+    std::vector<uint64_t> counts(workers, 0);
+    size_t worker = 0;
+    starts[0] = data.cbegin();
+    for(DataIter iter = data.cbegin(); data.cend() != iter; ++iter) {
+      for( ; worker < splitters.size() && !lessor(*iter, splitters[worker]); ++worker) {
+	starts[worker + 1] = iter;
+      }
+      ++counts[worker];
+    }
+
+    // This worker's run, then each other's, in rounds sending to one while receiving from another
+    const size_t rank = transport.rank();
+    DataList received;
+    received.append(starts[rank], rank + 1 < workers ? starts[rank + 1] : data.cend());
+    for(size_t round = 1; round < workers; ++round) {
+      const size_t to = (rank + round) % workers;
+      const size_t from = (rank + workers - round) % workers;
+
+      std::exception_ptr sendError;
+      std::thread sender([&transport, &starts, &counts, &sendError, to]() {
+	  try {
+	    SampleSortWire<T>::send(transport, to, starts[to], counts[to]);
+	  } catch(...) {
+	    sendError = std::current_exception();
+	  }
+	});
+      try {
+	SampleSortWire<T>::receive(transport, from, received);
+      } catch(...) {
+	sender.join();
+	throw;
+      }
+      sender.join();
+      if(sendError) {
+	std::rethrow_exception(sendError);
+      }
+    }
+
+    // Merge the runs received
+    Sort<T, T*, Lessor> merge;
+    merge.sort(received);
+    data.clear();
+    data.append(received.cbegin(), received.cend());
+  }
+
+  /** The samples each worker sends to choose splitters */
+  size_t oversampling;
+
+  private:
+  /** \return the splitters chosen by worker 0 from the samples of all, in
+   * order, so that values less than the first go to worker 0, values not
+   * less than the first but less than the second to worker 1, and so on
+   *
+   * \param sorted the values of this worker, sorted
+   * \param transport connecting this worker to the others
+   */
+  std::vector<T> chooseSplitters(const DataList& sorted, SampleSortTransport& transport) {
+    const size_t length = static_cast<size_t>(std::distance(sorted.cbegin(), sorted.cend()));
+    std::vector<T> samples;
+    const size_t sampleCount = std::min(oversampling, length);
+    typename DataList::const_iterator iter = sorted.cbegin();
+    size_t position = 0;
+    for(size_t sample = 0; sample < sampleCount; ++sample) {
+      // The middle of each of sampleCount equal parts
+      const size_t target = (2 * sample + 1) * length / (2 * sampleCount);
+      for( ; position < target; ++position) {
+	++iter;
+      }
+      samples.push_back(*iter);
+    }
+
+    const size_t workers = transport.workers();
+    if(0 != transport.rank()) {
+      SampleSortWire<T>::send(transport, 0, samples.begin(), samples.size());
+      DataList splitters;
+      SampleSortWire<T>::receive(transport, 0, splitters);
+      return std::vector<T>(splitters.cbegin(), splitters.cend());
+    }
+
+    DataList others;
+    for(size_t from = 1; from < workers; ++from) {
+      SampleSortWire<T>::receive(transport, from, others);
+    }
+    samples.insert(samples.end(), others.cbegin(), others.cend());
+    std::sort(samples.begin(), samples.end(), lessor);
+
+    std::vector<T> splitters;
+    if(!samples.empty()) {
+      for(size_t worker = 1; worker < workers; ++worker) {
+	splitters.push_back(samples[worker * samples.size() / workers]);
+      }
+    }
+    for(size_t to = 1; to < workers; ++to) {
+      SampleSortWire<T>::send(transport, to, splitters.begin(), splitters.size());
+    }
+    return splitters;
+  }
+
+  /** Comparator to decide if one value is less than another */
+  Lessor lessor;
+  };
+
+} // namespace Experiment
+
+#endif // SAMPLE_SORT_H
@@ -0,0 +1,250 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SAMPLE_SORT_TRANSPORT_H
+#define SAMPLE_SORT_TRANSPORT_H
+
+/** \file
+ * Transports connecting the workers of a SampleSort, and one over Unix
+ * domain sockets between local processes.
+ */
+
+#include <cerrno>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Experiment {
+
+  /** Connection of one worker of a SampleSort to each of the others.
+   *
+   * Workers are numbered by rank from 0.  Bytes sent to a worker arrive, in
+   * order, to its receive() from the sender.  send() to one worker and
+   * receive() from another may be called at once from two threads.
+   */
+  class SampleSortTransport {
+  public:
+    virtual ~SampleSortTransport() { }
+
+    /** \return the rank of this worker, from 0 to workers() - 1 */
+    virtual size_t rank() const = 0;
+
+    /** \return the number of workers */
+    virtual size_t workers() const = 0;
+
+    /** Send length bytes of data to the worker of rank to
+     *
+     * \param to the rank of the worker to send to
+     * \param data to send
+     * \param length of data
+     *
+     * \throw std::system_error if sending fails
+     */
+    virtual void send(size_t to, const void* data, size_t length) = 0;
+
+    /** Receive exactly length bytes into data from the worker of rank from
+     *
+     * \param from the rank of the worker to receive from
+     * \param data to receive into
+     * \param length to receive
+     *
+     * \throw std::system_error if receiving fails
+     * \throw std::runtime_error if the worker closed its connection first
+     */
+    virtual void receive(size_t from, void* data, size_t length) = 0;
+  };
+
+  /** SampleSortTransport over a connected stream socket to each other
+   * worker, as Unix domain socket pairs between local processes.
+   */
+  class UnixSocketTransport : public SampleSortTransport {
+  public:
+    /** Create for the worker of theRank, taking ownership of theSockets.
+     *
+     * \param theRank of this worker
+     * \param theSockets a connected stream socket to each worker by rank, and
+     * -1 at theRank
+     */
+    UnixSocketTransport(size_t theRank, const std::vector<int>& theSockets)
+      : myRank(theRank), sockets(theSockets)
+    {
+    }
+
+    /** Close the sockets */
+    virtual ~UnixSocketTransport() {
+      for(std::vector<int>::const_iterator iter = sockets.begin(); sockets.end() != iter; ++iter) {
+	if(0 <= *iter) {
+	  close(*iter);
+	}
+      }
+    }
+
+    UnixSocketTransport(const UnixSocketTransport&) = delete;
+    UnixSocketTransport& operator=(const UnixSocketTransport&) = delete;
+
+    virtual size_t rank() const {
+      return myRank;
+    }
+
+    virtual size_t workers() const {
+      return sockets.size();
+    }
+
+    virtual void send(size_t to, const void* data, size_t length) {
+      const char* at = static_cast<const char*>(data);
+      while(0 < length) {
+	const ssize_t sent = ::send(sockets.at(to), at, length, MSG_NOSIGNAL);
+	if(sent < 0) {
+	  if(EINTR == errno) {
+	    continue;
+	  }
+	  throw std::system_error(errno, std::generic_category(), "sending to worker " + std::to_string(to));
+	}
+	at += sent;
+	length -= static_cast<size_t>(sent);
+      }
+    }
+
+    virtual void receive(size_t from, void* data, size_t length) {
+      char* at = static_cast<char*>(data);
+      while(0 < length) {
+	const ssize_t got = ::recv(sockets.at(from), at, length, 0);
+	if(got < 0) {
+	  if(EINTR == errno) {
+	    continue;
+	  }
+	  throw std::system_error(errno, std::generic_category(), "receiving from worker " + std::to_string(from));
+	}
+	if(0 == got) {
+	  throw std::runtime_error("worker " + std::to_string(from) + " closed its connection");
+	}
+	at += got;
+	length -= static_cast<size_t>(got);
+      }
+    }
+
+    /** Run work in workers local processes, forked from this one, each
+     * given a UnixSocketTransport connected to all the others, and wait for
+     * all to finish.
+     *
+     * Each worker process exits as soon as work returns, without returning
+     * here or running exit handlers, so work must leave its results where
+     * this process can find them, such as in files.  Should a worker fail,
+     * its connections close, so workers waiting on it fail in turn.
+     *
+     * \param workers the number of worker processes
+     * \param work to run in each, given its transport
+     *
+     * \throw std::system_error if the sockets or processes cannot be created
+     * \throw std::runtime_error if any worker throws or does not exit normally
+     */
+    static void runLocal(size_t workers, const std::function<void(SampleSortTransport&)>& work) {
+      std::vector<std::vector<int> > meshSockets(workers, std::vector<int>(workers, -1));
+      try {
+	for(size_t first = 0; first < workers; ++first) {
+	  for(size_t second = first + 1; second < workers; ++second) {
+	    int pair[2];
+	    if(0 != socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair)) {
+	      throw std::system_error(errno, std::generic_category(), "creating worker sockets");
+	    }
+	    meshSockets[first][second] = pair[0];
+	    meshSockets[second][first] = pair[1];
+	  }
+	}
+      } catch(...) {
+	closeAll(meshSockets, workers);
+	throw;
+      }
+
+      std::vector<pid_t> children;
+      std::system_error forkError(0, std::generic_category());
+      for(size_t rank = 0; rank < workers; ++rank) {
+	const pid_t child = fork();
+	if(child < 0) {
+	  forkError = std::system_error(errno, std::generic_category(), "starting worker " + std::to_string(rank));
+	  break;
+	}
+	if(0 == child) {
+	  // Keep only this worker's sockets, so a worker's failure closes its connections
+	  closeAll(meshSockets, rank);
+	  int status = 0;
+	  try {
+	    UnixSocketTransport transport(rank, meshSockets[rank]);
+	    work(transport);
+	  } catch(...) {
+	    status = 1;
+	  }
+	  _exit(status);
+	}
+	children.push_back(child);
+      }
+      closeAll(meshSockets, workers);
+
+      size_t failed = 0;
+      for(std::vector<pid_t>::const_iterator iter = children.begin(); children.end() != iter; ++iter) {
+	int status = 0;
+	pid_t waited = waitpid(*iter, &status, 0);
+	while(waited < 0 && EINTR == errno) {
+	  waited = waitpid(*iter, &status, 0);
+	}
+	// A worker that cannot be waited for is not known to have succeeded
+	if(waited < 0 || !WIFEXITED(status) || 0 != WEXITSTATUS(status)) {
+	  ++failed;
+	}
+      }
+      if(forkError.code()) {
+	throw forkError;
+      }
+      if(0 < failed) {
+	throw std::runtime_error(std::to_string(failed) + " of " + std::to_string(workers) + " workers failed");
+      }
+    }
+
+  private:
+    /** Close every socket of meshSockets but those of the worker of rank keep
+     *
+     * \param meshSockets the sockets of each worker to each other
+     * \param keep the rank of the worker whose sockets to keep, or the number
+     * of workers to close all
+     */
+    static void closeAll(const std::vector<std::vector<int> >& meshSockets, size_t keep) {
+      for(size_t rank = 0; rank < meshSockets.size(); ++rank) {
+	if(keep == rank) {
+	  continue;
+	}
+	for(std::vector<int>::const_iterator iter = meshSockets[rank].begin(); meshSockets[rank].end() != iter; ++iter) {
+	  if(0 <= *iter) {
+	    close(*iter);
+	  }
+	}
+      }
+    }
+
+    /** The rank of this worker */
+    const size_t myRank;
+
+    /** The socket to each worker, by rank, or -1 for this one */
+    const std::vector<int> sockets;
+  };
+
+} // namespace Experiment
+
+#endif // SAMPLE_SORT_TRANSPORT_H
@@ -0,0 +1,221 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SHARDED_LRU_CACHE_H
+#define SHARDED_LRU_CACHE_H
+
+/** \file
+ * Sharded, thread-safe Least-Recently-Used cache definition.
+ */
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#ifndef LRU_CACHE_H
+#include "LruCache.h"
+#endif // LRU_CACHE_H
+
+namespace Experiment {
+
+  /** Thread-safe Least-Recently-Used cache split into independent LruCache
+   * shards by the hash of the key.
+   *
+   * Each shard has its own lock and its own recency order, so threads working
+   * on keys of different shards neither wait for each other nor write the
+   * same cache lines.  Recency, and so eviction, is per shard: the entry
+   * evicted is the least recently used of its shard.
+   *
+   * \tparam K the type of key
+   * \tparam V the type of value, copied out of the cache by get()
+   * \tparam Hash to hash keys
+   * \tparam Weigher to weigh entries against the capacity -- \see EntryWeigher
+   * \tparam KeyEqual to compare keys
+   */
+  template<class K, class V, class Hash = std::hash<K>, class Weigher = EntryWeigher<K, V>, class KeyEqual = std::equal_to<K> >
+    class ShardedLruCache {
+  public:
+    /** Convenience typedef of the type of keys */
+    typedef K key_type;
+
+    /** Convenience typedef of the type of values */
+    typedef V mapped_type;
+
+    /** Convenience typedef of the cache of each shard */
+    typedef LruCache<K, V, Hash, Weigher, KeyEqual> Shard;
+
+  public:
+    /** Create an empty cache.
+     *
+     * The capacity is split as evenly as it can be among the shards, the
+     * first capacity % shardCount shards taking one more than the rest.  So
+     * that no shard has no capacity, a capacity less than shardCount takes
+     * as many shards as the largest power of 2 within it, and at least one.
+     *
+     * \param capacity maximum total weight of the entries, split among the shards
+     * \param shardCount number of shards, a power of 2
+     * \param theHasher to hash keys
+     * \param theWeigher to weigh entries
+     * \param theKeyEqual to compare keys
+     *
+     * \throw std::invalid_argument if shardCount is not a power of 2
+     */
+    ShardedLruCache(size_t capacity, size_t shardCount = 64, const Hash& theHasher = Hash(),
+		    const Weigher& theWeigher = Weigher(), const KeyEqual& theKeyEqual = KeyEqual())
+      : count(shardsFor(capacity, shardCount)), hasher(theHasher)
+    {
+      shards.reset(new PaddedShard[count]);
+      for(size_t index = 0; index < count; ++index) {
+	const size_t shardCapacity = capacity / count + (index < capacity % count ? 1 : 0);
+	shards[index].cache.reset(new Shard(shardCapacity, theHasher, theWeigher, theKeyEqual));
+      }
+    }
+
+  private:
+    ShardedLruCache(const ShardedLruCache& rhs);
+    ShardedLruCache& operator=(const ShardedLruCache& rhs);
+
+  public:
+    /** Copy the value of key to value, making it the most recently used of its shard.
+     *
+     * \param key to find the value of
+     * \param value to copy the value of key to, if cached
+     *
+     * \return true if key was cached, otherwise false
+     */
+    bool get(const K& key, V& value) {
+      PaddedShard& shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      const V* found = shard.cache->get(key);
+      if(NULL == found) {
+	return false;
+      }
+      value = *found;
+      return true;
+    }
+
+    /** Cache value for key, as LruCache::put() on the shard of key.
+     *
+     * \param key to cache value for
+     * \param value to cache
+     *
+     * \return true if cached, false if the entry alone weighs more than a shard's capacity
+     */
+    bool put(const K& key, const V& value) {
+      PaddedShard& shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      return shard.cache->put(key, value);
+    }
+
+    /** Remove the entry of key, if any.
+     *
+     * \param key to remove the entry of
+     *
+     * \return true if key was cached, otherwise false
+     */
+    bool erase(const K& key) {
+      PaddedShard& shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      return shard.cache->erase(key);
+    }
+
+    /** Remove all entries from this cache, one shard at a time. */
+    void clear() {
+      for(size_t index = 0; index < count; ++index) {
+	std::lock_guard<std::mutex> lock(shards[index].mutex);
+	shards[index].cache->clear();
+      }
+    }
+
+    /** \return the number of entries in this cache, summed one shard at a time
+     * so it may be stale with concurrent changes
+     */
+    size_t size() const {
+      size_t total = 0;
+      for(size_t index = 0; index < count; ++index) {
+	std::lock_guard<std::mutex> lock(shards[index].mutex);
+	total += shards[index].cache->size();
+      }
+      return total;
+    }
+
+    /** \return the number of shards */
+    size_t shardCount() const {
+      return count;
+    }
+
+    /** \return the maximum total weight of the entries, the sum of the shards' */
+    size_t capacity() const {
+      size_t total = 0;
+      for(size_t index = 0; index < count; ++index) {
+	total += shards[index].cache->capacity();
+      }
+      return total;
+    }
+
+  private:
+    /** \return the number of shards for capacity: shardCount, or fewer so
+     * that each has some capacity
+     *
+     * \param capacity maximum total weight of the entries
+     * \param shardCount number of shards asked for, a power of 2
+     *
+     * \throw std::invalid_argument if shardCount is not a power of 2
+     */
+    static size_t shardsFor(size_t capacity, size_t shardCount) {
+      if(0 == shardCount || 0 != (shardCount & (shardCount - 1))) {
+	throw std::invalid_argument("shardCount must be a power of 2");
+      }
+      while(1 < shardCount && capacity < shardCount) {
+	shardCount /= 2;
+      }
+      return shardCount;
+    }
+
+    /** A shard and its lock, padded so no two shards share a cache line */
+    struct PaddedShard {
+      /** Lock of cache */
+      mutable std::mutex mutex;
+
+      /** The cache of this shard */
+      std::unique_ptr<Shard> cache;
+
+      /** Keeps the next shard's lock off the cache lines of this one */
+      char padding[64];
+    };
+
+    /** \return the shard of key \param key to find the shard of */
+    PaddedShard& shardOf(const K& key) {
+      // Mix differently from LruCache's buckets, which use the top bits of
+      // the hash multiplied by the golden ratio, so each shard's keys still
+      // spread across its buckets
+      const unsigned long long hash = static_cast<unsigned long long>(hasher(key)) * 0xC2B2AE3D27D4EB4FULL;
+      return shards[(hash >> 32) & (count - 1)];
+    }
+
+  private:
+    /** Number of shards */
+    const size_t count;
+
+    /** Hashes keys to shards */
+    Hash hasher;
+
+    /** The shards */
+    std::unique_ptr<PaddedShard[]> shards;
+  };
+
+} // namespace Experiment
+
+#endif // SHARDED_LRU_CACHE_H
@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SMALL_DOUBLE_LINKED_LIST_H
+#define SMALL_DOUBLE_LINKED_LIST_H
+
+/** \file
+ * DoubleLinkedList with inline storage for its first few values.
+ */
+
+#include <cstddef>
+#include <type_traits>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+namespace Experiment {
+  
+  /** DoubleLinkedList holding up to N nodes inside the list object itself,
+   * allocating nodes on the heap only beyond that.
+   *
+   * For lists of lists where most inner lists are short, each inner list then
+   * costs no allocation beyond its outer node.  A SmallDoubleLinkedList is a
+   * DoubleLinkedList: its iterators are DoubleLinkedList::iterators, and
+   * anything taking a DoubleLinkedList, such as ListMergeSort, takes it.
+   *
+   * Inline slots are used by push_front() and push_back() while any is free;
+   * removing a node frees its slot for reuse.
+   *
+   * \tparam T the type of Data this SmallDoubleLinkedList will hold
+   * \tparam N the number of nodes held inline, a handful as free slots are
+   * found by a linear search
+   *
+   * \note Nodes in inline slots may be moved to other lists, as ListMergeSort
+   * does, but must be back in this list or removed before this list is
+   * destroyed.  Do not destroy a SmallDoubleLinkedList through a pointer to
+   * DoubleLinkedList.
+   */
+  template<class T, size_t N>
+    class SmallDoubleLinkedList : public DoubleLinkedList<T> {
+    static_assert(0 < N, "SmallDoubleLinkedList holds at least 1 node inline");
+
+  private:
+    /** Convenience typedef of the base list */
+    typedef DoubleLinkedList<T> Base;
+
+    /** Convenience typedef of Nodes held inline */
+    typedef DoubleLinkedListImpl::InlineDataNode<T> InlineDataNode;
+
+    /** Uninitialized storage for one InlineDataNode */
+    typedef typename std::aligned_storage<sizeof(InlineDataNode), alignof(InlineDataNode)>::type Slot;
+
+  public:
+    /** Convenience typedef of the type of values in this list */
+    typedef T value_type;
+
+    /** Create a new list */
+    SmallDoubleLinkedList() {
+      markAllFree();
+    }
+
+    /** Copy data from another list, into inline slots first.
+     *
+     * \param rhs to copy from
+     */
+    SmallDoubleLinkedList(const SmallDoubleLinkedList& rhs)
+      : Base()
+    {
+      markAllFree();
+      try {
+	for(typename Base::const_iterator iter = rhs.cbegin(); rhs.cend() != iter; ++iter) {
+	  push_back(*iter);
+	}
+      } catch(...) {
+	this->clear();
+	throw;
+      }
+    }
+
+    /** Destroy a list, freeing its inline slots before they go */
+    ~SmallDoubleLinkedList() {
+      this->clear();
+    }
+
+  private:
+    SmallDoubleLinkedList& operator=(const SmallDoubleLinkedList& rhs);
+
+  public:
+    /** \return the number of nodes held inline */
+    static size_t inlineCapacity() {
+      return N;
+    }
+
+    /** Insert value as the first item in this list and update iterators to
+     * remain at same position.
+     *
+     * \param value to insert at the start of the list
+     */
+    void push_front(const value_type& value) {
+      this->linkFront(create(value));
+    }
+
+    /** Insert value as the last item in this list
+     *
+     * \param value to insert at the end of the list
+     */
+    void push_back(const value_type& value) {
+      this->linkBack(create(value));
+    }
+
+  private:
+    /** Mark all inline slots free */
+    void markAllFree() {
+      for(size_t index = 0; index < N; ++index) {
+	InlineDataNode::markFree(&slots[index]);
+      }
+    }
+
+    /** \return a new unlinked Node holding value, in a free inline slot if any
+     *
+     * \param value to hold
+     */
+    typename Base::Node* create(const value_type& value) {
+      for(size_t index = 0; index < N; ++index) {
+	if(InlineDataNode::isFree(&slots[index])) {
+	  return new (&slots[index]) InlineDataNode(value);
+	}
+      }
+      return new typename Base::DataNode(value);
+    }
+
+  private:
+    /** Storage for the nodes held inline */
+    Slot slots[N];
+  };
+
+} // namespace Experiment
+
+#endif // SMALL_DOUBLE_LINKED_LIST_H
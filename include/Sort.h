@@ -0,0 +1,427 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SORT_H
+#define SORT_H
+
+/** \file
+ * Sort facade choosing a sort engine by a profile of its input
+ */
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#ifndef DOUBLE_LINKED_LIST_H
+#include "DoubleLinkedList.h"
+#endif // DOUBLE_LINKED_LIST_H
+
+#ifndef LIST_KEY_SORT_H
+#include "ListKeySort.h"
+#endif // LIST_KEY_SORT_H
+
+#ifndef LIST_MERGE_SORT_H
+#include "ListMergeSort.h"
+#endif // LIST_MERGE_SORT_H
+
+#ifndef LIST_QUICK_SORT_H
+#include "ListQuickSort.h"
+#endif // LIST_QUICK_SORT_H
+
+#ifndef PREDICATES_H
+#include "Predicates.h"
+#endif // PREDICATES_H
+
+#ifndef RADIX_SORT_H
+#include "RadixSort.h"
+#endif // RADIX_SORT_H
+
+#ifndef SORT_TUNING_H
+#include "SortTuning.h"
+#endif // SORT_TUNING_H
+
+namespace Experiment {
+
+  /** The sort engines Sort chooses between */
+  enum SortStrategy {
+    /** Insertion sort, for tiny inputs */
+    INSERTION_SORT,
+
+    /** Merge of the ascending runs already in the input, for presorted inputs */
+    RUN_MERGE_SORT,
+
+    /** Radix sort by ListKeySort, for arithmetic values compared by std::less */
+    RADIX_SORT,
+
+    /** Three-way partitioning ListQuickSort, for few distinct values */
+    QUICK_SORT,
+
+    /** ListMergeSort, otherwise */
+    MERGE_SORT
+  };
+
+  /** Thresholds by which Sort chooses a sort engine, by default those of
+   * SortTuning.h.
+   */
+  struct SortThresholds {
+    /** Create with the thresholds of SortTuning.h */
+    SortThresholds()
+      : insertionMax(SortTuning::INSERTION_MAX),
+	valuesPerRunMin(SortTuning::VALUES_PER_RUN_MIN),
+	radixMin(SortTuning::RADIX_MIN),
+	fewDistinctMax(SortTuning::FEW_DISTINCT_MAX),
+	distinctSample(SortTuning::DISTINCT_SAMPLE)
+    {
+    }
+
+    /** Inputs of at most this many values are insertion sorted */
+    size_t insertionMax;
+
+    /** Inputs with at least this many values per ascending run are merged from their runs */
+    size_t valuesPerRunMin;
+
+    /** Inputs of at least this many arithmetic values compared by std::less are radix sorted */
+    size_t radixMin;
+
+    /** Inputs with at most this many distinct values in a sample are quick
+     * sorted.  This must be less than distinctSample, or no input is, as a
+     * sample of values all distinct tells nothing of how few they are.
+     */
+    size_t fewDistinctMax;
+
+    /** Values sampled to estimate the number of distinct values */
+    size_t distinctSample;
+  };
+
+  /** Sort choosing its engine by a profile of each input.
+   *
+   * One pass over the input counts its values and its ascending runs.  Then:
+   * - inputs of at most SortThresholds::insertionMax values are insertion sorted;
+   * - inputs of long runs are sorted by merging those runs;
+   * - arithmetic values compared by std::less are radix sorted by ListKeySort;
+   * - if a sample of the values has few distinct values, ListQuickSort sorts;
+   * - otherwise ListMergeSort sorts.
+   *
+   * The thresholds come from SortTuning.h, measured for a machine by
+   * SortCalibration.exe.  Like the engines, sort() taking a DoubleLinkedList
+   * relinks its nodes without copying any value.
+   *
+   * \note The sort is stable only when the engine chosen is; ListQuickSort
+   * is not.
+   *
+   * \tparam T the data type being sorted
+   * \tparam Iterator the iterator of ranges given to sort(begin, end)
+   * \tparam Lessor to compare items
+   * \tparam Metrics to collect metrics on the sort -- \see NoSortMetrics as an example
+   */
+  template<class T, class Iterator = T*, class Lessor = std::less<T>, class Metrics = NoSortMetrics<T> >
+    class Sort {
+  public:
+  /** Convenience typedef of the type of data in the list */
+  typedef T value_type;
+
+  /** Convenience typedef of the type of list used in this sort */
+  typedef DoubleLinkedList<T> DataList;
+
+  private:
+  /** Convenience typedef of the non-tracking iterator of DataList */
+  typedef typename DataList::unsafe_iterator DataCursor;
+
+  /** Whether values may be radix sorted: arithmetic and compared by std::less */
+  typedef std::integral_constant<bool, RadixKey<T>::supported
+                                 && std::is_same<Lessor, std::less<T> >::value> UseRadix;
+
+  public:
+  /** Create a sort, with no sort done yet */
+  Sort()
+    : strategy(MERGE_SORT)
+  {
+  }
+  
+  /** Sort from begin to end.
+   *
+   * \param begin first value to sort
+   * \param end the position after the last value to sort
+   */ 
+  void sort(const Iterator begin, const Iterator end) {
+    std::vector<const T*> order;
+    for(Iterator iter = begin; iter != end; ++iter) {
+      order.push_back(&*iter);
+    }
+
+    strategy = choose(order, UseRadix());
+    switch(strategy) {
+    case RADIX_SORT:
+      sortWith<ListKeySort<T, IdentityKey<T>, Iterator, Metrics> >(begin, end);
+      return;
+    case QUICK_SORT:
+      sortWith<ListQuickSort<T, Iterator, Lessor, Metrics> >(begin, end);
+      return;
+    case MERGE_SORT:
+      sortWith<ListMergeSort<T, Iterator, Lessor, Metrics> >(begin, end);
+      return;
+    default:
+      break;
+    }
+
+    metrics.reset();
+    sortPositions(order);
+
+    std::vector<T> sorted;
+    sorted.reserve(order.size());
+    for(typename std::vector<const T*>::const_iterator iter = order.begin(); order.end() != iter; ++iter) {
+      sorted.push_back(**iter);
+    }
+
+    Iterator originalIter = begin;
+    for(typename std::vector<T>::const_iterator sortedIter = sorted.begin(); sorted.end() != sortedIter; ++sortedIter, ++originalIter) {
+      *originalIter = *sortedIter;
+    }
+    metrics.done();
+  }
+
+  /** Sort the values in data by relinking its nodes, without copying any value.
+   *
+   * As for other changes to a DoubleLinkedList, its iterators remain at the
+   * same positions.
+   *
+   * \param data the list to sort
+   *
+   * \tparam Stats the statistics policy of the list
+   */
+  template<class Stats>
+  void sort(DoubleLinkedList<T, Stats>& data) {
+    std::vector<DataCursor> order;
+    for(DataCursor iter = data.unsafeBegin(); data.unsafeEnd() != iter; ++iter) {
+      order.push_back(iter);
+    }
+
+    strategy = choose(order, UseRadix());
+    switch(strategy) {
+    case RADIX_SORT:
+      sortWith<ListKeySort<T, IdentityKey<T>, Iterator, Metrics> >(data);
+      return;
+    case QUICK_SORT:
+      sortWith<ListQuickSort<T, Iterator, Lessor, Metrics> >(data);
+      return;
+    case MERGE_SORT:
+      sortWith<ListMergeSort<T, Iterator, Lessor, Metrics> >(data);
+      return;
+    default:
+      break;
+    }
+
+    metrics.reset();
+    sortPositions(order);
+    data.relink(order.begin(), order.end());
+    metrics.done();
+  }
+
+  private:
+
+  /** \return the engine to sort the values at positions with
+   *
+   * \param positions of the values to sort
+   * \param useRadix whether values may be radix sorted
+   *
+   * \tparam Position the type of positions
+   * \tparam UseRadixTag std::true_type or std::false_type as values may be radix sorted
+   */
+  template<class Position, class UseRadixTag>
+  SortStrategy choose(const std::vector<Position>& positions, UseRadixTag useRadix) {
+    const size_t size = positions.size();
+    if(size <= thresholds.insertionMax) {
+      return INSERTION_SORT;
+    }
+
+    size_t runs = 1;
+    for(size_t index = 1; index < size; ++index) {
+      if(lessor(*positions[index], *positions[index - 1])) {
+	++runs;
+      }
+    }
+    if(thresholds.valuesPerRunMin <= size / runs) {
+      return RUN_MERGE_SORT;
+    }
+
+    if(useRadix && thresholds.radixMin <= size) {
+      return RADIX_SORT;
+    }
+
+    if(thresholds.fewDistinctMax < thresholds.distinctSample
+       && sampleDistinct(positions) <= thresholds.fewDistinctMax) {
+      return QUICK_SORT;
+    }
+    return MERGE_SORT;
+  }
+
+  /** \return the number of distinct values in an evenly spaced sample of the
+   * values at positions
+   *
+   * \param positions of the values to sample
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  size_t sampleDistinct(const std::vector<Position>& positions) {
+    const size_t samples = std::min(thresholds.distinctSample, positions.size());
+    std::vector<const T*> sample;
+    sample.reserve(samples);
+    for(size_t index = 0; index < samples; ++index) {
+      sample.push_back(&*positions[index * positions.size() / samples]);
+    }
+    std::sort(sample.begin(), sample.end(), [this](const T* a, const T* b) {
+	return lessor(*a, *b);
+      });
+
+    size_t distinct = sample.empty() ? 0 : 1;
+    for(size_t index = 1; index < sample.size(); ++index) {
+      if(lessor(*sample[index - 1], *sample[index])) {
+	++distinct;
+      }
+    }
+    return distinct;
+  }
+
+  /** Sort from begin to end with Engine, taking its metrics.
+   *
+   * \param begin first value to sort
+   * \param end the position after the last value to sort
+   *
+   * \tparam Engine the sort engine
+   */
+  template<class Engine>
+  void sortWith(const Iterator begin, const Iterator end) {
+    Engine engine;
+    engine.sort(begin, end);
+    metrics = engine.metrics;
+  }
+
+  /** Sort data with Engine, taking its metrics.
+   *
+   * \param data the list to sort
+   *
+   * \tparam Engine the sort engine
+   * \tparam Stats the statistics policy of the list
+   */
+  template<class Engine, class Stats>
+  void sortWith(DoubleLinkedList<T, Stats>& data) {
+    Engine engine;
+    engine.sort(data);
+    metrics = engine.metrics;
+  }
+
+  /** Stable sort of positions by the values at them, by the engines of this
+   * class: INSERTION_SORT or RUN_MERGE_SORT.
+   *
+   * \param positions to sort, each dereferencing to a value
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  void sortPositions(std::vector<Position>& positions) {
+    if(INSERTION_SORT == strategy) {
+      insertionSort(positions);
+    } else {
+      runMergeSort(positions);
+    }
+  }
+
+  /** Stable insertion sort of positions.
+   *
+   * \param positions to sort, each dereferencing to a value
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  void insertionSort(std::vector<Position>& positions) {
+    for(size_t next = 1; next < positions.size(); ++next) {
+      const Position inserted = positions[next];
+      size_t hole = next;
+      for( ; 0 < hole && less(*inserted, *positions[hole - 1]); --hole) {
+	positions[hole] = positions[hole - 1];
+	metrics.swap();
+      }
+      positions[hole] = inserted;
+    }
+  }
+
+  /** Stable merge sort of positions starting from the ascending runs in them.
+   *
+   * \param positions to sort, each dereferencing to a value
+   *
+   * \tparam Position the type of positions
+   */
+  template<class Position>
+  void runMergeSort(std::vector<Position>& positions) {
+    // Starts of each run, and the end
+    std::vector<size_t> bounds(1, 0);
+    for(size_t index = 1; index < positions.size(); ++index) {
+      if(less(*positions[index], *positions[index - 1])) {
+	bounds.push_back(index);
+      }
+    }
+    bounds.push_back(positions.size());
+
+    // Merge pairs of runs until one remains
+    std::vector<Position> merged(positions.size());
+    const auto byValue = [this](const Position& a, const Position& b) {
+      return less(*a, *b);
+    };
+    while(2 < bounds.size()) {
+      std::vector<size_t> mergedBounds(1, 0);
+      size_t run = 0;
+      for( ; run + 2 < bounds.size(); run += 2) {
+	std::merge(positions.begin() + bounds[run], positions.begin() + bounds[run + 1],
+		   positions.begin() + bounds[run + 1], positions.begin() + bounds[run + 2],
+		   merged.begin() + bounds[run], byValue);
+	mergedBounds.push_back(bounds[run + 2]);
+      }
+      if(run + 1 < bounds.size()) {
+	std::copy(positions.begin() + bounds[run], positions.end(), merged.begin() + bounds[run]);
+	mergedBounds.push_back(positions.size());
+      }
+      positions.swap(merged);
+      bounds.swap(mergedBounds);
+    }
+  }
+
+  /** \return true if a is less than b, noting the comparison in metrics
+   *
+   * \param a the value to compare with b
+   * \param b the value to compare with a
+   */
+  bool less(const T& a, const T& b) {
+    metrics.compare(a, b);
+    return lessor(a, b);
+  }
+
+  private:
+  /** Comparison of values */
+  Lessor lessor;
+
+  public:
+  /** Thresholds by which engines are chosen */
+  SortThresholds thresholds;
+
+  /** The engine the last sort chose */
+  SortStrategy strategy;
+  
+  /** Collection of metrics for the caller to inspect details of the sort */
+  Metrics metrics;
+  };
+
+} // namespace Experiment
+
+#endif // SORT_H
@@ -0,0 +1,506 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SORT_KERNELS_H
+#define SORT_KERNELS_H
+
+/** \file
+ * Branch-free sorting networks for small blocks of arithmetic values
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+/** Defined to 1 when the AVX2 kernels are compiled in, selected at runtime */
+#define SORT_KERNELS_HAVE_AVX2 1
+#include <immintrin.h>
+#else
+#define SORT_KERNELS_HAVE_AVX2 0
+#endif
+
+/** Forces the sorting network into its caller, so the network built from
+ * AVX2 lanes is compiled in the AVX2 kernel calling it.
+ */
+#define SORT_KERNELS_INLINE inline __attribute__((always_inline))
+
+/** Compiles a function for AVX2 regardless of the compiler flags */
+#define SORT_KERNELS_AVX2 __attribute__((target("avx2")))
+
+namespace Experiment {
+
+  /** Sorting networks sorting blocks of BLOCK values without branching on
+   * the values, and merging two sorted blocks with a bitonic merge.
+   *
+   * Blocks are sorted by a bitonic sorting network working on AVX2 registers
+   * when the CPU supports it, found at runtime, and on single values
+   * otherwise.  Supported types are signed 32 and 64 bit integers, float and
+   * double -- \see Supported
+   *
+   * Comparisons are as by operator<.  Each step is a permutation of the
+   * values, so values comparing equal, such as -0.0 and 0.0, and NaN are
+   * kept though their order is unspecified.
+   */
+  namespace SortKernels {
+
+    /** Number of values in a block sorted by sortBlock() */
+    const size_t BLOCK = 64;
+
+    /** Whether the kernels support sorting values of type T
+     *
+     * \tparam T the type of value to sort
+     */
+    template<class T>
+      struct Supported
+      : std::integral_constant<bool,
+                               (std::is_integral<T>::value && std::is_signed<T>::value && (4 == sizeof(T) || 8 == sizeof(T)))
+                               || std::is_same<T, float>::value
+                               || std::is_same<T, double>::value> {
+    };
+
+    /** \return the value sorting after all others, to fill a partial block */
+    template<class T>
+      T padding() {
+      return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+
+    /** \return true if data may be filled with padding() to a whole block and
+     * still sort the given values first, which is false only with NaN.
+     *
+     * \param data values to check
+     * \param length of data
+     */
+    template<class T>
+      bool isPaddable(const T* data, size_t length) {
+      for(size_t index = 0; index < length; ++index) {
+	if(data[index] != data[index]) {
+	  return false;
+	}
+      }
+      return true;
+    }
+
+    /** Lanes of one value: the network on scalar values, used when the CPU has
+     * no AVX2.  Compare-exchanges compile to conditional moves.
+     *
+     * \tparam T the type of value to sort
+     */
+    template<class T>
+      struct ScalarLanes {
+      /** Number of values in a register */
+      static const size_t WIDTH = 1;
+
+      /** Leave the lesser of the values at low and high at low and the other
+       * at high.
+       *
+       * \param low to hold the lesser value
+       * \param high to hold the greater value
+       */
+      static void compareExchange(T* low, T* high) {
+	const T a = *low;
+	const T b = *high;
+	*low = b < a ? b : a;
+	*high = b < a ? a : b;
+      }
+
+      /** Compare-exchange the pairs of values distance apart within the
+       * register at at, as exchangeStage() does across registers.  A register
+       * of one value has no such pairs, so this is never called.
+       *
+       * \param at the register of values to exchange
+       * \param distance between the values exchanged, less than WIDTH
+       * \param direction the bit of the index selecting descending order
+       * \param base the index of the value at at
+       */
+      static void exchangeWithin(T* at, size_t distance, size_t direction, size_t base) {
+      }
+    };
+
+#if SORT_KERNELS_HAVE_AVX2
+
+    /** Lanes of AVX2 registers -- specialized per size and kind of T
+     *
+     * \tparam T the type of value to sort
+     */
+    template<class T, size_t size = sizeof(T), bool floating = std::is_floating_point<T>::value>
+      struct Avx2Lanes;
+
+    /** Masks selecting lanes for exchanges within a register of 8 32-bit lanes */
+    struct Avx2Masks32 {
+      /** Number of values in a register */
+      static const size_t WIDTH = 8;
+
+      /** \return all bits set in lanes whose index plus base has bit set
+       *
+       * \param bit to test each lane index for
+       * \param base added to each lane index
+       */
+      SORT_KERNELS_AVX2 static __m256i hasBit(size_t bit, size_t base) {
+	const __m256i lanes = _mm256_add_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(base)));
+	const __m256i bits = _mm256_set1_epi32(static_cast<int>(bit));
+	return _mm256_cmpeq_epi32(_mm256_and_si256(lanes, bits), bits);
+      }
+
+      /** \return permutation indexes of each lane's partner distance away
+       * \param distance between partners
+       */
+      SORT_KERNELS_AVX2 static __m256i partners(size_t distance) {
+	return _mm256_xor_si256(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(distance)));
+      }
+    };
+
+    /** Masks selecting lanes for exchanges within a register of 4 64-bit lanes */
+    struct Avx2Masks64 {
+      /** Number of values in a register */
+      static const size_t WIDTH = 4;
+
+      /** \return all bits set in lanes whose index plus base has bit set
+       *
+       * \param bit to test each lane index for
+       * \param base added to each lane index
+       */
+      SORT_KERNELS_AVX2 static __m256i hasBit(size_t bit, size_t base) {
+	const __m256i lanes = _mm256_add_epi64(_mm256_setr_epi64x(0, 1, 2, 3), _mm256_set1_epi64x(static_cast<long long>(base)));
+	const __m256i bits = _mm256_set1_epi64x(static_cast<long long>(bit));
+	return _mm256_cmpeq_epi64(_mm256_and_si256(lanes, bits), bits);
+      }
+
+      /** \return 32-bit permutation indexes of each lane's partner distance away
+       * \param distance between partners
+       */
+      SORT_KERNELS_AVX2 static __m256i partners(size_t distance) {
+	const __m256i twice = _mm256_slli_epi64(_mm256_xor_si256(_mm256_setr_epi64x(0, 1, 2, 3), _mm256_set1_epi64x(static_cast<long long>(distance))), 1);
+	return _mm256_or_si256(twice, _mm256_slli_epi64(_mm256_add_epi64(twice, _mm256_set1_epi64x(1)), 32));
+      }
+    };
+
+    /** Lanes of 8 signed 32-bit integers */
+    template<class T>
+      struct Avx2Lanes<T, 4, false> : Avx2Masks32 {
+      /** The register holding WIDTH values */
+      typedef __m256i Vector;
+
+      SORT_KERNELS_AVX2 static Vector load(const T* from) {
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from));
+      }
+
+      SORT_KERNELS_AVX2 static void store(T* to, Vector value) {
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(to), value);
+      }
+
+      SORT_KERNELS_AVX2 static void exchange(Vector& low, Vector& high) {
+	const Vector a = low;
+	low = _mm256_min_epi32(a, high);
+	high = _mm256_max_epi32(a, high);
+      }
+
+      SORT_KERNELS_AVX2 static Vector exchange(Vector value, size_t distance, size_t direction, size_t base) {
+	const Vector partner = _mm256_permutevar8x32_epi32(value, partners(distance));
+	const __m256i upper = hasBit(distance, 0);
+	Vector low = _mm256_blendv_epi8(value, partner, upper);
+	Vector high = _mm256_blendv_epi8(partner, value, upper);
+	exchange(low, high);
+	return _mm256_blendv_epi8(low, high, _mm256_xor_si256(upper, hasBit(direction, base)));
+      }
+
+      /** \see ScalarLanes::compareExchange */
+      SORT_KERNELS_AVX2 static void compareExchange(T* low, T* high) {
+	Vector first = load(low);
+	Vector second = load(high);
+	exchange(first, second);
+	store(low, first);
+	store(high, second);
+      }
+
+      /** \see ScalarLanes::exchangeWithin */
+      SORT_KERNELS_AVX2 static void exchangeWithin(T* at, size_t distance, size_t direction, size_t base) {
+	store(at, exchange(load(at), distance, direction, base));
+      }
+    };
+
+    /** Lanes of 4 signed 64-bit integers */
+    template<class T>
+      struct Avx2Lanes<T, 8, false> : Avx2Masks64 {
+      /** The register holding WIDTH values */
+      typedef __m256i Vector;
+
+      SORT_KERNELS_AVX2 static Vector load(const T* from) {
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from));
+      }
+
+      SORT_KERNELS_AVX2 static void store(T* to, Vector value) {
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(to), value);
+      }
+
+      SORT_KERNELS_AVX2 static void exchange(Vector& low, Vector& high) {
+	const Vector a = low;
+	const __m256i greater = _mm256_cmpgt_epi64(a, high);
+	low = _mm256_blendv_epi8(a, high, greater);
+	high = _mm256_blendv_epi8(high, a, greater);
+      }
+
+      SORT_KERNELS_AVX2 static Vector exchange(Vector value, size_t distance, size_t direction, size_t base) {
+	const Vector partner = _mm256_permutevar8x32_epi32(value, partners(distance));
+	const __m256i upper = hasBit(distance, 0);
+	Vector low = _mm256_blendv_epi8(value, partner, upper);
+	Vector high = _mm256_blendv_epi8(partner, value, upper);
+	exchange(low, high);
+	return _mm256_blendv_epi8(low, high, _mm256_xor_si256(upper, hasBit(direction, base)));
+      }
+
+      /** \see ScalarLanes::compareExchange */
+      SORT_KERNELS_AVX2 static void compareExchange(T* low, T* high) {
+	Vector first = load(low);
+	Vector second = load(high);
+	exchange(first, second);
+	store(low, first);
+	store(high, second);
+      }
+
+      /** \see ScalarLanes::exchangeWithin */
+      SORT_KERNELS_AVX2 static void exchangeWithin(T* at, size_t distance, size_t direction, size_t base) {
+	store(at, exchange(load(at), distance, direction, base));
+      }
+    };
+
+    /** Lanes of 8 floats */
+    template<class T>
+      struct Avx2Lanes<T, 4, true> : Avx2Masks32 {
+      /** The register holding WIDTH values */
+      typedef __m256 Vector;
+
+      SORT_KERNELS_AVX2 static Vector load(const T* from) {
+	return _mm256_loadu_ps(from);
+      }
+
+      SORT_KERNELS_AVX2 static void store(T* to, Vector value) {
+	_mm256_storeu_ps(to, value);
+      }
+
+      // min(a, b) and max(b, a) each take b when a and b are unordered or
+      // equal, so a and b are both kept
+      SORT_KERNELS_AVX2 static void exchange(Vector& low, Vector& high) {
+	const Vector a = low;
+	low = _mm256_min_ps(a, high);
+	high = _mm256_max_ps(high, a);
+      }
+
+      SORT_KERNELS_AVX2 static Vector exchange(Vector value, size_t distance, size_t direction, size_t base) {
+	const Vector partner = _mm256_permutevar8x32_ps(value, partners(distance));
+	const __m256 upper = _mm256_castsi256_ps(hasBit(distance, 0));
+	Vector low = _mm256_blendv_ps(value, partner, upper);
+	Vector high = _mm256_blendv_ps(partner, value, upper);
+	exchange(low, high);
+	return _mm256_blendv_ps(low, high, _mm256_xor_ps(upper, _mm256_castsi256_ps(hasBit(direction, base))));
+      }
+
+      /** \see ScalarLanes::compareExchange */
+      SORT_KERNELS_AVX2 static void compareExchange(T* low, T* high) {
+	Vector first = load(low);
+	Vector second = load(high);
+	exchange(first, second);
+	store(low, first);
+	store(high, second);
+      }
+
+      /** \see ScalarLanes::exchangeWithin */
+      SORT_KERNELS_AVX2 static void exchangeWithin(T* at, size_t distance, size_t direction, size_t base) {
+	store(at, exchange(load(at), distance, direction, base));
+      }
+    };
+
+    /** Lanes of 4 doubles */
+    template<class T>
+      struct Avx2Lanes<T, 8, true> : Avx2Masks64 {
+      /** The register holding WIDTH values */
+      typedef __m256d Vector;
+
+      SORT_KERNELS_AVX2 static Vector load(const T* from) {
+	return _mm256_loadu_pd(from);
+      }
+
+      SORT_KERNELS_AVX2 static void store(T* to, Vector value) {
+	_mm256_storeu_pd(to, value);
+      }
+
+      // min(a, b) and max(b, a) each take b when a and b are unordered or
+      // equal, so a and b are both kept
+      SORT_KERNELS_AVX2 static void exchange(Vector& low, Vector& high) {
+	const Vector a = low;
+	low = _mm256_min_pd(a, high);
+	high = _mm256_max_pd(high, a);
+      }
+
+      SORT_KERNELS_AVX2 static Vector exchange(Vector value, size_t distance, size_t direction, size_t base) {
+	const Vector partner = _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(value), partners(distance)));
+	const __m256d upper = _mm256_castsi256_pd(hasBit(distance, 0));
+	Vector low = _mm256_blendv_pd(value, partner, upper);
+	Vector high = _mm256_blendv_pd(partner, value, upper);
+	exchange(low, high);
+	return _mm256_blendv_pd(low, high, _mm256_xor_pd(upper, _mm256_castsi256_pd(hasBit(direction, base))));
+      }
+
+      /** \see ScalarLanes::compareExchange */
+      SORT_KERNELS_AVX2 static void compareExchange(T* low, T* high) {
+	Vector first = load(low);
+	Vector second = load(high);
+	exchange(first, second);
+	store(low, first);
+	store(high, second);
+      }
+
+      /** \see ScalarLanes::exchangeWithin */
+      SORT_KERNELS_AVX2 static void exchangeWithin(T* at, size_t distance, size_t direction, size_t base) {
+	store(at, exchange(load(at), distance, direction, base));
+      }
+    };
+
+    /** \return true if the CPU running this supports AVX2 */
+    inline bool hasAvx2() {
+      static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+      return supported;
+    }
+
+#endif // SORT_KERNELS_HAVE_AVX2
+
+    /** Compare-exchange each value of data with the one distance after it, in
+     * ascending order where the index has direction clear and descending
+     * otherwise.
+     *
+     * \param data the LENGTH values to exchange
+     * \param distance between the values exchanged, a power of 2
+     * \param direction the bit of the index selecting descending order
+     *
+     * \tparam Lanes the registers to exchange in -- \see ScalarLanes
+     * \tparam LENGTH of data, a power of 2 and a multiple of Lanes::WIDTH
+     * \tparam T the type of value to sort
+     */
+    template<class Lanes, size_t LENGTH, class T>
+      SORT_KERNELS_INLINE void exchangeStage(T* data, size_t distance, size_t direction) {
+      for(size_t base = 0; base < LENGTH; base += Lanes::WIDTH) {
+	if(distance < Lanes::WIDTH) {
+	  Lanes::exchangeWithin(data + base, distance, direction, base);
+	} else if(0 == (base & distance)) {
+	  if(0 == (base & direction)) {
+	    Lanes::compareExchange(data + base, data + base + distance);
+	  } else {
+	    Lanes::compareExchange(data + base + distance, data + base);
+	  }
+	}
+      }
+    }
+
+    /** Sort data ascending with a bitonic sorting network.
+     *
+     * \param data the LENGTH values to sort
+     *
+     * \tparam Lanes the registers to sort in -- \see ScalarLanes
+     * \tparam LENGTH of data, a power of 2 and a multiple of Lanes::WIDTH
+     * \tparam T the type of value to sort
+     */
+    template<class Lanes, size_t LENGTH, class T>
+      SORT_KERNELS_INLINE void bitonicSort(T* data) {
+      for(size_t direction = 2; direction <= LENGTH; direction *= 2) {
+	for(size_t distance = direction / 2; 0 < distance; distance /= 2) {
+	  exchangeStage<Lanes, LENGTH>(data, distance, direction);
+	}
+      }
+    }
+
+    /** Sort a bitonic data -- ascending then descending -- ascending.
+     *
+     * \param data the LENGTH values to sort
+     *
+     * \tparam Lanes the registers to sort in -- \see ScalarLanes
+     * \tparam LENGTH of data, a power of 2 and a multiple of Lanes::WIDTH
+     * \tparam T the type of value to sort
+     */
+    template<class Lanes, size_t LENGTH, class T>
+      SORT_KERNELS_INLINE void bitonicMerge(T* data) {
+      for(size_t distance = LENGTH / 2; 0 < distance; distance /= 2) {
+	exchangeStage<Lanes, LENGTH>(data, distance, LENGTH);
+      }
+    }
+
+#if SORT_KERNELS_HAVE_AVX2
+    /** sortBlock() in AVX2 registers \param block to sort */
+    template<class T>
+      SORT_KERNELS_AVX2 void sortBlockAvx2(T* block) {
+      bitonicSort<Avx2Lanes<T>, BLOCK>(block);
+    }
+
+    /** Bitonic merge of 2 * BLOCK values in AVX2 registers \param blocks to merge */
+    template<class T>
+      SORT_KERNELS_AVX2 void mergeBlocksAvx2(T* blocks) {
+      bitonicMerge<Avx2Lanes<T>, 2 * BLOCK>(blocks);
+    }
+#endif // SORT_KERNELS_HAVE_AVX2
+
+    /** sortBlock() on scalar values \param block to sort */
+    template<class T>
+      void sortBlockScalar(T* block) {
+      bitonicSort<ScalarLanes<T>, BLOCK>(block);
+    }
+
+    /** Bitonic merge of 2 * BLOCK values on scalar values \param blocks to merge */
+    template<class T>
+      void mergeBlocksScalar(T* blocks) {
+      bitonicMerge<ScalarLanes<T>, 2 * BLOCK>(blocks);
+    }
+
+    /** Sort the BLOCK values of block ascending.
+     *
+     * \param block the values to sort, padded with padding() if need be
+     *
+     * \tparam T the type of value to sort, which must be Supported
+     */
+    template<class T>
+      void sortBlock(T* block) {
+      static_assert(Supported<T>::value, "SortKernels do not support this type");
+#if SORT_KERNELS_HAVE_AVX2
+      if(hasAvx2()) {
+	sortBlockAvx2(block);
+	return;
+      }
+#endif // SORT_KERNELS_HAVE_AVX2
+      sortBlockScalar(block);
+    }
+
+    /** Merge two sorted blocks following one another in blocks into 2 * BLOCK
+     * sorted values.
+     *
+     * \param blocks two sorted blocks of BLOCK values to merge in place
+     *
+     * \tparam T the type of value to sort, which must be Supported
+     */
+    template<class T>
+      void mergeBlocks(T* blocks) {
+      static_assert(Supported<T>::value, "SortKernels do not support this type");
+      // Reversing the second block makes the values bitonic
+      std::reverse(blocks + BLOCK, blocks + 2 * BLOCK);
+#if SORT_KERNELS_HAVE_AVX2
+      if(hasAvx2()) {
+	mergeBlocksAvx2(blocks);
+	return;
+      }
+#endif // SORT_KERNELS_HAVE_AVX2
+      mergeBlocksScalar(blocks);
+    }
+
+  } // namespace SortKernels
+
+} // namespace Experiment
+
+#endif // SORT_KERNELS_H
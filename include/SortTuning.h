@@ -0,0 +1,49 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SORT_TUNING_H
+#define SORT_TUNING_H
+
+/** \file
+ * Thresholds by which Sort chooses a sort engine.
+ *
+ * Generated by SortCalibration.exe; run "make tune" to measure this machine
+ * and rewrite this file.
+ */
+
+#include <cstddef>
+
+namespace Experiment {
+
+  namespace SortTuning {
+
+    /** Inputs of at most this many values are insertion sorted */
+    const size_t INSERTION_MAX = 64;
+
+    /** Inputs with at least this many values per ascending run are merged from their runs */
+    const size_t VALUES_PER_RUN_MIN = 4;
+
+    /** Inputs of at least this many arithmetic values compared by std::less are radix sorted */
+    const size_t RADIX_MIN = 65;
+
+    /** Inputs with at most this many distinct values in a sample are quick sorted */
+    const size_t FEW_DISTINCT_MAX = 32;
+
+    /** Values sampled to estimate the number of distinct values */
+    const size_t DISTINCT_SAMPLE = 64;
+
+  } // namespace SortTuning
+
+} // namespace Experiment
+
+#endif // SORT_TUNING_H
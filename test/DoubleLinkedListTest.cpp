@@ -15,7 +15,15 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  * Test Cases for DoubleLinkedList
  */
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include "DoubleLinkedList.h"
 
@@ -561,6 +569,221 @@ TYPED_TEST_P(DoubleLinkedListTest, nestedList) {
   EXPECT_EQ(0, *nestedIter->begin());
 }
 
+TYPED_TEST_P(DoubleLinkedListTest, constIterTraits) {
+  typedef typename TestFixture::List::const_iterator ConstIter;
+  typedef std::iterator_traits<ConstIter> Traits;
+
+  static_assert(std::is_trivially_copyable<ConstIter>::value, "const_iterator is a bare pointer");
+  static_assert(std::is_same<std::bidirectional_iterator_tag, typename Traits::iterator_category>::value,
+		"const_iterator is bidirectional");
+  static_assert(std::is_same<typename TestFixture::value_type, typename Traits::value_type>::value,
+		"const_iterator value_type");
+  static_assert(std::is_same<const typename TestFixture::value_type&, typename Traits::reference>::value,
+		"const_iterator is read-only");
+
+  typename TestFixture::List list;
+  list.push_back(0);
+  list.push_back(1);
+  list.push_back(2);
+  const typename TestFixture::List& constList = list;
+
+  EXPECT_EQ(3, std::distance(constList.begin(), constList.end()));
+  EXPECT_EQ(1, *std::find(constList.begin(), constList.end(), 1));
+  EXPECT_EQ(constList.end(), std::find(constList.begin(), constList.end(), 3));
+
+  ConstIter last = constList.end();
+  --last;
+  EXPECT_EQ(2, *last);
+
+  typename TestFixture::value_type expected[] = { 2, 1, 0 };
+  EXPECT_TRUE(std::equal(expected, expected + 3, std::reverse_iterator<ConstIter>(constList.end())));
+}
+
+TYPED_TEST_P(DoubleLinkedListTest, unsafeIterMove) {
+  typedef typename TestFixture::List::unsafe_iterator UnsafeIter;
+  static_assert(std::is_trivially_copyable<UnsafeIter>::value, "unsafe_iterator is a bare pointer");
+
+  typename TestFixture::List from;
+  from.push_back(0);
+  from.push_back(1);
+  from.push_back(2);
+  typename TestFixture::List to;
+
+  // Cursors stay with their Node rather than their position
+  UnsafeIter move = from.unsafeBegin();
+  ++move;
+  move.moveBefore(to.unsafeEnd());
+  EXPECT_EQ(1, *move);
+  EXPECT_EQ(to.unsafeBegin(), move);
+
+  typename TestFixture::value_type fromExpected[] = { 0, 2 };
+  verify<2>(fromExpected, from);
+  typename TestFixture::value_type toExpected[] = { 1 };
+  verify<1>(toExpected, to);
+
+  UnsafeIter first = from.unsafeBegin();
+  UnsafeIter second = first;
+  ++second;
+  first.swapWith(second);
+  EXPECT_EQ(0, *first);
+  EXPECT_EQ(2, *second);
+  EXPECT_EQ(from.unsafeBegin(), second);
+
+  typename TestFixture::value_type swappedExpected[] = { 2, 0 };
+  verify<2>(swappedExpected, from);
+
+  // A modifiable Cursor converts to a read-only one
+  typename TestFixture::List::const_iterator constFirst = from.unsafeBegin();
+  EXPECT_EQ(from.cbegin(), constFirst);
+}
+
+TYPED_TEST_P(DoubleLinkedListTest, iterTraits) {
+  typedef typename TestFixture::Iterator Iter;
+  typedef std::iterator_traits<Iter> Traits;
+
+  static_assert(std::is_same<std::bidirectional_iterator_tag, typename Traits::iterator_category>::value,
+		"iterator is bidirectional");
+  static_assert(std::is_same<typename TestFixture::value_type, typename Traits::value_type>::value,
+		"iterator value_type");
+  static_assert(std::is_same<std::ptrdiff_t, typename Traits::difference_type>::value,
+		"iterator difference_type");
+  static_assert(std::is_same<typename TestFixture::value_type&, typename Traits::reference>::value,
+		"iterator reference");
+
+  typename TestFixture::List list;
+  list.push_back(1);
+  list.push_back(2);
+  list.push_back(3);
+
+  Iter unset;
+  unset = list.begin();
+  EXPECT_EQ(list.begin(), unset);
+
+  EXPECT_EQ(3, std::distance(list.begin(), list.end()));
+  EXPECT_EQ(3, Experiment::distance(list.begin(), list.end()));
+  EXPECT_EQ(6, std::accumulate(list.begin(), list.end(), typename TestFixture::value_type(0)));
+
+  Iter found = std::find_if(list.begin(), list.end(),
+			    [](const typename TestFixture::value_type& value) { return 1 < value; });
+  EXPECT_EQ(2, *found);
+
+  std::for_each(list.begin(), list.end(), [](typename TestFixture::value_type& value) { value *= 2; });
+  typename TestFixture::value_type doubled[] = { 2, 4, 6 };
+  verify<3>(doubled, list);
+
+  Iter iter = list.begin();
+  std::advance(iter, 2);
+  EXPECT_EQ(6, *iter);
+  Experiment::advance(iter, -1);
+  EXPECT_EQ(4, *iter);
+}
+
+TYPED_TEST_P(DoubleLinkedListTest, relink) {
+  typename TestFixture::List list;
+  list.push_back(0);
+  list.push_back(1);
+  list.push_back(2);
+  list.push_back(3);
+
+  typename TestFixture::Iterator second = list.begin() + 1;
+  typename TestFixture::Iterator end = list.end();
+
+  std::vector<typename TestFixture::List::unsafe_iterator> order;
+  for(typename TestFixture::List::unsafe_iterator iter = list.unsafeBegin(); list.unsafeEnd() != iter; ++iter) {
+    order.insert(order.begin(), iter);
+  }
+  list.relink(order.begin(), order.end());
+
+  typename TestFixture::value_type expected[] = { 3, 2, 1, 0 };
+  verify<4>(expected, list);
+
+  // Iterators keep their position rather than their element
+  EXPECT_EQ(2, *second);
+  EXPECT_EQ(list.begin() + 1, second);
+  EXPECT_EQ(list.end(), end);
+}
+
+TYPED_TEST_P(DoubleLinkedListTest, append) {
+  typename TestFixture::List list;
+  list.push_back(0);
+  typename TestFixture::Iterator end = list.end();
+
+  typename TestFixture::value_type values[] = { 1, 2, 3 };
+  list.append(values, values + 3);
+  list.append(values, values);
+  list.push_back(4);
+
+  typename TestFixture::value_type expected[] = { 0, 1, 2, 3, 4 };
+  verify<5>(expected, list);
+  EXPECT_EQ(list.end(), end);
+
+  // Appended nodes are removed like any other
+  typename TestFixture::Iterator second = list.begin() + 1;
+  second.moveBefore(end);
+  typename TestFixture::value_type movedExpected[] = { 0, 2, 3, 4, 1 };
+  verify<5>(movedExpected, list);
+  list.clear();
+  EXPECT_TRUE(list.isEmpty());
+}
+
+TYPED_TEST_P(DoubleLinkedListTest, rangeConstructor) {
+  typename TestFixture::value_type values[] = { 0, 1, 2 };
+  typename TestFixture::List list(values, values + 3);
+  verify<3>(values, list);
+
+  std::vector<typename TestFixture::value_type> none;
+  typename TestFixture::List empty(none.begin(), none.end());
+  EXPECT_TRUE(empty.isEmpty());
+}
+
+TYPED_TEST_P(DoubleLinkedListTest, assign) {
+  typename TestFixture::List list;
+  list.push_back(5);
+  typename TestFixture::Iterator first = list.begin();
+
+  typename TestFixture::value_type values[] = { 0, 1, 2 };
+  list.assign(values, values + 3);
+  verify<3>(values, list);
+  EXPECT_EQ(list.end(), first);
+
+  list.assign(values, values);
+  EXPECT_TRUE(list.isEmpty());
+}
+
+TYPED_TEST_P(DoubleLinkedListTest, appendParallel) {
+  // Several chunks and a partial chunk
+  std::vector<typename TestFixture::value_type> values(300000);
+  for(size_t index = 0; index < values.size(); ++index) {
+    values[index] = static_cast<typename TestFixture::value_type>(index % 1000);
+  }
+
+  const unsigned int threads[] = { 0, 1, 2, 3, 8 };
+  for(const unsigned int threadCount : threads) {
+    typename TestFixture::List list;
+    list.push_back(-1);
+    list.appendParallel(values.begin(), values.end(), threadCount);
+    list.push_back(-2);
+
+    typename TestFixture::List::const_iterator listIter = list.cbegin();
+    EXPECT_EQ(-1, *listIter++);
+    size_t index = 0;
+    for( ; values.size() != index && list.cend() != listIter; ++index, ++listIter) {
+      ASSERT_EQ(values[index], *listIter) << "threads " << threadCount << " index " << index;
+    }
+    EXPECT_EQ(values.size(), index);
+    EXPECT_EQ(-2, *listIter++);
+    EXPECT_EQ(list.cend(), listIter);
+
+    // Walking back reaches the start, so the chunks are linked both ways
+    typename TestFixture::Iterator back = list.end();
+    size_t count = 0;
+    for( ; list.begin() != back; --back) {
+      ++count;
+    }
+    EXPECT_EQ(values.size() + 2, count);
+  }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(DoubleLinkedListTest,
   empty,
   one,
@@ -608,7 +831,16 @@ REGISTER_TYPED_TEST_SUITE_P(DoubleLinkedListTest,
   moveInList,
   moveOutOfList,
 
-  nestedList
+  nestedList,
+
+  constIterTraits,
+  unsafeIterMove,
+  iterTraits,
+  relink,
+  append,
+  rangeConstructor,
+  assign,
+  appendParallel
 );
 
 typedef testing::Types<
@@ -620,3 +852,96 @@ INSTANTIATE_TYPED_TEST_SUITE_P(
   MainDoubleLinkedListTest,
   DoubleLinkedListTest,
   DoubleLinkedListTestTypes);
+
+/** A value whose copy throws for a chosen value, to test failed bulk appends */
+struct ThrowingCopy {
+  /** Create with value \param theValue the value */
+  ThrowingCopy(int theValue)
+    : value(theValue)
+  {
+  }
+
+  /** Copy rhs, throwing std::runtime_error if its value is FAIL \param rhs to copy */
+  ThrowingCopy(const ThrowingCopy& rhs)
+    : value(rhs.value)
+  {
+    if(FAIL == value) {
+      throw std::runtime_error("copy of FAIL");
+    }
+  }
+
+  /** The value whose copy throws */
+  static const int FAIL = -1;
+
+  /** The value */
+  int value;
+};
+
+TEST(DoubleLinkedListBulkTest, appendParallelFailure) {
+  std::vector<ThrowingCopy> values;
+  for(int i = 0; i < 300000; ++i) {
+    values.push_back(ThrowingCopy(i));
+  }
+  const size_t failAt = 200000;
+  values[failAt].value = ThrowingCopy::FAIL;
+
+  DoubleLinkedList<ThrowingCopy> list;
+  EXPECT_THROW(list.appendParallel(values.begin(), values.end(), 4), std::runtime_error);
+
+  // The values before the failure are appended
+  size_t count = 0;
+  for(DoubleLinkedList<ThrowingCopy>::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter, ++count) {
+    ASSERT_EQ(static_cast<int>(count), iter->value);
+  }
+  EXPECT_EQ(failAt, count);
+}
+
+TEST(DoubleLinkedListBulkTest, rangeConstructorFailure) {
+  std::vector<ThrowingCopy> values;
+  values.push_back(ThrowingCopy(0));
+  values.push_back(ThrowingCopy(1));
+  values[1].value = ThrowingCopy::FAIL;
+
+  typedef DoubleLinkedList<ThrowingCopy> List;
+  EXPECT_THROW(List list(values.begin(), values.end()), std::runtime_error);
+}
+
+TEST(DoubleLinkedListBulkTest, appendOnce) {
+  // Values which can be read only once are appended one by one
+  std::istringstream text("3 1 2");
+  DoubleLinkedList<int> list;
+  list.append(std::istream_iterator<int>(text), std::istream_iterator<int>());
+
+  const std::vector<int> expected = { 3, 1, 2 };
+  EXPECT_EQ(expected, std::vector<int>(list.cbegin(), list.cend()));
+}
+
+#if defined(__linux__)
+#include <unistd.h>
+
+/** \return the resident bytes of this process, or 0 if unknown */
+static size_t residentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  size_t pages = 0;
+  size_t resident = 0;
+  statm >> pages >> resident;
+  return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+TEST(DoubleLinkedListBulkTest, shortRangesTakeNoChunk) {
+  // Each of these would hold a 2 MiB chunk if short ranges were chunked
+  const int values[] = { 0, 1, 2 };
+  const DoubleLinkedList<int> original(values, values + 3);
+  const size_t before = residentBytes();
+  std::vector<std::unique_ptr<DoubleLinkedList<int> > > lists;
+  for(int i = 0; i < 200; ++i) {
+    lists.push_back(std::unique_ptr<DoubleLinkedList<int> >(new DoubleLinkedList<int>(values, values + 3)));
+    lists.push_back(std::unique_ptr<DoubleLinkedList<int> >(new DoubleLinkedList<int>(original)));
+  }
+  EXPECT_GT(before + (64 << 20), residentBytes());
+
+  for(std::vector<std::unique_ptr<DoubleLinkedList<int> > >::const_iterator iter = lists.begin(); lists.end() != iter; ++iter) {
+    EXPECT_EQ(std::vector<int>(values, values + 3), std::vector<int>((*iter)->cbegin(), (*iter)->cend()));
+  }
+}
+#endif // defined(__linux__)
@@ -0,0 +1,143 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for FixedSizeSort sorting networks.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FixedSizeSort.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::FixedSizeSort;
+using Experiment::FixedSizeSortUpTo;
+
+/** \return the values 3, 1, 2, 0 sorted by FixedSizeSort<4>, as digits in
+ * that order, evaluated at compile time
+ */
+constexpr int sortedDigits() {
+  int data[4] = { 3, 1, 2, 0 };
+  FixedSizeSort<4>::sort(data);
+  return ((data[0] * 10 + data[1]) * 10 + data[2]) * 10 + data[3];
+}
+
+static_assert(123 == sortedDigits(), "FixedSizeSort sorts in constexpr functions");
+
+/** Verify FixedSizeSort<N> sorts every sequence of N zeros and ones, and so
+ * by the 0-1 principle sorts every sequence of N values.
+ *
+ * \tparam N the number of values
+ */
+template<size_t N>
+void verifyAllZeroOne() {
+  for(unsigned long bits = 0; bits < (1ul << N); ++bits) {
+    int data[N];
+    int ones = 0;
+    for(size_t index = 0; index < N; ++index) {
+      data[index] = (bits >> index) & 1;
+      ones += data[index];
+    }
+    FixedSizeSort<N>::sort(data);
+    for(size_t index = 0; index < N; ++index) {
+      ASSERT_EQ(index < N - ones ? 0 : 1, data[index]) << "N " << N << " bits " << bits;
+    }
+  }
+}
+
+/** Verify FixedSizeSort<N> sorts pseudo-random permutations of N values.
+ *
+ * \tparam N the number of values
+ */
+template<size_t N>
+void verifyPermutations() {
+  std::vector<int> expected;
+  for(size_t index = 0; index < N; ++index) {
+    expected.push_back(static_cast<int>(index));
+  }
+  unsigned int seed = 5;
+  for(int permutation = 0; permutation < 1000; ++permutation) {
+    std::vector<int> data(expected);
+    for(size_t index = N - 1; 0 < index; --index) {
+      seed = seed * 1103515245 + 12345;
+      std::swap(data[index], data[(seed >> 8) % (index + 1)]);
+    }
+    FixedSizeSort<N>::sort(data.begin());
+    ASSERT_EQ(expected, data) << "N " << N;
+  }
+}
+
+TEST(FixedSizeSortTest, sortsAllZeroOne) {
+  verifyAllZeroOne<1>();
+  verifyAllZeroOne<2>();
+  verifyAllZeroOne<3>();
+  verifyAllZeroOne<4>();
+  verifyAllZeroOne<5>();
+  verifyAllZeroOne<6>();
+  verifyAllZeroOne<7>();
+  verifyAllZeroOne<8>();
+  verifyAllZeroOne<11>();
+  verifyAllZeroOne<16>();
+}
+
+TEST(FixedSizeSortTest, sortsPermutations) {
+  verifyPermutations<17>();
+  verifyPermutations<24>();
+  verifyPermutations<31>();
+  verifyPermutations<32>();
+}
+
+TEST(FixedSizeSortTest, networkSizes) {
+  EXPECT_EQ(0u, FixedSizeSort<1>::NETWORK.size);
+  EXPECT_EQ(5u, FixedSizeSort<4>::NETWORK.size);
+  EXPECT_EQ(19u, FixedSizeSort<8>::NETWORK.size);
+  EXPECT_EQ(63u, FixedSizeSort<16>::NETWORK.size);
+  EXPECT_EQ(191u, FixedSizeSort<32>::NETWORK.size);
+}
+
+TEST(FixedSizeSortTest, compare) {
+  float data[] = { 0.5f, -2.0f, 8.0f, 1.0f, -0.25f };
+  FixedSizeSort<5>::sort(data, std::greater<float>());
+  const std::vector<float> expected = { 8.0f, 1.0f, 0.5f, -0.25f, -2.0f };
+  EXPECT_EQ(expected, std::vector<float>(data, data + 5));
+}
+
+TEST(FixedSizeSortTest, strings) {
+  std::vector<std::string> data = { "delta", "alpha", "echo", "charlie", "bravo", "alpha" };
+  FixedSizeSort<6>::sort(data.begin());
+  const std::vector<std::string> expected = { "alpha", "alpha", "bravo", "charlie", "delta", "echo" };
+  EXPECT_EQ(expected, data);
+}
+
+TEST(FixedSizeSortTest, upTo) {
+  for(size_t length = 0; length < 20; ++length) {
+    std::vector<int> data;
+    for(size_t index = 0; index < length; ++index) {
+      data.push_back(static_cast<int>((index * 7) % length));
+    }
+    std::vector<int> expected(data);
+    std::sort(expected.begin(), expected.end());
+
+    const bool sorted = FixedSizeSortUpTo<17>::sort(data.begin(), length, std::less<int>());
+    EXPECT_EQ(length < 17, sorted) << "length " << length;
+    if(sorted) {
+      EXPECT_EQ(expected, data) << "length " << length;
+    }
+  }
+}
@@ -0,0 +1,162 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "IncrementalListSort.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::IncrementalListSort;
+
+/** \return length pseudo-random values below limit
+ *
+ * \param length of the values
+ * \param limit above the values
+ */
+static std::vector<int> incrementalValues(size_t length, int limit) {
+  std::vector<int> values;
+  unsigned int seed = 7;
+  for(size_t i = 0; i < length; ++i) {
+    seed = seed * 1103515245 + 12345;
+    values.push_back(static_cast<int>((seed >> 8) % limit));
+  }
+  return values;
+}
+
+/** \return the values of list, in order \param list to return the values of */
+static std::vector<int> listValues(const DoubleLinkedList<int>& list) {
+  return std::vector<int>(list.cbegin(), list.cend());
+}
+
+/** Sort values in a list by steps of budget, checking the list holds all
+ * values between steps, and that it ends sorted
+ *
+ * \param values to sort
+ * \param budget of each step
+ */
+static void verifySteps(const std::vector<int>& values, size_t budget) {
+  DoubleLinkedList<int> list;
+  list.append(values.begin(), values.end());
+  std::vector<int> expected(values);
+  std::sort(expected.begin(), expected.end());
+
+  IncrementalListSort<int> sort(list);
+  size_t steps = 0;
+  while(!sort.step(budget)) {
+    ++steps;
+    std::vector<int> between = listValues(list);
+    std::sort(between.begin(), between.end());
+    ASSERT_EQ(expected, between);
+  }
+  EXPECT_TRUE(sort.isDone());
+  EXPECT_EQ(expected, listValues(list));
+  EXPECT_TRUE(sort.step(budget));
+}
+
+TEST(IncrementalListSortTest, steps) {
+  const std::vector<int> values = incrementalValues(1000, 1000);
+  verifySteps(values, 1);
+  verifySteps(values, 7);
+  verifySteps(values, 1000);
+  verifySteps(values, SIZE_MAX);
+}
+
+TEST(IncrementalListSortTest, shapes) {
+  verifySteps(std::vector<int>(), 3);
+  verifySteps(std::vector<int>(1, 5), 3);
+  verifySteps(incrementalValues(513, 4), 3);
+
+  std::vector<int> sorted = incrementalValues(500, 1000);
+  std::sort(sorted.begin(), sorted.end());
+  verifySteps(sorted, 3);
+  std::reverse(sorted.begin(), sorted.end());
+  verifySteps(sorted, 3);
+}
+
+TEST(IncrementalListSortTest, alreadySortedIsTwoPasses) {
+  DoubleLinkedList<int> list;
+  for(int value = 0; value < 100; ++value) {
+    list.push_back(value);
+  }
+  // Counted and collected, with nothing to merge or place
+  IncrementalListSort<int> sort(list);
+  EXPECT_TRUE(sort.step(200));
+}
+
+TEST(IncrementalListSortTest, stable) {
+  typedef std::pair<int, int> Keyed;
+  DoubleLinkedList<Keyed> list;
+  const std::vector<int> keys = incrementalValues(300, 5);
+  for(size_t i = 0; i < keys.size(); ++i) {
+    list.push_back(Keyed(keys[i], static_cast<int>(i)));
+  }
+
+  auto byKey = [](const Keyed& a, const Keyed& b) { return a.first < b.first; };
+  IncrementalListSort<Keyed, decltype(byKey)> sort(list, byKey);
+  while(!sort.step(11)) {
+  }
+
+  const std::vector<Keyed> sorted(list.cbegin(), list.cend());
+  ASSERT_EQ(keys.size(), sorted.size());
+  for(size_t i = 1; i < sorted.size(); ++i) {
+    EXPECT_TRUE(sorted[i - 1].first < sorted[i].first
+		|| (sorted[i - 1].first == sorted[i].first && sorted[i - 1].second < sorted[i].second));
+  }
+}
+
+TEST(IncrementalListSortTest, lessor) {
+  const std::vector<int> values = incrementalValues(200, 100);
+  DoubleLinkedList<int> list;
+  list.append(values.begin(), values.end());
+  IncrementalListSort<int, std::greater<int> > sort(list);
+  sort.finish();
+
+  std::vector<int> expected(values);
+  std::sort(expected.begin(), expected.end(), std::greater<int>());
+  EXPECT_EQ(expected, listValues(list));
+}
+
+TEST(IncrementalListSortTest, stepFor) {
+  const std::vector<int> values = incrementalValues(100000, 1000000);
+  DoubleLinkedList<int> list;
+  list.append(values.begin(), values.end());
+  IncrementalListSort<int> sort(list);
+  while(!sort.stepFor(std::chrono::microseconds(500))) {
+  }
+
+  std::vector<int> expected(values);
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(expected, listValues(list));
+}
+
+TEST(IncrementalListSortTest, iteratorsStayWithValues) {
+  DoubleLinkedList<int> list;
+  for(int value = 9; 0 <= value; --value) {
+    list.push_back(value);
+  }
+  DoubleLinkedList<int>::iterator atNine = list.begin();
+  IncrementalListSort<int> sort(list);
+  sort.finish();
+
+  EXPECT_EQ(9, *atNine);
+  ++atNine;
+  EXPECT_TRUE(list.end() == atNine);
+}
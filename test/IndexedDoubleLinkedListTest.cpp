@@ -0,0 +1,442 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for IndexedDoubleLinkedList
+ */
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "IndexedDoubleLinkedList.h"
+#include "ListMergeSort.h"
+#include "PositionIndex.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::IndexedDoubleLinkedList;
+using Experiment::ListMergeSort;
+using Experiment::NoPositionIndex;
+using Experiment::PositionIndex;
+
+/** Verify that the ordered data in data matches the data in list, walking
+ * forward and backward.
+ *
+ * Failures are noted by EXPECT_* macros
+ *
+ * \param data to compare items to list
+ * \param list to compare to items in data
+ *
+ * \tparam length number of values in data
+ * \tparam T type of Data in data and the List
+ */
+template<size_t length, class T>
+void verifyIndexed(T (&data)[length], const IndexedDoubleLinkedList<T>& list) {
+  typedef typename IndexedDoubleLinkedList<T>::const_iterator Iterator;
+
+  EXPECT_EQ(0 == length, list.isEmpty());
+  EXPECT_EQ(length, list.size());
+
+  Iterator listIter = list.begin();
+  size_t count = 0;
+  for( ; count < length && list.end() != listIter; ++listIter, ++count) {
+    EXPECT_EQ(data[count], *listIter);
+  }
+  EXPECT_EQ(list.end(), listIter);
+  EXPECT_EQ(length, count);
+
+  while(0 < count && list.begin() != listIter) {
+    --listIter;
+    --count;
+    EXPECT_EQ(data[count], *listIter);
+  }
+  EXPECT_EQ(list.begin(), listIter);
+  EXPECT_EQ(0U, count);
+}
+
+/** IndexedDoubleLinkedList test fixture.
+ *
+ * \tparam T the type of Data being tested
+ */
+template<class T>
+class IndexedDoubleLinkedListTest : public testing::Test {
+protected:
+  typedef T value_type;
+
+  /** Convenience typedef of the type of the IndexedDoubleLinkedList */
+  typedef IndexedDoubleLinkedList<value_type> List;
+
+  /** Convenience typedef of iterator of List */
+  typedef typename List::iterator Iterator;
+
+  /** Setup list with the values 0 to count - 1 in order
+   *
+   * \param count of values to add
+   */
+  void setup(int count) {
+    for(int i = 0; i < count; ++i) {
+      list.push_back(i);
+    }
+  }
+
+  /** \return an iterator at position of list
+   *
+   * \param position of the iterator
+   */
+  Iterator at(int position) {
+    Iterator iter = list.begin();
+    for(int i = 0; i < position; ++i) {
+      ++iter;
+    }
+    return iter;
+  }
+
+  /** The list under test */
+  List list;
+};
+TYPED_TEST_SUITE_P(IndexedDoubleLinkedListTest);
+
+TYPED_TEST_P(IndexedDoubleLinkedListTest, empty) {
+  EXPECT_TRUE(this->list.isEmpty());
+  EXPECT_EQ(this->list.begin(), this->list.end());
+  EXPECT_EQ(0U, this->list.size());
+}
+
+TYPED_TEST_P(IndexedDoubleLinkedListTest, push) {
+  this->list.push_back(1);
+  this->list.push_front(0);
+  this->list.push_back(2);
+
+  typename TestFixture::value_type expected[] = { 0, 1, 2 };
+  verifyIndexed(expected, this->list);
+}
+
+TYPED_TEST_P(IndexedDoubleLinkedListTest, moveBefore) {
+  this->setup(4);
+
+  this->list.moveBefore(this->at(3), this->list.begin());
+  typename TestFixture::value_type first[] = { 3, 0, 1, 2 };
+  verifyIndexed(first, this->list);
+
+  this->list.moveBefore(this->list.begin(), this->list.end());
+  typename TestFixture::value_type last[] = { 0, 1, 2, 3 };
+  verifyIndexed(last, this->list);
+
+  this->list.moveBefore(this->at(1), this->at(3));
+  typename TestFixture::value_type middle[] = { 0, 2, 1, 3 };
+  verifyIndexed(middle, this->list);
+
+  // No-op moves
+  this->list.moveBefore(this->at(1), this->at(1));
+  this->list.moveBefore(this->at(1), this->at(2));
+  verifyIndexed(middle, this->list);
+}
+
+TYPED_TEST_P(IndexedDoubleLinkedListTest, swapWith) {
+  this->setup(4);
+
+  // Iterators stay with their values
+  typename TestFixture::Iterator first = this->at(0);
+  typename TestFixture::Iterator last = this->at(3);
+  this->list.swapWith(first, last);
+  EXPECT_EQ(0, *first);
+  EXPECT_EQ(this->at(3), first);
+  typename TestFixture::value_type ends[] = { 3, 1, 2, 0 };
+  verifyIndexed(ends, this->list);
+
+  this->list.swapWith(this->at(1), this->at(2));
+  typename TestFixture::value_type adjacent[] = { 3, 2, 1, 0 };
+  verifyIndexed(adjacent, this->list);
+
+  this->list.swapWith(this->at(3), this->at(2));
+  typename TestFixture::value_type adjacentReversed[] = { 3, 2, 0, 1 };
+  verifyIndexed(adjacentReversed, this->list);
+
+  this->list.swapWith(this->at(2), this->at(0));
+  typename TestFixture::value_type disjoint[] = { 0, 2, 3, 1 };
+  verifyIndexed(disjoint, this->list);
+
+  this->list.swapWith(this->at(1), this->at(1));
+  verifyIndexed(disjoint, this->list);
+}
+
+TYPED_TEST_P(IndexedDoubleLinkedListTest, relink) {
+  this->setup(4);
+
+  std::vector<typename TestFixture::Iterator> order;
+  order.push_back(this->at(2));
+  order.push_back(this->at(0));
+  order.push_back(this->at(3));
+  order.push_back(this->at(1));
+  this->list.relink(order.begin(), order.end());
+
+  typename TestFixture::value_type expected[] = { 2, 0, 3, 1 };
+  verifyIndexed(expected, this->list);
+}
+
+TYPED_TEST_P(IndexedDoubleLinkedListTest, compact) {
+  this->setup(4);
+  this->list.moveBefore(this->at(3), this->list.begin());
+  this->list.swapWith(this->at(1), this->at(2));
+  this->list.compact();
+
+  typename TestFixture::value_type expected[] = { 3, 1, 0, 2 };
+  verifyIndexed(expected, this->list);
+
+  // Storage is now in list order
+  typename TestFixture::Iterator iter = this->list.begin();
+  for(uint32_t index = 0; this->list.end() != iter; ++iter, ++index) {
+    EXPECT_EQ(index, iter.getIndex());
+  }
+}
+
+TYPED_TEST_P(IndexedDoubleLinkedListTest, erase) {
+  this->setup(4);
+
+  typename TestFixture::Iterator next = this->at(2);
+  typename TestFixture::Iterator last = this->at(3);
+  EXPECT_EQ(next, this->list.erase(this->at(1)));
+  EXPECT_EQ(this->list.end(), this->list.erase(last));
+  typename TestFixture::value_type erased[] = { 0, 2 };
+  verifyIndexed(erased, this->list);
+
+  // Erased nodes are reused
+  this->list.push_front(5);
+  this->list.push_back(6);
+  this->list.push_back(7);
+  EXPECT_GT(4U, this->list.begin().getIndex());
+  typename TestFixture::value_type reused[] = { 5, 0, 2, 6, 7 };
+  verifyIndexed(reused, this->list);
+
+  this->list.compact();
+  verifyIndexed(reused, this->list);
+
+  this->list.erase(this->list.begin());
+  this->list.erase(this->list.begin());
+  this->list.erase(this->list.begin());
+  this->list.erase(this->list.begin());
+  this->list.erase(this->list.begin());
+  EXPECT_TRUE(this->list.isEmpty());
+  EXPECT_EQ(0U, this->list.size());
+}
+
+TYPED_TEST_P(IndexedDoubleLinkedListTest, clear) {
+  this->setup(3);
+  this->list.clear();
+
+  EXPECT_TRUE(this->list.isEmpty());
+  EXPECT_EQ(this->list.begin(), this->list.end());
+
+  this->list.push_front(1);
+  typename TestFixture::value_type expected[] = { 1 };
+  verifyIndexed(expected, this->list);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(IndexedDoubleLinkedListTest,
+  empty,
+  push,
+  moveBefore,
+  swapWith,
+  relink,
+  compact,
+  erase,
+  clear
+);
+
+typedef testing::Types<
+  int,
+  float
+> IndexedDoubleLinkedListTestTypes;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(
+  MainIndexedDoubleLinkedListTest,
+  IndexedDoubleLinkedListTest,
+  IndexedDoubleLinkedListTestTypes);
+
+/** Test fixture of finding positions of an IndexedDoubleLinkedList, with
+ * each position policy.
+ *
+ * \tparam Positions the position policy of the list
+ */
+template<class Positions>
+class IndexedPositionTest : public testing::Test {
+protected:
+  /** Convenience typedef of the type of the IndexedDoubleLinkedList */
+  typedef IndexedDoubleLinkedList<int, Positions> List;
+
+  /** Convenience typedef of iterator of List */
+  typedef typename List::iterator Iterator;
+
+  /** Setup list with the values 0 to count - 1 in order
+   *
+   * \param count of values to add
+   */
+  void setup(int count) {
+    for(int i = 0; i < count; ++i) {
+      list.push_back(i);
+    }
+  }
+
+  /** Verify every position of list finds the value of expected at that
+   * position, and every value is at its position.
+   *
+   * \param expected the values of list in order
+   */
+  void verifyPositions(const std::vector<int>& expected) {
+    ASSERT_EQ(expected.size(), list.size());
+    size_t position = 0;
+    for(Iterator iter = list.begin(); list.end() != iter; ++iter, ++position) {
+      ASSERT_EQ(expected[position], *list.at(position));
+      ASSERT_EQ(position, list.positionOf(iter));
+    }
+    EXPECT_EQ(list.end(), list.at(expected.size()));
+    EXPECT_EQ(expected.size(), list.positionOf(list.end()));
+  }
+
+  /** The list under test */
+  List list;
+};
+TYPED_TEST_SUITE_P(IndexedPositionTest);
+
+TYPED_TEST_P(IndexedPositionTest, empty) {
+  EXPECT_EQ(this->list.end(), this->list.at(0));
+  EXPECT_EQ(0U, this->list.positionOf(this->list.begin()));
+  EXPECT_THROW(this->list.at(1), std::out_of_range);
+  EXPECT_THROW(this->list.begin() + 1, std::out_of_range);
+}
+
+TYPED_TEST_P(IndexedPositionTest, at) {
+  this->setup(10);
+  for(int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, *this->list.at(i));
+  }
+  EXPECT_EQ(this->list.end(), this->list.at(10));
+  EXPECT_THROW(this->list.at(11), std::out_of_range);
+
+  const typename TestFixture::List& constList = this->list;
+  EXPECT_EQ(7, *constList.at(7));
+}
+
+TYPED_TEST_P(IndexedPositionTest, advance) {
+  this->setup(10);
+
+  typename TestFixture::Iterator iter = this->list.begin() + 4;
+  EXPECT_EQ(4, *iter);
+  iter += 3;
+  EXPECT_EQ(7, *iter);
+  iter -= 6;
+  EXPECT_EQ(1, *iter);
+  EXPECT_EQ(9, *(iter + 8));
+  EXPECT_EQ(this->list.end(), iter + 9);
+  EXPECT_EQ(9, *(this->list.end() - 1));
+  EXPECT_EQ(0, *(this->list.end() - 10));
+
+  Experiment::advance(iter, 2);
+  EXPECT_EQ(3, *iter);
+
+  EXPECT_THROW(iter + 8, std::out_of_range);
+  EXPECT_THROW(iter - 4, std::out_of_range);
+  EXPECT_THROW(this->list.end() + 1, std::out_of_range);
+  EXPECT_EQ(3, *iter);
+}
+
+TYPED_TEST_P(IndexedPositionTest, changes) {
+  this->setup(6);
+
+  this->list.moveBefore(this->list.at(5), this->list.begin());
+  this->verifyPositions({ 5, 0, 1, 2, 3, 4 });
+
+  this->list.swapWith(this->list.at(1), this->list.at(4));
+  this->verifyPositions({ 5, 3, 1, 2, 0, 4 });
+
+  this->list.erase(this->list.at(2));
+  this->verifyPositions({ 5, 3, 2, 0, 4 });
+
+  this->list.push_front(7);
+  this->verifyPositions({ 7, 5, 3, 2, 0, 4 });
+
+  ListMergeSort<int, typename TestFixture::Iterator> sort;
+  sort.sort(this->list);
+  this->verifyPositions({ 0, 2, 3, 4, 5, 7 });
+
+  this->list.compact();
+  this->verifyPositions({ 0, 2, 3, 4, 5, 7 });
+
+  this->list.clear();
+  this->verifyPositions({});
+  this->list.push_back(1);
+  this->verifyPositions({ 1 });
+}
+
+TYPED_TEST_P(IndexedPositionTest, random) {
+  std::mt19937 random(7);
+  std::vector<int> expected;
+  for(int i = 0; i < 2000; ++i) {
+    const size_t position = random() % (expected.size() + 1);
+    switch(random() % 6) {
+    case 0:
+      this->list.push_front(i);
+      expected.insert(expected.begin(), i);
+      break;
+    case 1:
+      this->list.push_back(i);
+      expected.push_back(i);
+      break;
+    case 2:
+      if(position < expected.size()) {
+	this->list.erase(this->list.at(position));
+	expected.erase(expected.begin() + position);
+      }
+      break;
+    default:
+      if(position < expected.size()) {
+	// Move to another position, before the value now there
+	const size_t before = random() % (expected.size() + 1);
+	const int value = expected[position];
+	expected.insert(expected.begin() + before, value);
+	expected.erase(expected.begin() + (before <= position ? position + 1 : position));
+	this->list.moveBefore(this->list.at(position), this->list.at(before));
+      }
+      break;
+    }
+  }
+  this->verifyPositions(expected);
+
+  // Advancing from each position finds the same values as at()
+  for(size_t position = 0; position < expected.size(); position += 37) {
+    const size_t to = random() % (expected.size() + 1);
+    typename TestFixture::Iterator iter = this->list.at(position);
+    iter += static_cast<std::ptrdiff_t>(to) - static_cast<std::ptrdiff_t>(position);
+    EXPECT_EQ(this->list.at(to), iter);
+  }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(IndexedPositionTest,
+  empty,
+  at,
+  advance,
+  changes,
+  random
+);
+
+typedef testing::Types<
+  NoPositionIndex,
+  PositionIndex
+> IndexedPositionTestTypes;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(
+  MainIndexedPositionTest,
+  IndexedPositionTest,
+  IndexedPositionTestTypes);
@@ -0,0 +1,161 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for ListKeySort specific to sorting records by a key.
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "DoubleLinkedList.h"
+#include "ListKeySort.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::ListKeySort;
+
+/** A record sorted by one of its fields */
+struct Record {
+  /** Create a Record
+   *
+   * \param theId identifying the record, to check stability
+   * \param theCount numeric field to sort by
+   * \param theName string field to sort by
+   * \param theWeight floating point field to sort by
+   */
+  Record(int theId, int theCount, const std::string& theName, double theWeight)
+    : id(theId), count(theCount), name(theName), weight(theWeight)
+  {
+  }
+
+  /** Identifies the record, to check stability */
+  int id;
+
+  /** Numeric field to sort by */
+  int count;
+
+  /** String field to sort by */
+  std::string name;
+
+  /** Floating point field to sort by */
+  double weight;
+
+  /** Unsorted payload making this a wide record */
+  char padding[200];
+};
+
+/** Key extractor of Record::count */
+struct CountKey {
+  /** \return the key of record \param record to return the key of */
+  int operator()(const Record& record) const {
+    return record.count;
+  }
+};
+
+/** Key extractor of Record::name */
+struct NameKey {
+  /** \return the key of record \param record to return the key of */
+  const std::string& operator()(const Record& record) const {
+    return record.name;
+  }
+};
+
+/** Key extractor of Record::weight */
+struct WeightKey {
+  /** \return the key of record \param record to return the key of */
+  double operator()(const Record& record) const {
+    return record.weight;
+  }
+};
+
+/** ListKeySort test fixture providing records to sort */
+class ListKeySortTest : public testing::Test {
+protected:
+  /** Setup records with duplicate keys in each field */
+  ListKeySortTest() {
+    records.push_back(Record(0, 3, "delta", 2.5));
+    records.push_back(Record(1, -7, "alpha", -1.0));
+    records.push_back(Record(2, 3, "charlie", 0.0));
+    records.push_back(Record(3, 1000000, "alpha", -1e300));
+    records.push_back(Record(4, -7, "bravo", 2.5));
+    records.push_back(Record(5, 0, "delta", -0.5));
+  }
+
+  /** Verify the ids of the records in order
+   *
+   * \param ids expected in order
+   *
+   * \tparam length of ids
+   */
+  template<size_t length>
+  void verifyIds(const int (&ids)[length]) {
+    size_t index = 0;
+    for(DoubleLinkedList<Record>::const_iterator iter = records.cbegin(); records.cend() != iter; ++iter, ++index) {
+      ASSERT_GT(length, index);
+      EXPECT_EQ(ids[index], iter->id);
+    }
+    EXPECT_EQ(length, index);
+  }
+
+  /** Records to sort */
+  DoubleLinkedList<Record> records;
+};
+
+TEST_F(ListKeySortTest, sortByInteger) {
+  ListKeySort<Record, CountKey> sort;
+  sort.sort(records);
+
+  const int expected[] = { 1, 4, 5, 0, 2, 3 };
+  verifyIds(expected);
+}
+
+TEST_F(ListKeySortTest, sortByString) {
+  ListKeySort<Record, NameKey> sort;
+  sort.sort(records);
+
+  const int expected[] = { 1, 3, 4, 2, 0, 5 };
+  verifyIds(expected);
+}
+
+TEST_F(ListKeySortTest, sortByFloatingPoint) {
+  ListKeySort<Record, WeightKey> sort;
+  sort.sort(records);
+
+  const int expected[] = { 3, 1, 5, 2, 0, 4 };
+  verifyIds(expected);
+}
+
+TEST_F(ListKeySortTest, negativeZeroEqualsZero) {
+  // -0.0 after 0.0 stays after it, as std::less holds them equal
+  records.push_back(Record(6, 0, "echo", -0.0));
+  ListKeySort<Record, WeightKey> sort;
+  sort.sort(records);
+
+  const int expected[] = { 3, 1, 5, 2, 6, 0, 4 };
+  verifyIds(expected);
+}
+
+TEST_F(ListKeySortTest, iteratorsKeepPositions) {
+  DoubleLinkedList<Record>::iterator first = records.begin();
+  DoubleLinkedList<Record>::iterator third = records.begin() + 2;
+  DoubleLinkedList<Record>::iterator end = records.end();
+
+  ListKeySort<Record, CountKey> sort;
+  sort.sort(records);
+
+  EXPECT_EQ(1, first->id);
+  EXPECT_EQ(5, third->id);
+  EXPECT_EQ(records.end(), end);
+}
@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for ListParallel and the parallel algorithms over DoubleLinkedList
+ */
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListParallel.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::ListParallel;
+
+/** \return a list of the values 0 to length - 1
+ *
+ * \param length of the list
+ */
+static DoubleLinkedList<long> countingList(size_t length) {
+  DoubleLinkedList<long> list;
+  for(size_t value = 0; value < length; ++value) {
+    list.push_back(static_cast<long>(value));
+  }
+  return list;
+}
+
+TEST(ListParallelTest, segments) {
+  DoubleLinkedList<long> empty;
+  EXPECT_EQ(0u, ListParallel<long>(empty, 4).segments());
+
+  DoubleLinkedList<long> one = countingList(1);
+  EXPECT_EQ(1u, ListParallel<long>(one, 4).segments());
+
+  // Between the number wanted and twice it, for lists long enough
+  DoubleLinkedList<long> list = countingList(100000);
+  ListParallel<long> parallel(list, 4);
+  EXPECT_LE(4 * ListParallel<long>::SEGMENTS_PER_THREAD, parallel.segments());
+  EXPECT_GT(8 * ListParallel<long>::SEGMENTS_PER_THREAD, parallel.segments());
+}
+
+TEST(ListParallelTest, forEach) {
+  DoubleLinkedList<long> list = countingList(10000);
+  std::atomic<long> sum(0);
+  std::atomic<size_t> count(0);
+  Experiment::parallelForEach(list, [&sum, &count](long& value) {
+      sum += value;
+      ++count;
+    }, 3);
+  EXPECT_EQ(10000u, count.load());
+  EXPECT_EQ(10000L * 9999L / 2, sum.load());
+}
+
+TEST(ListParallelTest, transformInPlace) {
+  for(size_t length = 0; length < 70; ++length) {
+    DoubleLinkedList<long> list = countingList(length);
+    Experiment::parallelTransformInPlace(list, [](const long& value) { return 3 * value; }, 4);
+
+    long expected = 0;
+    for(DoubleLinkedList<long>::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter, expected += 3) {
+      EXPECT_EQ(expected, *iter);
+    }
+    EXPECT_EQ(3 * static_cast<long>(length), expected);
+  }
+}
+
+TEST(ListParallelTest, reduce) {
+  DoubleLinkedList<long> list = countingList(12345);
+  const long sum = Experiment::parallelReduce(list, 0L, [](const long& value) { return value; }, std::plus<long>(), 4);
+  EXPECT_EQ(12345L * 12344L / 2, sum);
+
+  DoubleLinkedList<long> empty;
+  EXPECT_EQ(7L, Experiment::parallelReduce(empty, 7L, [](const long& value) { return value; }, std::plus<long>()));
+}
+
+TEST(ListParallelTest, reduceCombinesInOrder) {
+  DoubleLinkedList<long> list = countingList(1000);
+  const std::string digits = Experiment::parallelReduce(list, std::string(), [](const long& value) {
+      return std::string(1, static_cast<char>('0' + value % 10));
+    }, std::plus<std::string>(), 4);
+
+  std::string expected;
+  for(int value = 0; value < 1000; ++value) {
+    expected += static_cast<char>('0' + value % 10);
+  }
+  EXPECT_EQ(expected, digits);
+}
+
+TEST(ListParallelTest, reduceBools) {
+  // Each segment's bool is written by its own thread, beside its neighbours'
+  DoubleLinkedList<long> list = countingList(10000);
+  ListParallel<long> parallel(list, 4);
+  for(long target = 0; target < 10000; target += 97) {
+    EXPECT_TRUE(parallel.reduce(false, [target](const long& value) { return target == value; },
+				std::logical_or<bool>()));
+  }
+  EXPECT_FALSE(parallel.reduce(false, [](const long& value) { return value < 0; }, std::logical_or<bool>()));
+  EXPECT_TRUE(parallel.reduce(true, [](const long& value) { return 0 <= value; }, std::logical_and<bool>()));
+}
+
+TEST(ListParallelTest, reuseAndResegment) {
+  DoubleLinkedList<long> list = countingList(1000);
+  ListParallel<long> parallel(list, 2);
+  parallel.transformInPlace([](const long& value) { return value + 1; });
+  parallel.transformInPlace([](const long& value) { return value * 2; });
+  EXPECT_EQ(1000L * 1001L, parallel.reduce(0L, [](const long& value) { return value; }, std::plus<long>()));
+
+  list.push_back(-1000L * 1001L);
+  parallel.resegment();
+  EXPECT_EQ(0L, parallel.reduce(0L, [](const long& value) { return value; }, std::plus<long>()));
+}
+
+TEST(ListParallelTest, exception) {
+  DoubleLinkedList<long> list = countingList(1000);
+  std::atomic<size_t> count(0);
+  EXPECT_THROW(Experiment::parallelForEach(list, [&count](long& value) {
+	if(500 == value) {
+	  throw std::runtime_error("500");
+	}
+	++count;
+      }, 4), std::runtime_error);
+
+  // Only the rest of the failing segment is skipped
+  EXPECT_LT(900u, count.load());
+}
@@ -0,0 +1,146 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for ListQuickSort specific to its comparison counts on few
+ * distinct values and on poor pivots.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListQuickSort.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::ListQuickSort;
+
+/** Metrics counting the comparisons of a sort
+ *
+ * \tparam T type of data being sorted
+ */
+template<class T>
+class CountingMetrics {
+public:
+  /** Create with no comparisons counted */
+  CountingMetrics()
+    : comparisons(0)
+  {
+  }
+
+  /** a and b are compared */
+  void compare(const T& a, const T& b) {
+    ++comparisons;
+  }
+
+  /** Two items were swapped */
+  void swap() { }
+
+  /** The sort completed */
+  void done() { }
+
+  /** Metrics should be reset due to starting a new sort */
+  void reset() {
+    comparisons = 0;
+  }
+
+  /** The comparisons since reset() */
+  size_t comparisons;
+};
+
+/** Convenience typedef of the sort under test, counting comparisons */
+typedef ListQuickSort<int, int*, std::less<int>, CountingMetrics<int> > CountingSort;
+
+/** Verify list holds the values of expected, in order
+ *
+ * \param expected the values list should hold
+ * \param list to compare to expected
+ */
+void verifySorted(const std::vector<int>& expected, const DoubleLinkedList<int>& list) {
+  std::vector<int>::const_iterator expectedIter = expected.begin();
+  DoubleLinkedList<int>::const_iterator listIter = list.cbegin();
+  for( ; expected.end() != expectedIter && list.cend() != listIter; ++expectedIter, ++listIter) {
+    EXPECT_EQ(*expectedIter, *listIter);
+  }
+  EXPECT_EQ(expected.end(), expectedIter);
+  EXPECT_EQ(list.cend(), listIter);
+}
+
+TEST(ListQuickSortTest, fewUniqueIsLinear) {
+  const size_t length = 100000;
+  const int distinct = 4;
+  std::vector<int> expected;
+  DoubleLinkedList<int> list;
+  unsigned int seed = 3;
+  for(size_t index = 0; index < length; ++index) {
+    seed = seed * 1103515245 + 12345;
+    const int value = static_cast<int>((seed >> 16) % distinct);
+    expected.push_back(value);
+    list.push_back(value);
+  }
+  std::sort(expected.begin(), expected.end());
+
+  CountingSort sort;
+  sort.sort(list);
+  verifySorted(expected, list);
+
+  // At most two comparisons per value per distinct value, plus pivot samples
+  EXPECT_GT(2 * (distinct + 1) * length, sort.metrics.comparisons);
+}
+
+TEST(ListQuickSortTest, allEqualIsOnePass) {
+  const size_t length = 100000;
+  std::vector<int> data(length, 5);
+
+  CountingSort sort;
+  sort.sort(data.data(), data.data() + length);
+  EXPECT_EQ(std::vector<int>(length, 5), data);
+  EXPECT_GE(2 * length + 3, sort.metrics.comparisons);
+}
+
+TEST(ListQuickSortTest, poorPivotsFallBack) {
+  // Organ pipe of distinct values gives median-of-three unbalanced pivots
+  const size_t logLength = 16;
+  const size_t length = 1 << logLength;
+  std::vector<int> data;
+  for(size_t index = 0; index < length; ++index) {
+    data.push_back(static_cast<int>(index < length / 2 ? 2 * index : 2 * (length - index) - 1));
+  }
+  std::vector<int> expected(data);
+  std::sort(expected.begin(), expected.end());
+
+  CountingSort sort;
+  sort.sort(data.data(), data.data() + length);
+  EXPECT_EQ(expected, data);
+
+  // O(n log n), far below the n * n / 4 of quadratic partitioning
+  EXPECT_GT(8 * length * logLength, sort.metrics.comparisons);
+}
+
+TEST(ListQuickSortTest, iteratorsKeepPositions) {
+  DoubleLinkedList<int> list;
+  list.push_back(2);
+  list.push_back(0);
+  list.push_back(1);
+  DoubleLinkedList<int>::iterator first = list.begin();
+
+  ListQuickSort<int> sort;
+  sort.sort(list);
+
+  std::vector<int> expected = { 0, 1, 2 };
+  verifySorted(expected, list);
+  EXPECT_EQ(0, *first);
+}
@@ -0,0 +1,161 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListReclaimer.h"
+#include "ListStats.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::CountingListStats;
+using Experiment::DoubleLinkedList;
+using Experiment::ListReclaimer;
+
+/** Value counting its live instances, to see them reclaimed */
+class Reclaimed {
+public:
+  /** Create, counting it \param theValue held */
+  explicit Reclaimed(int theValue = 0)
+    : value(theValue)
+  {
+    ++live;
+  }
+
+  /** Copy, counting it \param rhs to copy */
+  Reclaimed(const Reclaimed& rhs)
+    : value(rhs.value)
+  {
+    ++live;
+  }
+
+  /** Destroy, no longer counting it */
+  ~Reclaimed() {
+    --live;
+  }
+
+  /** The value held */
+  int value;
+
+  /** The number of instances alive */
+  static std::atomic<long> live;
+};
+
+std::atomic<long> Reclaimed::live(0);
+
+/** \return a list of length values from 0 \param length of the list */
+static DoubleLinkedList<Reclaimed> reclaimedList(size_t length) {
+  DoubleLinkedList<Reclaimed> list;
+  for(size_t value = 0; value < length; ++value) {
+    list.push_back(Reclaimed(static_cast<int>(value)));
+  }
+  return list;
+}
+
+TEST(ListReclaimerTest, background) {
+  const long before = Reclaimed::live;
+  DoubleLinkedList<Reclaimed> first = reclaimedList(10000);
+  DoubleLinkedList<Reclaimed> second = reclaimedList(100);
+  {
+    ListReclaimer reclaimer;
+    reclaimer.reclaim(first);
+    reclaimer.reclaim(second);
+    EXPECT_TRUE(first.isEmpty());
+    EXPECT_TRUE(second.isEmpty());
+
+    reclaimer.drain();
+    EXPECT_TRUE(reclaimer.isIdle());
+    EXPECT_EQ(before, Reclaimed::live);
+  }
+
+  // Lists are still usable
+  first.push_back(Reclaimed(7));
+  EXPECT_EQ(7, first.begin()->value);
+}
+
+TEST(ListReclaimerTest, reclaimSome) {
+  const long before = Reclaimed::live;
+  DoubleLinkedList<Reclaimed> list = reclaimedList(1000);
+  ListReclaimer reclaimer(false);
+  reclaimer.reclaim(list);
+  EXPECT_EQ(before + 1000, Reclaimed::live);
+  EXPECT_FALSE(reclaimer.isIdle());
+
+  EXPECT_EQ(300u, reclaimer.reclaimSome(300));
+  EXPECT_EQ(before + 700, Reclaimed::live);
+  EXPECT_EQ(700u, reclaimer.reclaimSome(1000));
+  EXPECT_EQ(0u, reclaimer.reclaimSome(1000));
+  EXPECT_EQ(before, Reclaimed::live);
+  EXPECT_TRUE(reclaimer.isIdle());
+}
+
+TEST(ListReclaimerTest, destructionFreesAll) {
+  const long before = Reclaimed::live;
+  DoubleLinkedList<Reclaimed> list = reclaimedList(5000);
+  {
+    ListReclaimer reclaimer(false);
+    reclaimer.reclaim(list);
+    reclaimer.reclaimSome(10);
+  }
+  EXPECT_EQ(before, Reclaimed::live);
+}
+
+TEST(ListReclaimerTest, empty) {
+  DoubleLinkedList<int> list;
+  ListReclaimer reclaimer(false);
+  reclaimer.reclaim(list);
+  EXPECT_TRUE(list.isEmpty());
+  EXPECT_EQ(0u, reclaimer.reclaimSome(10));
+}
+
+TEST(ListReclaimerTest, iteratorsMoveToEnd) {
+  DoubleLinkedList<int> list;
+  const std::vector<int> values(100, 1);
+  list.append(values.begin(), values.end());
+  DoubleLinkedList<int>::iterator atValue = list.begin();
+  ++atValue;
+  DoubleLinkedList<int>::iterator atEnd = list.end();
+  DoubleLinkedList<int>::iterator beforeBegin = list.begin();
+  --beforeBegin;
+
+  ListReclaimer reclaimer;
+  reclaimer.reclaim(list);
+  EXPECT_TRUE(list.end() == atValue);
+  EXPECT_TRUE(list.end() == atEnd);
+
+  // Iterators still follow changes
+  list.push_back(3);
+  ++beforeBegin;
+  EXPECT_EQ(3, *beforeBegin);
+  reclaimer.drain();
+}
+
+TEST(ListReclaimerTest, stats) {
+  DoubleLinkedList<std::string, CountingListStats> list;
+  list.push_back("a");
+  list.push_back("b");
+  const size_t nodeBytes = list.stats().snapshot().liveBytes;
+  DoubleLinkedList<std::string, CountingListStats>::iterator iter = list.begin();
+  const size_t iteratorBytes = list.stats().snapshot().liveBytes - nodeBytes;
+
+  ListReclaimer reclaimer;
+  reclaimer.reclaim(list);
+  EXPECT_EQ(2u, list.stats().snapshot().nodesFreed);
+  EXPECT_EQ(0u, list.stats().snapshot().liveNodes());
+  EXPECT_EQ(1u, list.stats().snapshot().liveIterators());
+  EXPECT_EQ(iteratorBytes, list.stats().snapshot().liveBytes);
+}
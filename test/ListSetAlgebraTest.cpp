@@ -0,0 +1,290 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for ListSetAlgebra
+ */
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListSetAlgebra.h"
+#include "SmallDoubleLinkedList.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::HoldsInlineNodes;
+using Experiment::ListSetAlgebra;
+using Experiment::SmallDoubleLinkedList;
+
+/** \return the values of list, in order
+ *
+ * \param list to read
+ *
+ * \tparam T type of Data in list
+ */
+template<class T>
+std::vector<T> setAlgebraValues(const DoubleLinkedList<T>& list) {
+  return std::vector<T>(list.cbegin(), list.cend());
+}
+
+/** ListSetAlgebra test fixture, with two sorted multisets overlapping in
+ * part.
+ *
+ * \tparam T the type of Data being tested
+ */
+template<class T>
+class ListSetAlgebraTest : public testing::Test {
+protected:
+  typedef T value_type;
+
+  /** Convenience typedef of the type of list */
+  typedef DoubleLinkedList<value_type> List;
+
+  /** Convenience typedef of the set algebra under test */
+  typedef ListSetAlgebra<value_type> Algebra;
+
+  ListSetAlgebraTest()
+    : first({ 0, 1, 1, 1, 3, 5, 5, 8, 9 }),
+      second({ 1, 1, 2, 3, 3, 5, 7, 9, 9, 10 })
+  {
+  }
+
+  /** Values of the first list */
+  std::vector<value_type> first;
+
+  /** Values of the second list */
+  std::vector<value_type> second;
+};
+TYPED_TEST_SUITE_P(ListSetAlgebraTest);
+
+TYPED_TEST_P(ListSetAlgebraTest, setUnion) {
+  typename TestFixture::List a(this->first.begin(), this->first.end());
+  typename TestFixture::List b(this->second.begin(), this->second.end());
+  typename TestFixture::List out;
+  typename TestFixture::Algebra algebra;
+  algebra.setUnion(a, b, out);
+
+  std::vector<typename TestFixture::value_type> expected;
+  std::set_union(this->first.begin(), this->first.end(), this->second.begin(), this->second.end(), std::back_inserter(expected));
+  EXPECT_EQ(expected, setAlgebraValues(out));
+  EXPECT_TRUE(a.isEmpty());
+  EXPECT_TRUE(b.isEmpty());
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, setIntersection) {
+  typename TestFixture::List a(this->first.begin(), this->first.end());
+  typename TestFixture::List b(this->second.begin(), this->second.end());
+  typename TestFixture::List out;
+  typename TestFixture::Algebra algebra;
+  algebra.setIntersection(a, b, out);
+
+  std::vector<typename TestFixture::value_type> expected;
+  std::set_intersection(this->first.begin(), this->first.end(), this->second.begin(), this->second.end(), std::back_inserter(expected));
+  EXPECT_EQ(expected, setAlgebraValues(out));
+  EXPECT_TRUE(a.isEmpty());
+  EXPECT_TRUE(b.isEmpty());
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, setDifference) {
+  typename TestFixture::List a(this->first.begin(), this->first.end());
+  typename TestFixture::List b(this->second.begin(), this->second.end());
+  typename TestFixture::List out;
+  typename TestFixture::Algebra algebra;
+  algebra.setDifference(a, b, out);
+
+  std::vector<typename TestFixture::value_type> expected;
+  std::set_difference(this->first.begin(), this->first.end(), this->second.begin(), this->second.end(), std::back_inserter(expected));
+  EXPECT_EQ(expected, setAlgebraValues(out));
+  EXPECT_TRUE(a.isEmpty());
+  EXPECT_TRUE(b.isEmpty());
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, setSymmetricDifference) {
+  typename TestFixture::List a(this->first.begin(), this->first.end());
+  typename TestFixture::List b(this->second.begin(), this->second.end());
+  typename TestFixture::List out;
+  typename TestFixture::Algebra algebra;
+  algebra.setSymmetricDifference(a, b, out);
+
+  std::vector<typename TestFixture::value_type> expected;
+  std::set_symmetric_difference(this->first.begin(), this->first.end(), this->second.begin(), this->second.end(), std::back_inserter(expected));
+  EXPECT_EQ(expected, setAlgebraValues(out));
+  EXPECT_TRUE(a.isEmpty());
+  EXPECT_TRUE(b.isEmpty());
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, unique) {
+  typename TestFixture::List list(this->second.begin(), this->second.end());
+  typename TestFixture::Algebra algebra;
+  algebra.unique(list);
+
+  std::vector<typename TestFixture::value_type> expected(this->second);
+  expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+  EXPECT_EQ(expected, setAlgebraValues(list));
+
+  // Reached backward as well
+  typename TestFixture::List::const_iterator iter = list.cend();
+  EXPECT_EQ(expected.back(), *--iter);
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, relinksNodes) {
+  typename TestFixture::List a(this->first.begin(), this->first.end());
+  typename TestFixture::List b(this->second.begin(), this->second.end());
+  const typename TestFixture::value_type* firstValue = &*a.cbegin();
+  const typename TestFixture::value_type* lastValue = &*--b.cend();
+
+  typename TestFixture::List out;
+  typename TestFixture::Algebra algebra;
+  algebra.setUnion(a, b, out);
+
+  // The first and last values are the same objects, no longer in a or b
+  EXPECT_EQ(firstValue, &*out.cbegin());
+  EXPECT_EQ(lastValue, &*--out.cend());
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, appendsToOutput) {
+  typename TestFixture::List a(this->first.begin(), this->first.end());
+  typename TestFixture::List b(this->second.begin(), this->second.end());
+  typename TestFixture::List out;
+  out.push_back(-1);
+  typename TestFixture::List::iterator outFirst = out.begin();
+  typename TestFixture::List::iterator outEnd = out.end();
+  typename TestFixture::List::iterator aSecond = a.begin() + 1;
+
+  typename TestFixture::Algebra algebra;
+  algebra.setIntersection(a, b, out);
+
+  std::vector<typename TestFixture::value_type> expected = { -1, 1, 1, 3, 5, 9 };
+  EXPECT_EQ(expected, setAlgebraValues(out));
+  EXPECT_EQ(-1, *outFirst);
+  EXPECT_EQ(out.end(), outEnd);
+  EXPECT_EQ(a.end(), aSecond);
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, uniqueKeepsIteratorPositions) {
+  typename TestFixture::List list(this->first.begin(), this->first.end());
+  typename TestFixture::List::iterator second = list.begin() + 1;
+  typename TestFixture::List::iterator last = list.begin() + (this->first.size() - 1);
+
+  typename TestFixture::Algebra algebra;
+  algebra.unique(list);
+
+  // Positions past the remaining values are at the end
+  EXPECT_EQ(1, *second);
+  EXPECT_EQ(3, *(second + 1));
+  EXPECT_EQ(list.end(), last);
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, sameList) {
+  typename TestFixture::List a(this->first.begin(), this->first.end());
+  typename TestFixture::List out;
+  typename TestFixture::Algebra algebra;
+  EXPECT_THROW(algebra.setUnion(a, a, out), std::invalid_argument);
+  EXPECT_THROW(algebra.setDifference(a, out, a), std::invalid_argument);
+  EXPECT_EQ(this->first, setAlgebraValues(a));
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, lessor) {
+  std::vector<typename TestFixture::value_type> first(this->first.rbegin(), this->first.rend());
+  std::vector<typename TestFixture::value_type> second(this->second.rbegin(), this->second.rend());
+  typename TestFixture::List a(first.begin(), first.end());
+  typename TestFixture::List b(second.begin(), second.end());
+  typename TestFixture::List out;
+  ListSetAlgebra<typename TestFixture::value_type, std::greater<typename TestFixture::value_type> > algebra;
+  algebra.setSymmetricDifference(a, b, out);
+
+  std::vector<typename TestFixture::value_type> expected;
+  std::set_symmetric_difference(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(expected),
+				std::greater<typename TestFixture::value_type>());
+  EXPECT_EQ(expected, setAlgebraValues(out));
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, smallListInput) {
+  typename TestFixture::List out;
+  {
+    SmallDoubleLinkedList<typename TestFixture::value_type, 4> a;
+    for(const typename TestFixture::value_type& value : this->first) {
+      a.push_back(value);
+    }
+    typename TestFixture::List b(this->second.begin(), this->second.end());
+
+    typename TestFixture::Algebra algebra;
+    algebra.setUnion(a, b, out);
+    EXPECT_TRUE(a.isEmpty());
+
+    // Inline slots are free again
+    a.push_back(4);
+    EXPECT_EQ(std::vector<typename TestFixture::value_type>(1, 4), setAlgebraValues(a));
+  }
+
+  // The values inline in a were copied out before it was destroyed
+  std::vector<typename TestFixture::value_type> expected;
+  std::set_union(this->first.begin(), this->first.end(), this->second.begin(), this->second.end(), std::back_inserter(expected));
+  EXPECT_EQ(expected, setAlgebraValues(out));
+}
+
+TYPED_TEST_P(ListSetAlgebraTest, smallListSecondInput) {
+  typename TestFixture::List out;
+  {
+    typename TestFixture::List a(this->first.begin(), this->first.end());
+    SmallDoubleLinkedList<typename TestFixture::value_type, 4> b;
+    for(const typename TestFixture::value_type& value : this->second) {
+      b.push_back(value);
+    }
+
+    typename TestFixture::Algebra algebra;
+    algebra.setSymmetricDifference(a, b, out);
+    EXPECT_TRUE(b.isEmpty());
+  }
+
+  std::vector<typename TestFixture::value_type> expected;
+  std::set_symmetric_difference(this->first.begin(), this->first.end(), this->second.begin(), this->second.end(),
+				std::back_inserter(expected));
+  EXPECT_EQ(expected, setAlgebraValues(out));
+}
+
+REGISTER_TYPED_TEST_SUITE_P(ListSetAlgebraTest,
+  setUnion,
+  setIntersection,
+  setDifference,
+  setSymmetricDifference,
+  unique,
+  relinksNodes,
+  appendsToOutput,
+  uniqueKeepsIteratorPositions,
+  sameList,
+  lessor,
+  smallListInput,
+  smallListSecondInput
+);
+
+typedef testing::Types<
+  int,
+  float
+> ListSetAlgebraTestTypes;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(
+  MainListSetAlgebraTest,
+  ListSetAlgebraTest,
+  ListSetAlgebraTestTypes);
+
+TEST(ListSetAlgebraTest, holdsInlineNodes) {
+  EXPECT_FALSE(HoldsInlineNodes<DoubleLinkedList<int> >::value);
+  EXPECT_TRUE((HoldsInlineNodes<SmallDoubleLinkedList<int, 4> >::value));
+}
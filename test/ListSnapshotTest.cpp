@@ -0,0 +1,205 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for snapshots of DoubleLinkedList.
+ */
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "DoubleLinkedList.h"
+#include "ListSnapshot.h"
+#include "ListStats.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::CountingListStats;
+using Experiment::DoubleLinkedList;
+using Experiment::loadFrom;
+using Experiment::saveTo;
+
+/** Template test::Test providing a temporary file for snapshots
+ *
+ * \tparam T the data type of the list to save and load
+ */
+template<class T>
+class ListSnapshotTest : public testing::Test {
+protected:
+  /** Convenience typedef of the list saved and loaded */
+  typedef DoubleLinkedList<T> List;
+
+  /** Create a temporary file */
+  ListSnapshotTest() {
+    char name[] = "/tmp/ListSnapshotTest.XXXXXX";
+    const int fd = mkstemp(name);
+    if(0 <= fd) {
+      close(fd);
+    }
+    path = name;
+  }
+
+  /** Remove the temporary file */
+  ~ListSnapshotTest() {
+    unlink(path.c_str());
+  }
+
+  /** Verify list holds count values of 0 to count - 1 scaled by 1.5
+   *
+   * \param list to verify
+   * \param count of values expected
+   */
+  void verify(const List& list, size_t count) {
+    size_t index = 0;
+    for(typename List::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter, ++index) {
+      ASSERT_EQ(static_cast<T>(index * 1.5), *iter);
+    }
+    EXPECT_EQ(count, index);
+
+    // Backward links are valid too
+    typename List::const_iterator iter = list.cend();
+    for(size_t back = count; 0 < back; --back) {
+      --iter;
+      ASSERT_EQ(static_cast<T>((back - 1) * 1.5), *iter);
+    }
+  }
+
+  /** Path of the temporary file */
+  std::string path;
+};
+TYPED_TEST_SUITE_P(ListSnapshotTest);
+
+TYPED_TEST_P(ListSnapshotTest, empty) {
+  typename TestFixture::List saved;
+  saveTo(saved, this->path);
+
+  typename TestFixture::List loaded;
+  loaded.push_back(3);
+  loadFrom(loaded, this->path);
+  EXPECT_TRUE(loaded.isEmpty());
+}
+
+TYPED_TEST_P(ListSnapshotTest, roundTrip) {
+  // More than one batch and more than one chunk of nodes
+  const size_t count = 1500000;
+  typename TestFixture::List saved;
+  for(size_t index = 0; index < count; ++index) {
+    saved.push_back(static_cast<TypeParam>(index * 1.5));
+  }
+  saveTo(saved, this->path);
+
+  typename TestFixture::List loaded;
+  loaded.push_back(3);
+  loadFrom(loaded, this->path);
+  this->verify(loaded, count);
+
+  // Loaded nodes work as any other
+  loaded.push_back(7);
+  loaded.push_front(7);
+  loaded.clear();
+  EXPECT_TRUE(loaded.isEmpty());
+}
+
+TYPED_TEST_P(ListSnapshotTest, iteratorsKeepPositions) {
+  typename TestFixture::List saved;
+  saved.push_back(0);
+  saved.push_back(static_cast<TypeParam>(1.5));
+  saveTo(saved, this->path);
+
+  typename TestFixture::List loaded;
+  loadFrom(loaded, this->path);
+  typename TestFixture::List::iterator end = loaded.end();
+  loaded.append(saved.cbegin(), saved.cend());
+  EXPECT_EQ(loaded.end(), end);
+  EXPECT_EQ(4, std::distance(loaded.cbegin(), loaded.cend()));
+}
+
+TYPED_TEST_P(ListSnapshotTest, wrongType) {
+  DoubleLinkedList<double> saved;
+  saved.push_back(1.0);
+  saveTo(saved, this->path);
+
+  typename TestFixture::List loaded;
+  EXPECT_THROW(loadFrom(loaded, this->path), std::invalid_argument);
+}
+
+TYPED_TEST_P(ListSnapshotTest, notSnapshot) {
+  FILE* file = fopen(this->path.c_str(), "w");
+  ASSERT_NE(static_cast<FILE*>(NULL), file);
+  fputs("not a snapshot of anything", file);
+  fclose(file);
+
+  typename TestFixture::List loaded;
+  EXPECT_THROW(loadFrom(loaded, this->path), std::invalid_argument);
+}
+
+TYPED_TEST_P(ListSnapshotTest, truncated) {
+  typename TestFixture::List saved;
+  for(size_t index = 0; index < 10; ++index) {
+    saved.push_back(static_cast<TypeParam>(index * 1.5));
+  }
+  saveTo(saved, this->path);
+  ASSERT_EQ(0, truncate(this->path.c_str(), 30));
+
+  typename TestFixture::List loaded;
+  EXPECT_THROW(loadFrom(loaded, this->path), std::invalid_argument);
+}
+
+TYPED_TEST_P(ListSnapshotTest, countedList) {
+  typedef DoubleLinkedList<TypeParam, CountingListStats> CountedList;
+  CountedList saved;
+  for(size_t index = 0; index < 10; ++index) {
+    saved.push_back(static_cast<TypeParam>(index * 1.5));
+  }
+  saveTo(saved, this->path);
+
+  CountedList loaded;
+  loadFrom(loaded, this->path);
+  EXPECT_EQ(10u, loaded.stats().snapshot().nodesAllocated);
+  typename CountedList::const_iterator iter = loaded.cbegin();
+  for(size_t index = 0; index < 10; ++index, ++iter) {
+    ASSERT_EQ(static_cast<TypeParam>(index * 1.5), *iter);
+  }
+  EXPECT_TRUE(loaded.cend() == iter);
+}
+
+TYPED_TEST_P(ListSnapshotTest, missingFile) {
+  typename TestFixture::List loaded;
+  EXPECT_THROW(loadFrom(loaded, this->path + ".missing"), std::system_error);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(ListSnapshotTest,
+  empty,
+  roundTrip,
+  iteratorsKeepPositions,
+  wrongType,
+  notSnapshot,
+  truncated,
+  countedList,
+  missingFile
+);
+
+typedef testing::Types<
+  int,
+  float
+> ListSnapshotTestTypes;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(
+  MainListSnapshotTest,
+  ListSnapshotTest,
+  ListSnapshotTestTypes);
@@ -0,0 +1,285 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "IncrementalListSort.h"
+#include "ListKeySort.h"
+#include "ListMergeSort.h"
+#include "ListParallel.h"
+#include "ListQuickSort.h"
+#include "ListSetAlgebra.h"
+#include "ListStats.h"
+#include "Sort.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::CountingListStats;
+using Experiment::DoubleLinkedList;
+using Experiment::IdentityKey;
+using Experiment::IncrementalListSort;
+using Experiment::ListKeySort;
+using Experiment::ListMergeSort;
+using Experiment::ListQuickSort;
+using Experiment::ListSetAlgebra;
+using Experiment::ListStatsSnapshot;
+using Experiment::NoListStats;
+using Experiment::Sort;
+
+/** Convenience typedef of the counted list tested */
+typedef DoubleLinkedList<int, CountingListStats> CountedList;
+
+/** The members of a DoubleLinkedList, to show NoListStats adds nothing */
+struct UncountedListMembers {
+  Experiment::DoubleLinkedListImpl::Node<int> head;
+  Experiment::DoubleLinkedListImpl::Node<int> tail;
+  Experiment::DoubleLinkedListImpl::Node<DoubleLinkedList<int>::iterator*> iterHead;
+};
+
+TEST(ListStatsTest, noStatsCostsNoSpace) {
+  EXPECT_EQ(sizeof(UncountedListMembers), sizeof(DoubleLinkedList<int>));
+  EXPECT_EQ(sizeof(DoubleLinkedList<int>), sizeof(DoubleLinkedList<int, NoListStats>));
+}
+
+TEST(ListStatsTest, startsAtZero) {
+  CountedList list;
+  const ListStatsSnapshot counts = list.stats().snapshot();
+  EXPECT_EQ(0u, counts.nodesAllocated);
+  EXPECT_EQ(0u, counts.nodesFreed);
+  EXPECT_EQ(0u, counts.liveNodes());
+  EXPECT_EQ(0u, counts.liveIterators());
+  EXPECT_EQ(0u, counts.liveBytes);
+  EXPECT_EQ(0u, counts.peakBytes);
+}
+
+TEST(ListStatsTest, allocationsAndFrees) {
+  CountedList list;
+  list.push_back(1);
+  list.push_front(0);
+  const std::vector<int> values(1000, 2);
+  list.append(values.begin(), values.end());
+
+  ListStatsSnapshot counts = list.stats().snapshot();
+  EXPECT_EQ(1002u, counts.nodesAllocated);
+  EXPECT_EQ(1002u, counts.liveNodes());
+  EXPECT_LT(0u, counts.liveBytes);
+  EXPECT_EQ(counts.liveBytes, counts.peakBytes);
+  const size_t peakBytes = counts.peakBytes;
+
+  list.clear();
+  counts = list.stats().snapshot();
+  EXPECT_EQ(1002u, counts.nodesFreed);
+  EXPECT_EQ(0u, counts.liveNodes());
+  EXPECT_EQ(0u, counts.liveBytes);
+  EXPECT_EQ(peakBytes, counts.peakBytes);
+}
+
+TEST(ListStatsTest, appendParallel) {
+  CountedList list;
+  const std::vector<int> values(100000, 3);
+  list.appendParallel(values.begin(), values.end(), 4);
+  EXPECT_EQ(values.size(), list.stats().snapshot().liveNodes());
+}
+
+TEST(ListStatsTest, copiesStartAtZero) {
+  CountedList list;
+  list.push_back(1);
+  list.push_back(2);
+
+  const CountedList copy(list);
+  EXPECT_EQ(2u, copy.stats().snapshot().nodesAllocated);
+  EXPECT_EQ(2u, list.stats().snapshot().nodesAllocated);
+}
+
+TEST(ListStatsTest, iteratorsAndNotifications) {
+  CountedList list;
+  list.push_back(1);
+  list.push_back(2);
+  {
+    CountedList::iterator first = list.begin();
+    CountedList::iterator second = list.begin();
+    ++second;
+    EXPECT_EQ(2u, list.stats().snapshot().liveIterators());
+
+    // Inserting before both iterators calls back each for each node after
+    list.push_front(0);
+    ListStatsSnapshot counts = list.stats().snapshot();
+    EXPECT_EQ(1u, counts.insertNotifications);
+    EXPECT_EQ(4u, counts.iteratorCallbacks);
+
+    first.swapWith(second);
+    counts = list.stats().snapshot();
+    EXPECT_EQ(1u, counts.swapNotifications);
+    EXPECT_EQ(6u, counts.iteratorCallbacks);
+  }
+  const ListStatsSnapshot counts = list.stats().snapshot();
+  EXPECT_EQ(0u, counts.liveIterators());
+  EXPECT_LE(2u, counts.iteratorsAdded);
+  EXPECT_EQ(counts.iteratorsAdded, counts.iteratorsRemoved);
+}
+
+TEST(ListStatsTest, relinked) {
+  CountedList list;
+  for(int value = 0; value < 10; ++value) {
+    list.push_back(value);
+  }
+  std::vector<CountedList::unsafe_iterator> order;
+  for(CountedList::unsafe_iterator iter = list.unsafeBegin(); list.unsafeEnd() != iter; ++iter) {
+    order.insert(order.begin(), iter);
+  }
+  list.relink(order.begin(), order.end());
+
+  const ListStatsSnapshot counts = list.stats().snapshot();
+  EXPECT_EQ(1u, counts.relinks);
+  EXPECT_EQ(10u, counts.nodesRelinked);
+  EXPECT_EQ(9, *list.cbegin());
+}
+
+/** Fill list with the values 0 to count - 1, each twice, in descending order
+ *
+ * \param list to fill
+ * \param count of distinct values
+ */
+static void fillDescending(CountedList& list, int count) {
+  for(int value = count - 1; 0 <= value; --value) {
+    list.push_back(value);
+    list.push_back(value);
+  }
+}
+
+/** Verify list holds the values 0 to count - 1, each twice, in ascending order
+ *
+ * \param list to verify
+ * \param count of distinct values
+ */
+static void verifyAscending(const CountedList& list, int count) {
+  int index = 0;
+  for(CountedList::const_iterator iter = list.cbegin(); list.cend() != iter; ++iter, ++index) {
+    ASSERT_EQ(index / 2, *iter);
+  }
+  EXPECT_EQ(2 * count, index);
+}
+
+TEST(ListStatsTest, relinkingSortsCountRelinks) {
+  CountedList list;
+  fillDescending(list, 100);
+  Sort<int> sort;
+  sort.sort(list);
+  verifyAscending(list, 100);
+  EXPECT_EQ(1u, list.stats().snapshot().relinks);
+
+  list.clear();
+  fillDescending(list, 100);
+  list.stats().reset();
+  ListQuickSort<int> quickSort;
+  quickSort.sort(list);
+  verifyAscending(list, 100);
+  EXPECT_EQ(1u, list.stats().snapshot().relinks);
+  EXPECT_EQ(200u, list.stats().snapshot().nodesRelinked);
+
+  list.clear();
+  fillDescending(list, 100);
+  list.stats().reset();
+  ListKeySort<int, IdentityKey<int> > keySort;
+  keySort.sort(list);
+  verifyAscending(list, 100);
+  EXPECT_EQ(1u, list.stats().snapshot().relinks);
+}
+
+TEST(ListStatsTest, otherEnginesTakeCountedLists) {
+  CountedList list;
+  fillDescending(list, 100);
+  ListMergeSort<int> mergeSort;
+  mergeSort.sort(list);
+  verifyAscending(list, 100);
+
+  list.clear();
+  fillDescending(list, 100);
+  IncrementalListSort<int, std::less<int>, Experiment::NoSortMetrics<int>, CountingListStats> incremental(list);
+  while(!incremental.step(16)) {
+  }
+  verifyAscending(list, 100);
+
+  EXPECT_EQ(9900, Experiment::parallelReduce(list, 0, [](int value) { return value; },
+					     [](int a, int b) { return a + b; }, 2));
+
+  ListSetAlgebra<int> algebra;
+  algebra.unique(list);
+  EXPECT_EQ(100, std::distance(list.cbegin(), list.cend()));
+  CountedList other;
+  other.push_back(100);
+  CountedList out;
+  algebra.setUnion(list, other, out);
+  EXPECT_EQ(101, std::distance(out.cbegin(), out.cend()));
+}
+
+TEST(ListStatsTest, setAlgebraCountsNodes) {
+  ListSetAlgebra<int> algebra;
+  CountedList list;
+  const int values[] = { 1, 1, 2, 2, 3 };
+  list.append(values, values + 5);
+  const size_t bytesPerNode = list.stats().snapshot().liveBytes / 5;
+  algebra.unique(list);
+  ListStatsSnapshot counts = list.stats().snapshot();
+  EXPECT_EQ(2u, counts.nodesFreed);
+  EXPECT_EQ(3u, counts.liveNodes());
+  EXPECT_EQ(3 * bytesPerNode, counts.liveBytes);
+
+  CountedList other;
+  other.push_back(2);
+  other.push_back(3);
+  other.push_back(4);
+  CountedList out;
+  algebra.setIntersection(list, other, out);
+  EXPECT_EQ(0u, list.stats().snapshot().liveNodes());
+  EXPECT_EQ(0u, list.stats().snapshot().liveBytes);
+  EXPECT_EQ(0u, other.stats().snapshot().liveNodes());
+  EXPECT_EQ(0u, other.stats().snapshot().liveBytes);
+  counts = out.stats().snapshot();
+  EXPECT_EQ(2u, counts.nodesAllocated);
+  EXPECT_EQ(2u, counts.liveNodes());
+  EXPECT_EQ(2 * bytesPerNode, counts.liveBytes);
+
+  out.clear();
+  EXPECT_EQ(0u, out.stats().snapshot().liveNodes());
+  EXPECT_EQ(0u, out.stats().snapshot().liveBytes);
+}
+
+TEST(ListStatsTest, reset) {
+  CountedList list;
+  list.push_back(1);
+  list.push_back(2);
+  list.clear();
+  list.push_back(3);
+  const size_t liveBytes = list.stats().snapshot().liveBytes;
+
+  list.stats().reset();
+  const ListStatsSnapshot counts = list.stats().snapshot();
+  EXPECT_EQ(0u, counts.nodesAllocated);
+  EXPECT_EQ(0u, counts.nodesFreed);
+  EXPECT_EQ(liveBytes, counts.liveBytes);
+  EXPECT_EQ(liveBytes, counts.peakBytes);
+}
+
+TEST(ListStatsTest, exports) {
+  CountedList list;
+  list.push_back(1);
+
+  std::ostringstream out;
+  out << list.stats().snapshot();
+  EXPECT_NE(std::string::npos, out.str().find("nodesAllocated=1 "));
+  EXPECT_NE(std::string::npos, out.str().find(" peakBytes="));
+}
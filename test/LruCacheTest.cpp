@@ -0,0 +1,224 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for LruCache.
+ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "LruCache.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::ByteWeigher;
+using Experiment::LruCache;
+
+/** Cache of int by int used by most tests */
+typedef LruCache<int, int> IntCache;
+
+/** \return the keys of cache from most to least recently used \param cache to list */
+template<class Cache>
+std::vector<typename Cache::key_type> keysOf(const Cache& cache) {
+  std::vector<typename Cache::key_type> keys;
+  for(typename Cache::const_iterator iter = cache.begin(); cache.end() != iter; ++iter) {
+    keys.push_back(iter->first);
+  }
+  return keys;
+}
+
+/** Counts live instances to check LruCache destroys what it creates */
+struct Counted {
+  /** Create one more instance \param theValue held */
+  Counted(int theValue = 0)
+    : value(theValue)
+  {
+    ++live;
+  }
+
+  /** Copy one more instance \param rhs to copy */
+  Counted(const Counted& rhs)
+    : value(rhs.value)
+  {
+    ++live;
+  }
+
+  /** Destroy one instance */
+  ~Counted() {
+    --live;
+  }
+
+  /** Value held */
+  int value;
+
+  /** Number of live instances */
+  static int live;
+};
+
+int Counted::live = 0;
+
+TEST(LruCacheTest, empty) {
+  IntCache cache(3);
+  EXPECT_TRUE(cache.isEmpty());
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(3u, cache.capacity());
+  EXPECT_EQ(NULL, cache.get(1));
+  EXPECT_EQ(NULL, cache.peek(1));
+  EXPECT_FALSE(cache.erase(1));
+  EXPECT_EQ(cache.end(), cache.begin());
+}
+
+TEST(LruCacheTest, putGet) {
+  IntCache cache(3);
+  EXPECT_TRUE(cache.put(1, 10));
+  EXPECT_TRUE(cache.put(2, 20));
+
+  ASSERT_NE(static_cast<int*>(NULL), cache.get(1));
+  EXPECT_EQ(10, *cache.get(1));
+  EXPECT_EQ(20, *cache.get(2));
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(NULL, cache.get(3));
+
+  // Values may be changed in place
+  *cache.get(1) = 11;
+  EXPECT_EQ(11, *cache.peek(1));
+}
+
+TEST(LruCacheTest, recencyOrder) {
+  IntCache cache(3);
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.put(3, 30);
+  EXPECT_EQ(std::vector<int>({ 3, 2, 1 }), keysOf(cache));
+
+  cache.get(1);
+  EXPECT_EQ(std::vector<int>({ 1, 3, 2 }), keysOf(cache));
+
+  // peek does not change recency
+  cache.peek(2);
+  EXPECT_EQ(std::vector<int>({ 1, 3, 2 }), keysOf(cache));
+}
+
+TEST(LruCacheTest, evictLeastRecentlyUsed) {
+  IntCache cache(3);
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.put(3, 30);
+  cache.get(1);
+  cache.put(4, 40);
+
+  EXPECT_EQ(3u, cache.size());
+  EXPECT_EQ(NULL, cache.peek(2));
+  EXPECT_EQ(std::vector<int>({ 4, 1, 3 }), keysOf(cache));
+}
+
+TEST(LruCacheTest, replace) {
+  IntCache cache(2);
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.put(1, 11);
+
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(11, *cache.peek(1));
+  EXPECT_EQ(std::vector<int>({ 1, 2 }), keysOf(cache));
+}
+
+TEST(LruCacheTest, erase) {
+  IntCache cache(3);
+  cache.put(1, 10);
+  cache.put(2, 20);
+
+  EXPECT_TRUE(cache.erase(1));
+  EXPECT_FALSE(cache.erase(1));
+  EXPECT_EQ(NULL, cache.peek(1));
+  EXPECT_EQ(std::vector<int>({ 2 }), keysOf(cache));
+}
+
+TEST(LruCacheTest, clear) {
+  IntCache cache(3);
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.clear();
+
+  EXPECT_TRUE(cache.isEmpty());
+  EXPECT_EQ(0u, cache.weight());
+  EXPECT_EQ(NULL, cache.peek(1));
+  cache.put(3, 30);
+  EXPECT_EQ(30, *cache.peek(3));
+}
+
+TEST(LruCacheTest, manyKeysRehash) {
+  IntCache cache(1000);
+  for(int key = 0; key < 5000; ++key) {
+    cache.put(key, key * 10);
+  }
+
+  EXPECT_EQ(1000u, cache.size());
+  for(int key = 0; key < 4000; ++key) {
+    EXPECT_EQ(NULL, cache.peek(key));
+  }
+  for(int key = 4000; key < 5000; ++key) {
+    ASSERT_NE(static_cast<const int*>(NULL), cache.peek(key));
+    EXPECT_EQ(key * 10, *cache.peek(key));
+  }
+}
+
+/** Weigher of strings by length */
+struct LengthWeigher {
+  /** \return the length of value */
+  size_t operator()(int, const std::string& value) const {
+    return value.size();
+  }
+};
+
+TEST(LruCacheTest, weighedCapacity) {
+  LruCache<int, std::string, std::hash<int>, LengthWeigher> cache(10);
+  cache.put(1, "aaaa");
+  cache.put(2, "bbbb");
+  EXPECT_EQ(8u, cache.weight());
+
+  // Evicts both older entries to fit
+  cache.put(3, "cccccccc");
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(8u, cache.weight());
+  EXPECT_EQ("cccccccc", *cache.peek(3));
+
+  // Too heavy to cache at all, and replaces nothing
+  EXPECT_FALSE(cache.put(4, "ddddddddddd"));
+  EXPECT_EQ(NULL, cache.peek(4));
+  EXPECT_EQ(1u, cache.size());
+}
+
+TEST(LruCacheTest, byteWeigher) {
+  LruCache<int, double, std::hash<int>, ByteWeigher<int, double> > cache(3 * (sizeof(int) + sizeof(double)));
+  for(int key = 0; key < 10; ++key) {
+    cache.put(key, key);
+  }
+  EXPECT_EQ(3u, cache.size());
+}
+
+TEST(LruCacheTest, destroysEntries) {
+  {
+    LruCache<int, Counted> cache(2);
+    cache.put(1, Counted(1));
+    cache.put(2, Counted(2));
+    cache.put(3, Counted(3));
+    cache.put(3, Counted(4));
+    cache.erase(2);
+    EXPECT_EQ(1, Counted::live);
+    EXPECT_EQ(4, cache.peek(3)->value);
+  }
+  EXPECT_EQ(0, Counted::live);
+}
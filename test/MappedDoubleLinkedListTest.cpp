@@ -0,0 +1,386 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for MappedDoubleLinkedList
+ */
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "MappedDoubleLinkedList.h"
+
+#include "SortHelp.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::MappedDoubleLinkedList;
+
+/** Verify that the ordered data in data matches the data in list, walking
+ * forward and backward.
+ *
+ * Failures are noted by EXPECT_* macros
+ *
+ * \param data to compare items to list
+ * \param list to compare to items in data
+ *
+ * \tparam length number of values in data
+ * \tparam T type of Data in data and the List
+ */
+template<size_t length, class T>
+void verifyMapped(T (&data)[length], const MappedDoubleLinkedList<T>& list) {
+  typedef typename MappedDoubleLinkedList<T>::const_iterator Iterator;
+
+  EXPECT_EQ(0 == length, list.isEmpty());
+  EXPECT_EQ(length, list.size());
+
+  Iterator listIter = list.begin();
+  size_t count = 0;
+  for( ; count < length && list.end() != listIter; ++listIter, ++count) {
+    EXPECT_EQ(data[count], *listIter);
+  }
+  EXPECT_EQ(list.end(), listIter);
+  EXPECT_EQ(length, count);
+
+  while(0 < count && list.begin() != listIter) {
+    --listIter;
+    --count;
+    EXPECT_EQ(data[count], *listIter);
+  }
+  EXPECT_EQ(list.begin(), listIter);
+  EXPECT_EQ(0U, count);
+}
+
+/** MappedDoubleLinkedList test fixture.
+ *
+ * \tparam T the type of Data being tested
+ */
+template<class T>
+class MappedDoubleLinkedListTest : public testing::Test {
+protected:
+  typedef T value_type;
+
+  /** Convenience typedef of the type of the MappedDoubleLinkedList */
+  typedef MappedDoubleLinkedList<value_type> List;
+
+  /** Convenience typedef of iterator of List */
+  typedef typename List::iterator Iterator;
+
+  /** Open list on file */
+  MappedDoubleLinkedListTest()
+    : list(new List(file.path))
+  {
+  }
+
+  /** Close list and open the file again */
+  void reopen() {
+    list.reset();
+    list.reset(new List(file.path));
+  }
+
+  /** Setup list with the values 0 to count - 1 in order
+   *
+   * \param count of values to add
+   */
+  void setup(int count) {
+    for(int i = 0; i < count; ++i) {
+      list->push_back(i);
+    }
+  }
+
+  /** \return an iterator at position of list
+   *
+   * \param position of the iterator
+   */
+  Iterator at(int position) {
+    Iterator iter = list->begin();
+    for(int i = 0; i < position; ++i) {
+      ++iter;
+    }
+    return iter;
+  }
+
+  /** The file holding list */
+  TemporaryListFile file;
+
+  /** The list under test */
+  std::unique_ptr<List> list;
+};
+TYPED_TEST_SUITE_P(MappedDoubleLinkedListTest);
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, empty) {
+  EXPECT_TRUE(this->list->isEmpty());
+  EXPECT_EQ(this->list->begin(), this->list->end());
+  EXPECT_EQ(0U, this->list->size());
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, push) {
+  this->list->push_back(1);
+  this->list->push_front(0);
+  this->list->push_back(2);
+
+  typename TestFixture::value_type expected[] = { 0, 1, 2 };
+  verifyMapped(expected, *this->list);
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, persist) {
+  this->setup(3);
+  this->list->moveBefore(this->at(2), this->list->begin());
+  this->list->sync();
+  this->reopen();
+
+  typename TestFixture::value_type expected[] = { 2, 0, 1 };
+  verifyMapped(expected, *this->list);
+
+  this->list->push_back(3);
+  this->reopen();
+  typename TestFixture::value_type added[] = { 2, 0, 1, 3 };
+  verifyMapped(added, *this->list);
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, erase) {
+  this->setup(4);
+
+  typename TestFixture::Iterator next = this->list->erase(this->at(1));
+  EXPECT_EQ(2, *next);
+  next = this->list->erase(this->at(2));
+  EXPECT_EQ(this->list->end(), next);
+  typename TestFixture::value_type erased[] = { 0, 2 };
+  verifyMapped(erased, *this->list);
+
+  // Removed nodes are reused, last removed first
+  this->list->push_back(4);
+  EXPECT_EQ(3U, this->at(2).getIndex());
+  this->list->push_front(5);
+  EXPECT_EQ(1U, this->list->begin().getIndex());
+  this->list->push_back(6);
+  EXPECT_EQ(4U, this->at(4).getIndex());
+
+  this->reopen();
+  typename TestFixture::value_type reused[] = { 5, 0, 2, 4, 6 };
+  verifyMapped(reused, *this->list);
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, grow) {
+  const int count = 5000;
+  this->setup(count);
+  this->reopen();
+
+  EXPECT_EQ(static_cast<size_t>(count), this->list->size());
+  int expected = 0;
+  for(typename TestFixture::Iterator iter = this->list->begin(); this->list->end() != iter; ++iter, ++expected) {
+    EXPECT_EQ(expected, *iter);
+  }
+  EXPECT_EQ(count, expected);
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, pushOwnValueWhenFull) {
+  // Fill the file, so the next push grows it and may move its mapping
+  const size_t capacity = 1024;
+  this->setup(static_cast<int>(capacity));
+  ASSERT_EQ(capacity, this->list->size());
+
+  this->list->push_back(*this->list->begin());
+  this->list->push_front(*--this->list->end());
+  EXPECT_EQ(capacity + 2, this->list->size());
+  EXPECT_EQ(0, *this->list->begin());
+  EXPECT_EQ(0, *--this->list->end());
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, moveBefore) {
+  this->setup(4);
+
+  this->list->moveBefore(this->at(3), this->list->begin());
+  typename TestFixture::value_type first[] = { 3, 0, 1, 2 };
+  verifyMapped(first, *this->list);
+
+  this->list->moveBefore(this->list->begin(), this->list->end());
+  typename TestFixture::value_type last[] = { 0, 1, 2, 3 };
+  verifyMapped(last, *this->list);
+
+  this->list->moveBefore(this->at(1), this->at(3));
+  typename TestFixture::value_type middle[] = { 0, 2, 1, 3 };
+  verifyMapped(middle, *this->list);
+
+  // No-op moves
+  this->list->moveBefore(this->at(1), this->at(1));
+  this->list->moveBefore(this->at(1), this->at(2));
+  verifyMapped(middle, *this->list);
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, swapWith) {
+  this->setup(4);
+
+  this->list->swapWith(this->at(0), this->at(3));
+  typename TestFixture::value_type ends[] = { 3, 1, 2, 0 };
+  verifyMapped(ends, *this->list);
+
+  this->list->swapWith(this->at(1), this->at(2));
+  typename TestFixture::value_type adjacent[] = { 3, 2, 1, 0 };
+  verifyMapped(adjacent, *this->list);
+
+  this->list->swapWith(this->at(3), this->at(2));
+  typename TestFixture::value_type adjacentReversed[] = { 3, 2, 0, 1 };
+  verifyMapped(adjacentReversed, *this->list);
+
+  this->list->swapWith(this->at(2), this->at(0));
+  typename TestFixture::value_type disjoint[] = { 0, 2, 3, 1 };
+  verifyMapped(disjoint, *this->list);
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, relink) {
+  this->setup(4);
+
+  std::vector<typename TestFixture::Iterator> order;
+  order.push_back(this->at(2));
+  order.push_back(this->at(0));
+  order.push_back(this->at(3));
+  order.push_back(this->at(1));
+  this->list->relink(order.begin(), order.end());
+  this->reopen();
+
+  typename TestFixture::value_type expected[] = { 2, 0, 3, 1 };
+  verifyMapped(expected, *this->list);
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, advance) {
+  this->setup(5);
+  typename TestFixture::Iterator iter = this->list->begin();
+
+  iter += 3;
+  EXPECT_EQ(this->at(3), iter);
+  EXPECT_EQ(3, *iter);
+  EXPECT_EQ(this->list->end(), iter + 2);
+  EXPECT_EQ(this->at(1), iter - 2);
+  iter -= 3;
+  EXPECT_EQ(this->list->begin(), iter);
+
+  typename TestFixture::Iterator fromEnd = this->list->end();
+  Experiment::advance(fromEnd, -1);
+  EXPECT_EQ(4, *fromEnd);
+
+  typename TestFixture::List::const_iterator constIter = this->list->cbegin() + 4;
+  EXPECT_EQ(4, *constIter);
+
+  EXPECT_THROW(this->list->begin() - 1, std::out_of_range);
+  EXPECT_THROW(this->list->end() + 1, std::out_of_range);
+}
+
+TYPED_TEST_P(MappedDoubleLinkedListTest, clear) {
+  this->setup(3);
+  this->list->clear();
+
+  EXPECT_TRUE(this->list->isEmpty());
+  EXPECT_EQ(this->list->begin(), this->list->end());
+
+  this->list->push_front(1);
+  this->reopen();
+  typename TestFixture::value_type expected[] = { 1 };
+  verifyMapped(expected, *this->list);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(MappedDoubleLinkedListTest,
+  empty,
+  push,
+  persist,
+  erase,
+  grow,
+  pushOwnValueWhenFull,
+  moveBefore,
+  swapWith,
+  relink,
+  advance,
+  clear
+);
+
+typedef testing::Types<
+  int,
+  float
+> MappedDoubleLinkedListTestTypes;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(
+  MainMappedDoubleLinkedListTest,
+  MappedDoubleLinkedListTest,
+  MappedDoubleLinkedListTestTypes);
+
+TEST(MappedDoubleLinkedListFileTest, wrongValueSize) {
+  TemporaryListFile file;
+  {
+    MappedDoubleLinkedList<int> list(file.path);
+    list.push_back(1);
+  }
+
+  EXPECT_THROW(MappedDoubleLinkedList<double> list(file.path), std::invalid_argument);
+
+  MappedDoubleLinkedList<int> list(file.path);
+  EXPECT_EQ(1U, list.size());
+}
+
+TEST(MappedDoubleLinkedListFileTest, notListFile) {
+  TemporaryListFile file;
+  const int fd = open(file.path.c_str(), O_WRONLY);
+  ASSERT_LE(0, fd);
+  const char text[] = "this is not a list file, but it is long enough for a header";
+  EXPECT_EQ(static_cast<ssize_t>(sizeof(text)), write(fd, text, sizeof(text)));
+  close(fd);
+
+  EXPECT_THROW(MappedDoubleLinkedList<int> list(file.path), std::invalid_argument);
+}
+
+/** \return the number of mappings of this process of the file at path
+ *
+ * \param path of the file
+ */
+static size_t mappingsOf(const std::string& path) {
+  std::ifstream maps("/proc/self/maps");
+  size_t count = 0;
+  for(std::string line; std::getline(maps, line); ) {
+    if(std::string::npos != line.find(path)) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+TEST(MappedDoubleLinkedListFileTest, largerFile) {
+  TemporaryListFile file;
+  {
+    MappedDoubleLinkedList<int> list(file.path);
+    list.push_back(1);
+  }
+
+  // Room beyond the capacity in the header is mapped, and unmapped, too
+  ASSERT_EQ(0, truncate(file.path.c_str(), 1 << 20));
+  {
+    MappedDoubleLinkedList<int> list(file.path);
+    EXPECT_EQ(1u, mappingsOf(file.path));
+    for(int value = 2; value <= 10000; ++value) {
+      list.push_back(value);
+    }
+  }
+  EXPECT_EQ(0u, mappingsOf(file.path));
+
+  MappedDoubleLinkedList<int> list(file.path);
+  EXPECT_EQ(10000u, list.size());
+  EXPECT_EQ(10000, *--list.end());
+}
+
+TEST(MappedDoubleLinkedListFileTest, missingDirectory) {
+  EXPECT_THROW(MappedDoubleLinkedList<int> list("/nonexistent/directory/list"), std::system_error);
+}
@@ -0,0 +1,207 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for mergeJoin, against joins by nested loops
+ */
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "MergeJoin.h"
+#include "Predicates.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::JoinKind;
+using Experiment::mergeJoin;
+
+/** A left record: key and payload */
+struct Order {
+  /** Key of the customer */
+  int customer;
+
+  /** The order's own number */
+  int number;
+};
+
+/** A right record: key and payload */
+struct Visit {
+  /** Key of the customer */
+  long customer;
+
+  /** The visit's own number */
+  int number;
+};
+
+/** A joined result: left and right numbers, with -1 for no right record */
+typedef std::pair<int, int> Joined;
+
+/** \return the key of order */
+int orderKey(const Order& order) {
+  return order.customer;
+}
+
+/** \return the key of visit */
+long visitKey(const Visit& visit) {
+  return visit.customer;
+}
+
+/** \return the results of joining orders and visits by nested loops
+ *
+ * \param orders left records
+ * \param visits right records
+ * \param kind of join
+ */
+std::vector<Joined> nestedLoopJoin(const std::vector<Order>& orders, const std::vector<Visit>& visits, const JoinKind kind) {
+  std::vector<Joined> joined;
+  for(const Order& order : orders) {
+    bool matched = false;
+    for(const Visit& visit : visits) {
+      if(order.customer != visit.customer) {
+	continue;
+      }
+      if(Experiment::INNER_JOIN == kind || Experiment::LEFT_OUTER_JOIN == kind
+	 || (Experiment::SEMI_JOIN == kind && !matched)) {
+	joined.push_back(Joined(order.number, visit.number));
+      }
+      matched = true;
+    }
+    if(!matched && (Experiment::LEFT_OUTER_JOIN == kind || Experiment::ANTI_JOIN == kind)) {
+      joined.push_back(Joined(order.number, -1));
+    }
+  }
+  return joined;
+}
+
+/** Collects the results of a join */
+class Collect {
+public:
+  /** Create collecting into joined
+   *
+   * \param theJoined to collect into
+   */
+  explicit Collect(std::vector<Joined>& theJoined)
+    : joined(theJoined)
+  {
+  }
+
+  /** Collect order with visit, or NULL for none */
+  void operator()(const Order& order, const Visit* visit) {
+    joined.push_back(Joined(order.number, NULL == visit ? -1 : visit->number));
+  }
+
+private:
+  /** The results collected */
+  std::vector<Joined>& joined;
+};
+
+/** Sorted orders and visits sharing some keys, with duplicates on both sides */
+class MergeJoinTest : public testing::Test {
+protected:
+  MergeJoinTest() {
+    unsigned int seed = 11;
+    for(int number = 0; number < 300; ++number) {
+      seed = seed * 1103515245 + 12345;
+      orders.push_back(Order { static_cast<int>((seed >> 8) % 60), number });
+      seed = seed * 1103515245 + 12345;
+      visits.push_back(Visit { static_cast<long>((seed >> 8) % 80) + 20, number });
+    }
+    std::stable_sort(orders.begin(), orders.end(), [](const Order& a, const Order& b) { return a.customer < b.customer; });
+    std::stable_sort(visits.begin(), visits.end(), [](const Visit& a, const Visit& b) { return a.customer < b.customer; });
+  }
+
+  /** Verify the join of kind over vectors and over lists matches nested loops
+   *
+   * \tparam kind of join
+   */
+  template<JoinKind kind>
+  void verify() {
+    const std::vector<Joined> expected = nestedLoopJoin(orders, visits, kind);
+
+    std::vector<Joined> ranges;
+    mergeJoin<kind>(orders.begin(), orders.end(), visits.begin(), visits.end(), orderKey, visitKey, Collect(ranges));
+    EXPECT_EQ(expected, ranges);
+
+    const DoubleLinkedList<Order> orderList(orders.begin(), orders.end());
+    const DoubleLinkedList<Visit> visitList(visits.begin(), visits.end());
+    std::vector<Joined> lists;
+    mergeJoin<kind>(orderList, visitList, orderKey, visitKey, Collect(lists));
+    EXPECT_EQ(expected, lists);
+  }
+
+  /** Left records */
+  std::vector<Order> orders;
+
+  /** Right records */
+  std::vector<Visit> visits;
+};
+
+TEST_F(MergeJoinTest, inner) {
+  verify<Experiment::INNER_JOIN>();
+}
+
+TEST_F(MergeJoinTest, leftOuter) {
+  verify<Experiment::LEFT_OUTER_JOIN>();
+}
+
+TEST_F(MergeJoinTest, semi) {
+  verify<Experiment::SEMI_JOIN>();
+}
+
+TEST_F(MergeJoinTest, anti) {
+  verify<Experiment::ANTI_JOIN>();
+}
+
+TEST_F(MergeJoinTest, emptyRight) {
+  std::vector<Visit> none;
+  std::vector<Joined> joined;
+  mergeJoin<Experiment::INNER_JOIN>(orders.begin(), orders.end(), none.begin(), none.end(), orderKey, visitKey, Collect(joined));
+  EXPECT_TRUE(joined.empty());
+
+  mergeJoin<Experiment::ANTI_JOIN>(orders.begin(), orders.end(), none.begin(), none.end(), orderKey, visitKey, Collect(joined));
+  EXPECT_EQ(orders.size(), joined.size());
+}
+
+TEST_F(MergeJoinTest, lessor) {
+  // Sorted by descending keys
+  std::reverse(orders.begin(), orders.end());
+  std::reverse(visits.begin(), visits.end());
+
+  std::vector<Joined> joined;
+  mergeJoin<Experiment::INNER_JOIN>(orders.begin(), orders.end(), visits.begin(), visits.end(), orderKey, visitKey,
+				    Collect(joined), std::greater<>());
+  std::vector<Joined> expected = nestedLoopJoin(orders, visits, Experiment::INNER_JOIN);
+  EXPECT_EQ(expected, joined);
+}
+
+TEST(MergeJoinDuplicatesTest, crossProductOfGroups) {
+  const std::vector<int> left = { 1, 2, 2, 2, 3 };
+  const std::vector<int> right = { 2, 2, 3, 3, 4 };
+  const Experiment::IdentityKey<int> identity;
+
+  size_t pairs = 0;
+  int sum = 0;
+  mergeJoin<Experiment::INNER_JOIN>(left.begin(), left.end(), right.begin(), right.end(), identity, identity,
+				    [&pairs, &sum](const int& l, const int* r) {
+				      ++pairs;
+				      sum += l * *r;
+				    });
+  EXPECT_EQ(3u * 2u + 2u, pairs);
+  EXPECT_EQ(3 * 2 * 4 + 2 * 9, sum);
+}
@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListMergeSort.h"
+#include "PerfCounters.h"
+#include "Sort.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::PerfCounter;
+using Experiment::PerfCounterSortMetrics;
+using Experiment::PerfCounters;
+using Experiment::PerfCounts;
+
+/** \return a sum of work values, to count something \param work to do */
+static long busyWork(long work) {
+  volatile long sum = 0;
+  for(long value = 0; value < work; ++value) {
+    sum = sum + value;
+  }
+  return sum;
+}
+
+TEST(PerfCountersTest, countsOrDegradesToTime) {
+  PerfCounters counters;
+  counters.start();
+  busyWork(1000000);
+  const PerfCounts counts = counters.stop();
+
+  EXPECT_LT(0.0, counts.seconds);
+  EXPECT_EQ(counters.anyAvailable(), counts.anyAvailable());
+  for(int counter = 0; counter < Experiment::PERF_COUNTERS; ++counter) {
+    EXPECT_EQ(counters.available(static_cast<PerfCounter>(counter)), counts.available[counter]);
+    if(!counts.available[counter]) {
+      EXPECT_EQ(0u, counts.values[counter]);
+    }
+  }
+  if(counts.available[Experiment::INSTRUCTIONS]) {
+    EXPECT_LT(1000000u, counts[Experiment::INSTRUCTIONS]);
+  }
+}
+
+TEST(PerfCountersTest, stopWhenStoppedRepeats) {
+  PerfCounters counters;
+  counters.start();
+  busyWork(1000);
+  const PerfCounts first = counters.stop();
+  busyWork(1000000);
+  const PerfCounts second = counters.stop();
+
+  EXPECT_EQ(first.seconds, second.seconds);
+  for(int counter = 0; counter < Experiment::PERF_COUNTERS; ++counter) {
+    EXPECT_EQ(first.values[counter], second.values[counter]);
+  }
+}
+
+TEST(PerfCountersTest, scope) {
+  PerfCounters counters;
+  PerfCounts counts = PerfCounts();
+  {
+    PerfCounters::Scope scope(counters, counts);
+    busyWork(1000);
+  }
+  EXPECT_LT(0.0, counts.seconds);
+}
+
+TEST(PerfCountersTest, exports) {
+  PerfCounts counts = PerfCounts();
+  counts.available[Experiment::CYCLES] = true;
+  counts.values[Experiment::CYCLES] = 12;
+
+  std::ostringstream out;
+  out << counts;
+  EXPECT_NE(std::string::npos, out.str().find("seconds="));
+  EXPECT_NE(std::string::npos, out.str().find(" cycles=12 "));
+  EXPECT_NE(std::string::npos, out.str().find(" branchMisses=-"));
+}
+
+TEST(PerfCountersTest, sortMetrics) {
+  std::vector<int> values;
+  for(int value = 0; value < 1000; ++value) {
+    values.push_back((value * 7919) % 1000);
+  }
+  DoubleLinkedList<int> list;
+  list.append(values.begin(), values.end());
+
+  Experiment::ListMergeSort<int, int*, std::less<int>, PerfCounterSortMetrics<int> > sort;
+  sort.sort(list);
+  EXPECT_LT(0u, sort.metrics.compares);
+  EXPECT_LT(0.0, sort.metrics.counts.seconds);
+  EXPECT_TRUE(std::is_sorted(list.cbegin(), list.cend()));
+
+  // Sort keeps the metrics of the engine it chose, radix sort comparing nothing
+  Experiment::Sort<int, int*, std::less<int>, PerfCounterSortMetrics<int> > facade;
+  facade.sort(values.data(), values.data() + values.size());
+  EXPECT_EQ(Experiment::RADIX_SORT, facade.strategy);
+  EXPECT_LT(0.0, facade.metrics.counts.seconds);
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for Prefetch
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListMergeSort.h"
+#include "Predicates.h"
+#include "Prefetch.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::ListMergeSort;
+using Experiment::PointerLess;
+
+namespace Prefetch = Experiment::Prefetch;
+
+/** Payload hook recording the values it is called with */
+class RecordingHook {
+public:
+  /** Record value
+   *
+   * \param value to record
+   */
+  void prefetch(const int& value) const {
+    values->push_back(value);
+  }
+
+  /** The values recorded */
+  std::vector<int>* values;
+};
+
+/** \return a list of the values 0 to count - 1
+ *
+ * \param count of values
+ */
+DoubleLinkedList<int> countTo(int count) {
+  DoubleLinkedList<int> list;
+  for(int i = 0; i < count; ++i) {
+    list.push_back(i);
+  }
+  return list;
+}
+
+TEST(PrefetchTest, forEachVisitsInOrder) {
+  DoubleLinkedList<int> list = countTo(20);
+  
+  const size_t distances[] = { 0, 1, 8, 19, 20, 100 };
+  for(const size_t distance : distances) {
+    std::vector<int> visited;
+    Prefetch::forEach(list.cbegin(), list.cend(), [&visited](const int& value) { visited.push_back(value); }, distance);
+    
+    ASSERT_EQ(20U, visited.size()) << "distance " << distance;
+    for(int i = 0; i < 20; ++i) {
+      EXPECT_EQ(i, visited[i]) << "distance " << distance;
+    }
+  }
+}
+
+TEST(PrefetchTest, forEachEmpty) {
+  DoubleLinkedList<int> list;
+  int calls = 0;
+  Prefetch::forEach(list.cbegin(), list.cend(), [&calls](const int&) { ++calls; });
+  EXPECT_EQ(0, calls);
+}
+
+TEST(PrefetchTest, payloadHookSeesEachValueOnce) {
+  DoubleLinkedList<int> list = countTo(10);
+  std::vector<int> hooked;
+  RecordingHook hook;
+  hook.values = &hooked;
+
+  Prefetch::forEach(list.cbegin(), list.cend(), [](const int&) { }, 3, hook);
+
+  ASSERT_EQ(10U, hooked.size());
+  for(int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, hooked[i]);
+  }
+}
+
+TEST(PrefetchTest, noPayloadHook) {
+  // Lessors without a prefetch method are not called
+  Prefetch::Payload<std::less<int>, int>::prefetch(std::less<int>(), 1);
+  Prefetch::Payload<PointerLess<int>, const int*>::prefetch(PointerLess<int>(), NULL);
+}
+
+TEST(PrefetchTest, mergeSortAtDistances) {
+  std::vector<int> values;
+  unsigned int seed = 5;
+  for(int i = 0; i < 1000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    values.push_back(static_cast<int>(seed >> 16));
+  }
+  std::vector<int> expected(values);
+  std::sort(expected.begin(), expected.end());
+
+  const size_t distances[] = { 0, 1, 4, 64 };
+  for(const size_t distance : distances) {
+    DoubleLinkedList<int*> list;
+    for(std::vector<int>::iterator iter = values.begin(); values.end() != iter; ++iter) {
+      list.push_back(&*iter);
+    }
+
+    ListMergeSort<int*, DoubleLinkedList<int*>::iterator, PointerLess<int> > sort;
+    sort.prefetchDistance = distance;
+    sort.sort(list);
+
+    std::vector<int>::const_iterator expectedIter = expected.begin();
+    DoubleLinkedList<int*>::const_iterator listIter = list.cbegin();
+    for( ; expected.end() != expectedIter && list.cend() != listIter; ++expectedIter, ++listIter) {
+      EXPECT_EQ(*expectedIter, **listIter) << "distance " << distance;
+    }
+    EXPECT_EQ(list.cend(), listIter);
+  }
+}
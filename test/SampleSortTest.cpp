@@ -0,0 +1,204 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListSnapshot.h"
+#include "SampleSort.h"
+#include "SampleSortTransport.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::SampleSort;
+using Experiment::SampleSortTransport;
+using Experiment::SampleSortWire;
+using Experiment::UnixSocketTransport;
+using Experiment::loadFrom;
+using Experiment::saveTo;
+
+/** test::Test sorting partitions across local worker processes, each
+ * leaving its sorted partition in a temporary file
+ */
+class SampleSortTest : public testing::Test {
+protected:
+  /** Remove the temporary files */
+  ~SampleSortTest() {
+    for(std::vector<std::string>::const_iterator iter = paths.begin(); paths.end() != iter; ++iter) {
+      unlink(iter->c_str());
+    }
+  }
+
+  /** Sort partitions across one worker process per partition, and verify
+   * the workers' partitions are, in rank order, the values sorted
+   *
+   * \param partitions the values given to each worker
+   * \param oversampling the samples sent by each worker
+   */
+  void verify(const std::vector<std::vector<int> >& partitions, size_t oversampling = SampleSort<int>::DEFAULT_OVERSAMPLING) {
+    for(size_t rank = 0; rank < partitions.size(); ++rank) {
+      char name[] = "/tmp/SampleSortTest.XXXXXX";
+      const int fd = mkstemp(name);
+      ASSERT_LE(0, fd);
+      close(fd);
+      paths.push_back(name);
+    }
+
+    const std::vector<std::string>& resultPaths = paths;
+    ASSERT_NO_THROW(UnixSocketTransport::runLocal(partitions.size(), [&](SampleSortTransport& transport) {
+	  DoubleLinkedList<int> data;
+	  data.append(partitions[transport.rank()].begin(), partitions[transport.rank()].end());
+	  SampleSort<int> sorter;
+	  sorter.oversampling = oversampling;
+	  sorter.sort(data, transport);
+	  saveTo(data, resultPaths[transport.rank()]);
+	}));
+
+    std::vector<int> expected;
+    for(std::vector<std::vector<int> >::const_iterator iter = partitions.begin(); partitions.end() != iter; ++iter) {
+      expected.insert(expected.end(), iter->begin(), iter->end());
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<int> actual;
+    for(size_t rank = 0; rank < partitions.size(); ++rank) {
+      DoubleLinkedList<int> result;
+      loadFrom(result, paths[rank]);
+      actual.insert(actual.end(), result.cbegin(), result.cend());
+    }
+    EXPECT_EQ(expected, actual);
+  }
+
+  /** \return workers partitions of count random values below range each
+   *
+   * \param workers the number of partitions
+   * \param count the values in each
+   * \param range the bound of the values
+   */
+  static std::vector<std::vector<int> > randomPartitions(size_t workers, size_t count, int range) {
+    std::vector<std::vector<int> > partitions(workers);
+    for(size_t rank = 0; rank < workers; ++rank) {
+      for(size_t index = 0; index < count; ++index) {
+	partitions[rank].push_back(rand() % range);
+      }
+    }
+    return partitions;
+  }
+
+  /** The temporary file of each worker's results */
+  std::vector<std::string> paths;
+};
+
+TEST_F(SampleSortTest, oneWorker) {
+  verify(randomPartitions(1, 1000, 1000000));
+}
+
+TEST_F(SampleSortTest, twoWorkers) {
+  verify(randomPartitions(2, 1000, 1000000));
+}
+
+TEST_F(SampleSortTest, fourWorkers) {
+  verify(randomPartitions(4, 10000, 1000000));
+}
+
+TEST_F(SampleSortTest, unevenPartitions) {
+  std::vector<std::vector<int> > partitions = randomPartitions(3, 0, 1);
+  partitions[0] = randomPartitions(1, 5000, 1000)[0];
+  partitions[2] = randomPartitions(1, 3, 1000)[0];
+  verify(partitions);
+}
+
+TEST_F(SampleSortTest, allEmpty) {
+  verify(randomPartitions(3, 0, 1));
+}
+
+TEST_F(SampleSortTest, manyDuplicates) {
+  verify(randomPartitions(4, 2000, 3));
+}
+
+TEST_F(SampleSortTest, alreadySorted) {
+  std::vector<std::vector<int> > partitions(3);
+  for(int value = 0; value < 3000; ++value) {
+    partitions[value % 3].push_back(value);
+  }
+  verify(partitions);
+}
+
+TEST_F(SampleSortTest, oneSample) {
+  verify(randomPartitions(3, 500, 1000000), 1);
+}
+
+TEST(SampleSortWorkerTest, failureFails) {
+  EXPECT_THROW(UnixSocketTransport::runLocal(3, [](SampleSortTransport& transport) {
+	if(1 == transport.rank()) {
+	  throw std::runtime_error("worker failed");
+	}
+	DoubleLinkedList<int> data;
+	for(int value = 0; value < 100; ++value) {
+	  data.push_back(value);
+	}
+	SampleSort<int> sorter;
+	sorter.sort(data, transport);
+      }), std::runtime_error);
+}
+
+TEST(SampleSortWorkerTest, unwaitableFails) {
+  // Children of a process ignoring SIGCHLD are reaped at once, so waitpid() fails
+  void (*const previous)(int) = std::signal(SIGCHLD, SIG_IGN);
+  EXPECT_THROW(UnixSocketTransport::runLocal(2, [](SampleSortTransport&) {
+      }), std::runtime_error);
+  std::signal(SIGCHLD, previous);
+}
+
+TEST(SampleSortWireTest, sendAndReceive) {
+  int pair[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, pair));
+  UnixSocketTransport first(0, std::vector<int>({ -1, pair[0] }));
+  UnixSocketTransport second(1, std::vector<int>({ pair[1], -1 }));
+  EXPECT_EQ(0u, first.rank());
+  EXPECT_EQ(1u, second.rank());
+  EXPECT_EQ(2u, second.workers());
+
+  const std::vector<double> sent({ 1.5, -2.0, 3.25 });
+  SampleSortWire<double>::send(first, 1, sent.begin(), sent.size());
+  DoubleLinkedList<double> received;
+  received.push_back(0.5);
+  SampleSortWire<double>::receive(second, 0, received);
+  EXPECT_EQ(std::vector<double>({ 0.5, 1.5, -2.0, 3.25 }), std::vector<double>(received.cbegin(), received.cend()));
+
+  // Values of another size are refused
+  SampleSortWire<int>::send(first, 1, sent.begin(), sent.size());
+  EXPECT_THROW(SampleSortWire<double>::receive(second, 0, received), std::invalid_argument);
+}
+
+TEST(SampleSortWireTest, closedFails) {
+  int pair[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, pair));
+  UnixSocketTransport second(1, std::vector<int>({ pair[1], -1 }));
+  {
+    UnixSocketTransport first(0, std::vector<int>({ -1, pair[0] }));
+  }
+
+  DoubleLinkedList<int> received;
+  EXPECT_THROW(SampleSortWire<int>::receive(second, 0, received), std::runtime_error);
+  const int value = 1;
+  EXPECT_THROW(second.send(0, &value, sizeof(value)), std::system_error);
+}
@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for ShardedLruCache.
+ */
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ShardedLruCache.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::ShardedLruCache;
+
+TEST(ShardedLruCacheTest, shardCount) {
+  EXPECT_THROW((ShardedLruCache<int, int>(100, 0)), std::invalid_argument);
+  EXPECT_THROW((ShardedLruCache<int, int>(100, 3)), std::invalid_argument);
+  EXPECT_EQ(4u, (ShardedLruCache<int, int>(100, 4).shardCount()));
+}
+
+TEST(ShardedLruCacheTest, putGetErase) {
+  ShardedLruCache<int, int> cache(64, 4);
+  int value = 0;
+  EXPECT_FALSE(cache.get(1, value));
+
+  EXPECT_TRUE(cache.put(1, 10));
+  EXPECT_TRUE(cache.put(2, 20));
+  EXPECT_TRUE(cache.get(1, value));
+  EXPECT_EQ(10, value);
+  EXPECT_TRUE(cache.get(2, value));
+  EXPECT_EQ(20, value);
+  EXPECT_EQ(2u, cache.size());
+
+  EXPECT_TRUE(cache.erase(1));
+  EXPECT_FALSE(cache.get(1, value));
+  EXPECT_EQ(1u, cache.size());
+
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST(ShardedLruCacheTest, capacityPerShard) {
+  ShardedLruCache<int, int> cache(64, 4);
+  for(int key = 0; key < 1000; ++key) {
+    cache.put(key, key);
+  }
+  EXPECT_EQ(64u, cache.size());
+
+  // The most recent key is always kept by its shard
+  int value = 0;
+  EXPECT_TRUE(cache.get(999, value));
+}
+
+TEST(ShardedLruCacheTest, unevenCapacity) {
+  // 100 over 64 shards: 36 shards of 2 and 28 of 1
+  ShardedLruCache<int, int> cache(100, 64);
+  EXPECT_EQ(64u, cache.shardCount());
+  EXPECT_EQ(100u, cache.capacity());
+  for(int key = 0; key < 1000; ++key) {
+    EXPECT_TRUE(cache.put(key, key));
+  }
+  EXPECT_GE(100u, cache.size());
+  EXPECT_LE(64u, cache.size());
+
+  ShardedLruCache<int, int> odd(70, 4);
+  EXPECT_EQ(70u, odd.capacity());
+}
+
+TEST(ShardedLruCacheTest, capacityBelowShardCount) {
+  // Fewer shards, so each can hold an entry
+  ShardedLruCache<int, int> cache(10);
+  EXPECT_EQ(8u, cache.shardCount());
+  EXPECT_EQ(10u, cache.capacity());
+  for(int key = 0; key < 10; ++key) {
+    EXPECT_TRUE(cache.put(key, key));
+  }
+  EXPECT_LT(0u, cache.size());
+  int value = 0;
+  EXPECT_TRUE(cache.get(9, value));
+  EXPECT_EQ(9, value);
+
+  EXPECT_EQ(1u, (ShardedLruCache<int, int>(1).shardCount()));
+  EXPECT_EQ(1u, (ShardedLruCache<int, int>(0).shardCount()));
+}
+
+TEST(ShardedLruCacheTest, concurrentThreads) {
+  ShardedLruCache<int, int> cache(100000, 16);
+  std::vector<std::thread> threads;
+  std::vector<int> failures(8, 0);
+  for(int thread = 0; thread < 8; ++thread) {
+    threads.push_back(std::thread([&cache, &failures, thread]() {
+	  for(int round = 0; round < 2; ++round) {
+	    for(int key = thread; key < 40000; key += 8) {
+	      int value = 0;
+	      if(cache.get(key, value)) {
+		if(key * 2 != value) {
+		  ++failures[thread];
+		}
+	      } else {
+		cache.put(key, key * 2);
+	      }
+	    }
+	  }
+	}));
+  }
+  for(size_t index = 0; index < threads.size(); ++index) {
+    threads[index].join();
+  }
+
+  for(int thread = 0; thread < 8; ++thread) {
+    EXPECT_EQ(0, failures[thread]);
+  }
+  EXPECT_EQ(40000u, cache.size());
+}
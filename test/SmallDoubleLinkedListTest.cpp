@@ -0,0 +1,217 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for SmallDoubleLinkedList
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "ListMergeSort.h"
+#include "SmallDoubleLinkedList.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::ListMergeSort;
+using Experiment::SmallDoubleLinkedList;
+
+/** Verify that the ordered data in expected matches the data in list, walking
+ * forward and backward.
+ *
+ * Failures are noted by EXPECT_* macros
+ *
+ * \param expected to compare items to list
+ * \param list to compare to items in expected
+ *
+ * \tparam T type of Data in expected and the List
+ */
+template<class T>
+void verifySmall(const std::vector<T>& expected, DoubleLinkedList<T>& list) {
+  typename DoubleLinkedList<T>::const_iterator listIter = list.cbegin();
+  typename std::vector<T>::const_iterator expectedIter = expected.begin();
+  for( ; expected.end() != expectedIter && list.cend() != listIter; ++expectedIter, ++listIter) {
+    EXPECT_EQ(*expectedIter, *listIter);
+  }
+  EXPECT_EQ(expected.end(), expectedIter);
+  EXPECT_EQ(list.cend(), listIter);
+
+  while(expected.begin() != expectedIter && list.cbegin() != listIter) {
+    EXPECT_EQ(*--expectedIter, *--listIter);
+  }
+  EXPECT_EQ(expected.begin(), expectedIter);
+  EXPECT_EQ(list.cbegin(), listIter);
+}
+
+/** \return true if value lies inside the object list, so its Node is inline
+ *
+ * \param value in a Node of list
+ * \param list the list
+ *
+ * \tparam T type of value
+ * \tparam List type of list
+ */
+template<class T, class List>
+bool isInline(const T& value, const List& list) {
+  const char* address = reinterpret_cast<const char*>(&value);
+  const char* object = reinterpret_cast<const char*>(&list);
+  return object <= address && address < object + sizeof(List);
+}
+
+/** SmallDoubleLinkedList test fixture.
+ *
+ * \tparam T the type of Data being tested
+ */
+template<class T>
+class SmallDoubleLinkedListTest : public testing::Test {
+protected:
+  typedef T value_type;
+
+  /** Convenience typedef of the type of the SmallDoubleLinkedList */
+  typedef SmallDoubleLinkedList<value_type, 3> List;
+
+  /** Convenience typedef of iterator of List */
+  typedef typename List::iterator Iterator;
+};
+TYPED_TEST_SUITE_P(SmallDoubleLinkedListTest);
+
+TYPED_TEST_P(SmallDoubleLinkedListTest, empty) {
+  typename TestFixture::List list;
+  EXPECT_TRUE(list.isEmpty());
+  EXPECT_EQ(list.begin(), list.end());
+  EXPECT_EQ(3U, TestFixture::List::inlineCapacity());
+}
+
+TYPED_TEST_P(SmallDoubleLinkedListTest, spill) {
+  typename TestFixture::List list;
+  list.push_back(1);
+  list.push_back(2);
+  list.push_front(0);
+  list.push_back(3);
+  list.push_front(-1);
+
+  std::vector<typename TestFixture::value_type> expected = { -1, 0, 1, 2, 3 };
+  verifySmall(expected, list);
+
+  // The first three pushed are inline, the rest on the heap
+  typename TestFixture::Iterator iter = list.begin();
+  EXPECT_FALSE(isInline(*iter++, list));
+  EXPECT_TRUE(isInline(*iter++, list));
+  EXPECT_TRUE(isInline(*iter++, list));
+  EXPECT_TRUE(isInline(*iter++, list));
+  EXPECT_FALSE(isInline(*iter++, list));
+}
+
+TYPED_TEST_P(SmallDoubleLinkedListTest, reuseSlot) {
+  typename TestFixture::List list;
+  list.push_back(0);
+  list.push_back(1);
+  list.push_back(2);
+
+  // Removing an inline Node frees its slot
+  DoubleLinkedList<typename TestFixture::value_type> other;
+  typename TestFixture::Iterator second = list.begin() + 1;
+  typename DoubleLinkedList<typename TestFixture::value_type>::iterator otherEnd = other.end();
+  second.moveBefore(otherEnd);
+  other.clear();
+
+  list.push_back(3);
+  std::vector<typename TestFixture::value_type> expected = { 0, 2, 3 };
+  verifySmall(expected, list);
+  EXPECT_TRUE(isInline(*(list.begin() + 2), list));
+}
+
+TYPED_TEST_P(SmallDoubleLinkedListTest, iteratorsKeepPositions) {
+  typename TestFixture::List list;
+  list.push_back(1);
+  typename TestFixture::Iterator first = list.begin();
+  list.push_front(0);
+
+  // As for DoubleLinkedList, iterators keep their positions rather than values
+  EXPECT_EQ(0, *first);
+  EXPECT_EQ(1, *(first + 1));
+}
+
+TYPED_TEST_P(SmallDoubleLinkedListTest, copy) {
+  typename TestFixture::List list;
+  for(int i = 0; i < 5; ++i) {
+    list.push_back(i);
+  }
+
+  typename TestFixture::List copy(list);
+  list.clear();
+
+  std::vector<typename TestFixture::value_type> expected = { 0, 1, 2, 3, 4 };
+  verifySmall(expected, copy);
+  EXPECT_TRUE(isInline(*copy.begin(), copy));
+}
+
+TYPED_TEST_P(SmallDoubleLinkedListTest, sort) {
+  typename TestFixture::List list;
+  list.push_back(3);
+  list.push_back(1);
+  list.push_back(4);
+  list.push_back(0);
+  list.push_back(2);
+
+  ListMergeSort<typename TestFixture::value_type, typename TestFixture::Iterator> sort;
+  sort.sort(list);
+
+  std::vector<typename TestFixture::value_type> expected = { 0, 1, 2, 3, 4 };
+  verifySmall(expected, list);
+}
+
+TYPED_TEST_P(SmallDoubleLinkedListTest, nestedList) {
+  typedef DoubleLinkedList<typename TestFixture::List> NestedList;
+
+  NestedList nested;
+  for(int outer = 0; outer < 10; ++outer) {
+    nested.push_back(typename TestFixture::List());
+    typename TestFixture::List& inner = *--nested.end();
+    for(int i = 0; i < outer % 5; ++i) {
+      inner.push_back(outer + i);
+    }
+  }
+
+  int outer = 0;
+  for(typename NestedList::iterator iter = nested.begin(); nested.end() != iter; ++iter, ++outer) {
+    std::vector<typename TestFixture::value_type> expected;
+    for(int i = 0; i < outer % 5; ++i) {
+      expected.push_back(outer + i);
+    }
+    verifySmall(expected, *iter);
+  }
+  EXPECT_EQ(10, outer);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(SmallDoubleLinkedListTest,
+  empty,
+  spill,
+  reuseSlot,
+  iteratorsKeepPositions,
+  copy,
+  sort,
+  nestedList
+);
+
+typedef testing::Types<
+  int,
+  float
+> SmallDoubleLinkedListTestTypes;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(
+  MainSmallDoubleLinkedListTest,
+  SmallDoubleLinkedListTest,
+  SmallDoubleLinkedListTestTypes);
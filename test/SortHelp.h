@@ -19,6 +19,12 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  */
 
 #include "DoubleLinkedList.h"
+#include "IndexedDoubleLinkedList.h"
+#include "MappedDoubleLinkedList.h"
+
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
 
 #include "gtest/gtest.h"
 
@@ -201,13 +207,195 @@ public:
     sort.sort(dataList.begin(), dataList.end());
 
     // Assumes data type not susceptable to instability
-    typename Experiment::DoubleLinkedList<T>::iterator dataIter = dataList.begin();
+    typename Experiment::DoubleLinkedList<T>::const_iterator dataIter = dataList.cbegin();
+    T* expectedIter = expected;
+    for( ; dataList.cend() != dataIter && (expected + length) != expectedIter; ++dataIter, ++expectedIter) {
+      EXPECT_EQ(*dataIter, *expectedIter);
+    }
+ 
+    EXPECT_EQ(dataList.cend(), dataIter);
+    EXPECT_EQ(expected + length,  expectedIter);
+  }
+};
+
+/** Template Test methods for DoubleLinkedList of type T to be sorted in place by Sort
+ *
+ * \tparam T data type in DoubleLinkedList
+ * \tparam Sort Sort Algorithm to use
+ */
+template<class T, class Sort>
+class DoubleLinkedListInPlaceTester {
+public:
+  typedef T value_type;
+
+  /** Test Sort of an empty container */
+  void testEmpty() {
+    Experiment::DoubleLinkedList<T> dataList;
+    
+    Sort sort;
+    sort.sort(dataList);
+    
+    EXPECT_TRUE(dataList.isEmpty());
+  }
+
+  /** Test with input data to match expected
+   *
+   * \param data ordered values of length as input to sort
+   * \param exected ordered values of length after sort
+   *
+   * \tparam length of data and expected
+   */
+  template<size_t length>
+  void test(T (&data)[length], T (&expected)[length]) {
+    Experiment::DoubleLinkedList<T> dataList;
+    for(T* iter = data; (data + length) != iter; ++iter) {
+      dataList.push_back(*iter);
+    }
+
+    Sort sort;
+    sort.sort(dataList);
+
+    // Assumes data type not susceptable to instability
+    typename Experiment::DoubleLinkedList<T>::const_iterator dataIter = dataList.cbegin();
+    T* expectedIter = expected;
+    for( ; dataList.cend() != dataIter && (expected + length) != expectedIter; ++dataIter, ++expectedIter) {
+      EXPECT_EQ(*dataIter, *expectedIter);
+    }
+ 
+    EXPECT_EQ(dataList.cend(), dataIter);
+    EXPECT_EQ(expected + length,  expectedIter);
+
+    // Walk back to ensure the previous links were rebuilt too
+    typename Experiment::DoubleLinkedList<T>::const_iterator backIter = dataList.cend();
+    for( ; dataList.cbegin() != backIter && expected != expectedIter; ) {
+      EXPECT_EQ(*--backIter, *--expectedIter);
+    }
+    EXPECT_EQ(dataList.cbegin(), backIter);
+    EXPECT_EQ(expected, expectedIter);
+  }
+};
+
+/** Template Test methods for IndexedDoubleLinkedList of type T to be sorted in
+ * place by Sort
+ *
+ * \tparam T data type in IndexedDoubleLinkedList
+ * \tparam Sort Sort Algorithm to use
+ */
+template<class T, class Sort>
+class IndexedDoubleLinkedListTester {
+public:
+  typedef T value_type;
+
+  /** Test Sort of an empty container */
+  void testEmpty() {
+    Experiment::IndexedDoubleLinkedList<T> dataList;
+    
+    Sort sort;
+    sort.sort(dataList);
+    
+    EXPECT_TRUE(dataList.isEmpty());
+  }
+
+  /** Test with input data to match expected
+   *
+   * \param data ordered values of length as input to sort
+   * \param exected ordered values of length after sort
+   *
+   * \tparam length of data and expected
+   */
+  template<size_t length>
+  void test(T (&data)[length], T (&expected)[length]) {
+    Experiment::IndexedDoubleLinkedList<T> dataList;
+    for(T* iter = data; (data + length) != iter; ++iter) {
+      dataList.push_back(*iter);
+    }
+
+    Sort sort;
+    sort.sort(dataList);
+
+    // Assumes data type not susceptable to instability
+    typename Experiment::IndexedDoubleLinkedList<T>::const_iterator dataIter = dataList.cbegin();
+    T* expectedIter = expected;
+    for( ; dataList.cend() != dataIter && (expected + length) != expectedIter; ++dataIter, ++expectedIter) {
+      EXPECT_EQ(*dataIter, *expectedIter);
+    }
+ 
+    EXPECT_EQ(dataList.cend(), dataIter);
+    EXPECT_EQ(expected + length,  expectedIter);
+  }
+};
+
+/** A temporary file for a MappedDoubleLinkedList, removed once the list has it
+ * open.
+ */
+class TemporaryListFile {
+public:
+  /** Create an empty temporary file */
+  TemporaryListFile()
+    : path("/tmp/SortHelpXXXXXX")
+  {
+    const int fd = mkstemp(&path[0]);
+    EXPECT_LE(0, fd);
+    close(fd);
+  }
+
+  /** Remove the file, if not removed already */
+  ~TemporaryListFile() {
+    unlink(path.c_str());
+  }
+
+  /** The path of the file */
+  std::string path;
+};
+
+/** Template Test methods for MappedDoubleLinkedList of type T to be sorted in
+ * place by Sort
+ *
+ * \tparam T data type in MappedDoubleLinkedList
+ * \tparam Sort Sort Algorithm to use
+ */
+template<class T, class Sort>
+class MappedDoubleLinkedListTester {
+public:
+  typedef T value_type;
+
+  /** Test Sort of an empty container */
+  void testEmpty() {
+    TemporaryListFile file;
+    Experiment::MappedDoubleLinkedList<T> dataList(file.path);
+    
+    Sort sort;
+    sort.sort(dataList);
+    
+    EXPECT_TRUE(dataList.isEmpty());
+  }
+
+  /** Test with input data to match expected
+   *
+   * \param data ordered values of length as input to sort
+   * \param exected ordered values of length after sort
+   *
+   * \tparam length of data and expected
+   */
+  template<size_t length>
+  void test(T (&data)[length], T (&expected)[length]) {
+    TemporaryListFile file;
+    Experiment::MappedDoubleLinkedList<T> dataList(file.path);
+    for(T* iter = data; (data + length) != iter; ++iter) {
+      dataList.push_back(*iter);
+    }
+
+    Sort sort;
+    sort.sort(dataList);
+
+    // Assumes data type not susceptable to instability
+    typename Experiment::MappedDoubleLinkedList<T>::const_iterator dataIter = dataList.cbegin();
     T* expectedIter = expected;
-    for( ; dataList.end() != dataIter && (expected + length) != expectedIter; ++dataIter, ++expectedIter) {
+    for( ; dataList.cend() != dataIter && (expected + length) != expectedIter; ++dataIter, ++expectedIter) {
       EXPECT_EQ(*dataIter, *expectedIter);
     }
  
-    EXPECT_EQ(dataList.end(), dataIter);
+    EXPECT_EQ(dataList.cend(), dataIter);
     EXPECT_EQ(expected + length,  expectedIter);
   }
 };
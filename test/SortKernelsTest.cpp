@@ -0,0 +1,187 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for the SortKernels sorting networks with each supported type.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "ListMergeSort.h"
+#include "SortKernels.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::ListMergeSort;
+namespace SortKernels = Experiment::SortKernels;
+
+/** Template test::Test providing random blocks of T to sort
+ *
+ * \tparam T the type of value to sort
+ */
+template<class T>
+class SortKernelsTest : public testing::Test {
+protected:
+  /** \return count values from -range to range with duplicates
+   *
+   * \param count of values to return
+   * \param range of the values
+   */
+  std::vector<T> values(size_t count, int range = 100) {
+    std::uniform_int_distribution<int> distribution(-range, range);
+    std::vector<T> result;
+    for(size_t index = 0; index < count; ++index) {
+      result.push_back(static_cast<T>(distribution(random)));
+    }
+    return result;
+  }
+
+  /** \return values sorted by std::sort \param values to sort */
+  static std::vector<T> sorted(std::vector<T> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+  }
+
+  /** Source of random values, seeded for repeatable tests */
+  std::mt19937 random;
+};
+TYPED_TEST_SUITE_P(SortKernelsTest);
+
+TYPED_TEST_P(SortKernelsTest, sortBlock) {
+  for(int round = 0; round < 20; ++round) {
+    std::vector<TypeParam> block = this->values(SortKernels::BLOCK);
+    std::vector<TypeParam> scalar = block;
+    const std::vector<TypeParam> expected = this->sorted(block);
+
+    SortKernels::sortBlock(block.data());
+    EXPECT_EQ(expected, block);
+
+    SortKernels::sortBlockScalar(scalar.data());
+    EXPECT_EQ(expected, scalar);
+  }
+}
+
+TYPED_TEST_P(SortKernelsTest, sortBlockLimits) {
+  std::vector<TypeParam> block = this->values(SortKernels::BLOCK);
+  block[3] = std::numeric_limits<TypeParam>::max();
+  block[17] = std::numeric_limits<TypeParam>::lowest();
+  block[40] = SortKernels::padding<TypeParam>();
+  const std::vector<TypeParam> expected = this->sorted(block);
+
+  SortKernels::sortBlock(block.data());
+  EXPECT_EQ(expected, block);
+}
+
+TYPED_TEST_P(SortKernelsTest, mergeBlocks) {
+  for(int round = 0; round < 20; ++round) {
+    std::vector<TypeParam> blocks = this->values(2 * SortKernels::BLOCK);
+    std::sort(blocks.begin(), blocks.begin() + SortKernels::BLOCK);
+    std::sort(blocks.begin() + SortKernels::BLOCK, blocks.end());
+    const std::vector<TypeParam> expected = this->sorted(blocks);
+
+    SortKernels::mergeBlocks(blocks.data());
+    EXPECT_EQ(expected, blocks);
+  }
+}
+
+TYPED_TEST_P(SortKernelsTest, listMergeSortRuns) {
+  const size_t lengths[] = { 1, 2, 63, 64, 65, 127, 128, 129, 1000 };
+  for(size_t index = 0; index < sizeof(lengths) / sizeof(lengths[0]); ++index) {
+    const size_t length = lengths[index];
+    std::vector<TypeParam> data = this->values(length, 1000000);
+    const std::vector<TypeParam> expected = this->sorted(data);
+
+    ListMergeSort<TypeParam, typename std::vector<TypeParam>::iterator> sort;
+    sort.sort(data.begin(), data.end());
+    EXPECT_EQ(expected, data) << "length " << length;
+  }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(SortKernelsTest,
+  sortBlock,
+  sortBlockLimits,
+  mergeBlocks,
+  listMergeSortRuns
+);
+
+typedef testing::Types<
+  int32_t,
+  int64_t,
+  float,
+  double
+> SortKernelsTestTypes;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(
+  MainSortKernelsTest,
+  SortKernelsTest,
+  SortKernelsTestTypes);
+
+/** Floating point test::Test for values ordered specially
+ *
+ * \tparam T the floating point type to sort
+ */
+template<class T>
+class SortKernelsFloatTest : public testing::Test {
+};
+TYPED_TEST_SUITE_P(SortKernelsFloatTest);
+
+TYPED_TEST_P(SortKernelsFloatTest, signedZerosKept) {
+  std::vector<TypeParam> block(SortKernels::BLOCK);
+  for(size_t index = 0; index < block.size(); ++index) {
+    block[index] = (0 == index % 2) ? TypeParam(0) : -TypeParam(0);
+  }
+
+  SortKernels::sortBlock(block.data());
+  EXPECT_EQ(SortKernels::BLOCK / 2, static_cast<size_t>(std::count_if(block.begin(), block.end(), [](TypeParam value) { return std::signbit(value); })));
+}
+
+TYPED_TEST_P(SortKernelsFloatTest, nanKept) {
+  std::vector<TypeParam> data;
+  for(size_t index = 0; index < 150; ++index) {
+    data.push_back(static_cast<TypeParam>(index));
+  }
+  data[20] = std::numeric_limits<TypeParam>::quiet_NaN();
+  data[140] = std::numeric_limits<TypeParam>::quiet_NaN();
+
+  ListMergeSort<TypeParam, typename std::vector<TypeParam>::iterator> sort;
+  sort.sort(data.begin(), data.end());
+
+  // Order with NaN is unspecified, but no value may be lost
+  EXPECT_EQ(2, std::count_if(data.begin(), data.end(), [](TypeParam value) { return value != value; }));
+  for(size_t index = 0; index < 150; ++index) {
+    if(20 != index && 140 != index) {
+      EXPECT_EQ(1, std::count(data.begin(), data.end(), static_cast<TypeParam>(index))) << index;
+    }
+  }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(SortKernelsFloatTest,
+  signedZerosKept,
+  nanKept
+);
+
+typedef testing::Types<
+  float,
+  double
+> SortKernelsFloatTestTypes;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(
+  MainSortKernelsFloatTest,
+  SortKernelsFloatTest,
+  SortKernelsFloatTestTypes);
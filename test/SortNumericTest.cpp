@@ -12,23 +12,35 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 */
 
 /** \file
- * Test Cases with int and float data for Sort algorithms.  Currently: ListMergeSort.
+ * Test Cases with int and float data for Sort algorithms.  Currently: ListMergeSort, ListKeySort, ListQuickSort and Sort.
  */
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 
 #include "DoubleLinkedList.h"
+#include "IndexedDoubleLinkedList.h"
+#include "ListKeySort.h"
 #include "ListMergeSort.h"
+#include "ListQuickSort.h"
+#include "MappedDoubleLinkedList.h"
 #include "Predicates.h"
+#include "Sort.h"
 
 #include "SortHelp.h"
 
 #include "gtest/gtest.h"
 
 using Experiment::DoubleLinkedList;
+using Experiment::IdentityKey;
+using Experiment::IndexedDoubleLinkedList;
+using Experiment::ListKeySort;
 using Experiment::ListMergeSort;
+using Experiment::ListQuickSort;
+using Experiment::MappedDoubleLinkedList;
 using Experiment::PointerLess;
+using Experiment::Sort;
 
 /** Template test::Test providing the test data numeric Sort
  * algorithms.
@@ -194,6 +206,70 @@ TYPED_TEST_P(SortNumericTest, sortLargeA) {
   this->tester.test(data, expected);
 }
 
+TYPED_TEST_P(SortNumericTest, sortManyRuns) {
+  // Several runs of sorting kernels and a partial run, with duplicates
+  const size_t length = 300;
+  typename TestFixture::value_type data[length];
+  typename TestFixture::value_type expected[length];
+  unsigned int seed = 7;
+  for(size_t index = 0; index < length; ++index) {
+    seed = seed * 1103515245 + 12345;
+    data[index] = static_cast<typename TestFixture::value_type>(static_cast<int>(seed >> 16) % 200 - 100);
+    expected[index] = data[index];
+  }
+  data[length / 2] = this->max;
+  data[length - 1] = this->min;
+  expected[length / 2] = this->max;
+  expected[length - 1] = this->min;
+  std::sort(expected, expected + length);
+
+  this->tester.test(data, expected);
+}
+
+TYPED_TEST_P(SortNumericTest, sortManyOfFewUnique) {
+  // Many duplicates of few distinct values, as status codes or enums
+  const size_t length = 5000;
+  typename TestFixture::value_type data[length];
+  typename TestFixture::value_type expected[length];
+  const typename TestFixture::value_type unique[] = { this->max, 3, this->min, -1, 0 };
+  unsigned int seed = 11;
+  for(size_t index = 0; index < length; ++index) {
+    seed = seed * 1103515245 + 12345;
+    data[index] = unique[(seed >> 16) % 5];
+    expected[index] = data[index];
+  }
+  std::sort(expected, expected + length);
+
+  this->tester.test(data, expected);
+}
+
+TYPED_TEST_P(SortNumericTest, sortManyEqual) {
+  const size_t length = 5000;
+  typename TestFixture::value_type data[length];
+  typename TestFixture::value_type expected[length];
+  for(size_t index = 0; index < length; ++index) {
+    data[index] = 7;
+    expected[index] = 7;
+  }
+
+  this->tester.test(data, expected);
+}
+
+TYPED_TEST_P(SortNumericTest, sortManyOrganPipe) {
+  // Ascending then descending, with duplicates: poor pivots for simple samples
+  const size_t length = 5000;
+  typename TestFixture::value_type data[length];
+  typename TestFixture::value_type expected[length];
+  for(size_t index = 0; index < length; ++index) {
+    const size_t rise = index < length / 2 ? index : length - 1 - index;
+    data[index] = static_cast<typename TestFixture::value_type>(static_cast<int>(rise / 2));
+    expected[index] = data[index];
+  }
+  std::sort(expected, expected + length);
+
+  this->tester.test(data, expected);
+}
+
 REGISTER_TYPED_TEST_SUITE_P(SortNumericTest,
   sortNone,
   sortOne,
@@ -209,7 +285,11 @@ REGISTER_TYPED_TEST_SUITE_P(SortNumericTest,
   sortTwoOfThreeEqual,
   sortThreeOfThreeEqual,
   sortLimitValues,
-  sortLargeA
+  sortLargeA,
+  sortManyRuns,
+  sortManyOfFewUnique,
+  sortManyEqual,
+  sortManyOrganPipe
 );
 
 typedef testing::Types<
@@ -217,10 +297,44 @@ typedef testing::Types<
   ArrayOfPointerTester<int, ListMergeSort<int*, int**, PointerLess<int> > >,
   VectorTester<int, ListMergeSort<int, std::vector<int>::iterator> >,
   DoubleLinkedListTester<int, ListMergeSort<int, DoubleLinkedList<int>::iterator> >,
+  IndexedDoubleLinkedListTester<int, ListMergeSort<int, IndexedDoubleLinkedList<int>::iterator> >,
+  MappedDoubleLinkedListTester<int, ListMergeSort<int, MappedDoubleLinkedList<int>::iterator> >,
+  DoubleLinkedListInPlaceTester<int, ListMergeSort<int, DoubleLinkedList<int>::iterator> >,
+  ArrayTester<int, ListKeySort<int, IdentityKey<int> > >,
+  VectorTester<int, ListKeySort<int, IdentityKey<int>, std::vector<int>::iterator> >,
+  DoubleLinkedListTester<int, ListKeySort<int, IdentityKey<int>, DoubleLinkedList<int>::iterator> >,
+  DoubleLinkedListInPlaceTester<int, ListKeySort<int, IdentityKey<int> > >,
+  ArrayTester<int, ListQuickSort<int> >,
+  ArrayOfPointerTester<int, ListQuickSort<int*, int**, PointerLess<int> > >,
+  VectorTester<int, ListQuickSort<int, std::vector<int>::iterator> >,
+  DoubleLinkedListTester<int, ListQuickSort<int, DoubleLinkedList<int>::iterator> >,
+  DoubleLinkedListInPlaceTester<int, ListQuickSort<int> >,
+  ArrayTester<int, Sort<int> >,
+  ArrayOfPointerTester<int, Sort<int*, int**, PointerLess<int> > >,
+  VectorTester<int, Sort<int, std::vector<int>::iterator> >,
+  DoubleLinkedListTester<int, Sort<int, DoubleLinkedList<int>::iterator> >,
+  DoubleLinkedListInPlaceTester<int, Sort<int> >,
   ArrayTester<float, ListMergeSort<float> >,
   ArrayOfPointerTester<float, ListMergeSort<float*, float**, PointerLess<float> > >,
   VectorTester<float, ListMergeSort<float, std::vector<float>::iterator> >,
-  DoubleLinkedListTester<float, ListMergeSort<float, DoubleLinkedList<float>::iterator> >
+  DoubleLinkedListTester<float, ListMergeSort<float, DoubleLinkedList<float>::iterator> >,
+  IndexedDoubleLinkedListTester<float, ListMergeSort<float, IndexedDoubleLinkedList<float>::iterator> >,
+  MappedDoubleLinkedListTester<float, ListMergeSort<float, MappedDoubleLinkedList<float>::iterator> >,
+  DoubleLinkedListInPlaceTester<float, ListMergeSort<float, DoubleLinkedList<float>::iterator> >,
+  ArrayTester<float, ListKeySort<float, IdentityKey<float> > >,
+  VectorTester<float, ListKeySort<float, IdentityKey<float>, std::vector<float>::iterator> >,
+  DoubleLinkedListTester<float, ListKeySort<float, IdentityKey<float>, DoubleLinkedList<float>::iterator> >,
+  DoubleLinkedListInPlaceTester<float, ListKeySort<float, IdentityKey<float> > >,
+  ArrayTester<float, ListQuickSort<float> >,
+  ArrayOfPointerTester<float, ListQuickSort<float*, float**, PointerLess<float> > >,
+  VectorTester<float, ListQuickSort<float, std::vector<float>::iterator> >,
+  DoubleLinkedListTester<float, ListQuickSort<float, DoubleLinkedList<float>::iterator> >,
+  DoubleLinkedListInPlaceTester<float, ListQuickSort<float> >,
+  ArrayTester<float, Sort<float> >,
+  ArrayOfPointerTester<float, Sort<float*, float**, PointerLess<float> > >,
+  VectorTester<float, Sort<float, std::vector<float>::iterator> >,
+  DoubleLinkedListTester<float, Sort<float, DoubleLinkedList<float>::iterator> >,
+  DoubleLinkedListInPlaceTester<float, Sort<float> >
 > SortNumericTestTypes;
 
 INSTANTIATE_TYPED_TEST_SUITE_P(
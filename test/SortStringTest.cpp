@@ -12,23 +12,32 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 */
 
 /** \file
- * Test Cases with string data for Sort algorithms.  Currently: ListMergeSort.
+ * Test Cases with string data for Sort algorithms.  Currently: ListMergeSort, ListKeySort, ListQuickSort and Sort.
  */
 
 
 #include <stdexcept>
 
 #include "DoubleLinkedList.h"
+#include "IndexedDoubleLinkedList.h"
+#include "ListKeySort.h"
 #include "ListMergeSort.h"
+#include "ListQuickSort.h"
 #include "Predicates.h"
+#include "Sort.h"
 
 #include "SortHelp.h"
 
 #include "gtest/gtest.h"
 
 using Experiment::DoubleLinkedList;
+using Experiment::IdentityKey;
+using Experiment::IndexedDoubleLinkedList;
+using Experiment::ListKeySort;
 using Experiment::ListMergeSort;
+using Experiment::ListQuickSort;
 using Experiment::PointerLess;
+using Experiment::Sort;
 
 /** Template test::Test providing the test data string-based Sort
  * algorithms.
@@ -251,7 +260,17 @@ typedef testing::Types<
   ArrayTester<std::string, ListMergeSort<std::string> >,
   ArrayOfPointerTester<std::string, ListMergeSort<std::string*, std::string**, PointerLess<std::string> > >,
   VectorTester<std::string, ListMergeSort<std::string, std::vector<std::string>::iterator> >,
-  DoubleLinkedListTester<std::string, ListMergeSort<std::string, DoubleLinkedList<std::string>::iterator> >
+  DoubleLinkedListTester<std::string, ListMergeSort<std::string, DoubleLinkedList<std::string>::iterator> >,
+  IndexedDoubleLinkedListTester<std::string, ListMergeSort<std::string, IndexedDoubleLinkedList<std::string>::iterator> >,
+  DoubleLinkedListInPlaceTester<std::string, ListMergeSort<std::string, DoubleLinkedList<std::string>::iterator> >,
+  ArrayTester<std::string, ListKeySort<std::string, IdentityKey<std::string> > >,
+  DoubleLinkedListInPlaceTester<std::string, ListKeySort<std::string, IdentityKey<std::string> > >,
+  ArrayTester<std::string, ListQuickSort<std::string> >,
+  ArrayOfPointerTester<std::string, ListQuickSort<std::string*, std::string**, PointerLess<std::string> > >,
+  DoubleLinkedListInPlaceTester<std::string, ListQuickSort<std::string> >,
+  ArrayTester<std::string, Sort<std::string> >,
+  ArrayOfPointerTester<std::string, Sort<std::string*, std::string**, PointerLess<std::string> > >,
+  DoubleLinkedListInPlaceTester<std::string, Sort<std::string> >
 > SortStringTestTypes;
 
 INSTANTIATE_TYPED_TEST_SUITE_P(
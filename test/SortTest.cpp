@@ -0,0 +1,259 @@
+/*
+Copyright (c) 2013, Komodo Does Inc
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+- Neither the name of the Komodo Does Inc nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/** \file
+ * Test Cases for Sort specific to the engine it chooses for each input.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DoubleLinkedList.h"
+#include "Sort.h"
+
+#include "gtest/gtest.h"
+
+using Experiment::DoubleLinkedList;
+using Experiment::Sort;
+using Experiment::SortThresholds;
+
+/** \return thresholds for these tests, independent of SortTuning.h as
+ * measured for any one machine
+ */
+static SortThresholds testThresholds() {
+  SortThresholds thresholds;
+  thresholds.insertionMax = 16;
+  thresholds.valuesPerRunMin = 64;
+  thresholds.radixMin = 512;
+  thresholds.fewDistinctMax = 24;
+  thresholds.distinctSample = 64;
+  return thresholds;
+}
+
+/** \return length pseudo-random values in [0, range)
+ *
+ * \param length the number of values
+ * \param range the bound of values
+ */
+static std::vector<int> randomValues(const size_t length, const unsigned int range) {
+  std::vector<int> values;
+  unsigned int seed = 7;
+  for(size_t index = 0; index < length; ++index) {
+    seed = seed * 1103515245 + 12345;
+    values.push_back(static_cast<int>((seed >> 8) % range));
+  }
+  return values;
+}
+
+/** Comparison of pairs by their first value only */
+struct FirstLess {
+  /** \return true if a.first is less than b.first */
+  bool operator()(const std::pair<int, int>& a, const std::pair<int, int>& b) const {
+    return a.first < b.first;
+  }
+};
+
+TEST(SortTest, tinyIsInsertionSorted) {
+  std::vector<int> data = { 5, 3, 9, 1, 7, 3, 0 };
+  std::vector<int> expected(data);
+  std::sort(expected.begin(), expected.end());
+
+  Sort<int, std::vector<int>::iterator> sort;
+  sort.thresholds = testThresholds();
+  sort.sort(data.begin(), data.end());
+  EXPECT_EQ(Experiment::INSERTION_SORT, sort.strategy);
+  EXPECT_EQ(expected, data);
+}
+
+TEST(SortTest, presortedIsRunMerged) {
+  // Four ascending runs
+  std::vector<int> data;
+  for(int run = 0; run < 4; ++run) {
+    for(int value = 0; value < 1000; ++value) {
+      data.push_back(4 * value + (3 - run));
+    }
+  }
+  std::vector<int> expected(data);
+  std::sort(expected.begin(), expected.end());
+
+  DoubleLinkedList<int> list(data.begin(), data.end());
+  Sort<int> sort;
+  sort.thresholds = testThresholds();
+  sort.sort(list);
+  EXPECT_EQ(Experiment::RUN_MERGE_SORT, sort.strategy);
+  EXPECT_EQ(expected, std::vector<int>(list.cbegin(), list.cend()));
+}
+
+TEST(SortTest, runMergeIsStable) {
+  // Three ascending runs by first, with second recording the original order
+  std::vector<std::pair<int, int> > data;
+  for(int run = 0; run < 3; ++run) {
+    for(int value = 0; value < 500; ++value) {
+      data.push_back(std::make_pair(value / 2, static_cast<int>(data.size())));
+    }
+  }
+  std::vector<std::pair<int, int> > expected(data);
+  std::stable_sort(expected.begin(), expected.end(), FirstLess());
+
+  Sort<std::pair<int, int>, std::pair<int, int>*, FirstLess> sort;
+  sort.thresholds = testThresholds();
+  sort.sort(data.data(), data.data() + data.size());
+  EXPECT_EQ(Experiment::RUN_MERGE_SORT, sort.strategy);
+  EXPECT_EQ(expected, data);
+}
+
+TEST(SortTest, arithmeticIsRadixSorted) {
+  std::vector<int> data = randomValues(10000, 1000000);
+  std::vector<int> expected(data);
+  std::sort(expected.begin(), expected.end());
+
+  Sort<int> sort;
+  sort.thresholds = testThresholds();
+  sort.sort(data.data(), data.data() + data.size());
+  EXPECT_EQ(Experiment::RADIX_SORT, sort.strategy);
+  EXPECT_EQ(expected, data);
+}
+
+TEST(SortTest, radixSortKeepsSignedZerosInOrder) {
+  // Zeros of alternating sign among other values, which std::less holds equal
+  std::vector<int> values = randomValues(2000, 1000);
+  DoubleLinkedList<double> data;
+  std::vector<bool> negativeZeros;
+  for(size_t index = 0; index < values.size(); ++index) {
+    if(0 == index % 4) {
+      const bool negative = 0 == index % 8;
+      data.push_back(negative ? -0.0 : 0.0);
+      negativeZeros.push_back(negative);
+    } else {
+      data.push_back(values[index] - 500.5);
+    }
+  }
+
+  Sort<double> sort;
+  sort.thresholds = testThresholds();
+  sort.sort(data);
+  EXPECT_EQ(Experiment::RADIX_SORT, sort.strategy);
+
+  std::vector<bool> sortedNegativeZeros;
+  for(DoubleLinkedList<double>::const_iterator iter = data.cbegin(); data.cend() != iter; ++iter) {
+    if(0.0 == *iter) {
+      sortedNegativeZeros.push_back(std::signbit(*iter));
+    }
+  }
+  EXPECT_EQ(negativeZeros, sortedNegativeZeros);
+  EXPECT_TRUE(std::is_sorted(data.cbegin(), data.cend()));
+}
+
+TEST(SortTest, fewDistinctIsQuickSorted) {
+  const std::vector<std::string> names = { "delta", "alpha", "charlie", "bravo" };
+  std::vector<std::string> data;
+  for(int value : randomValues(10000, names.size())) {
+    data.push_back(names[value]);
+  }
+  std::vector<std::string> expected(data);
+  std::sort(expected.begin(), expected.end());
+
+  DoubleLinkedList<std::string> list(data.begin(), data.end());
+  Sort<std::string> sort;
+  sort.thresholds = testThresholds();
+  sort.sort(list);
+  EXPECT_EQ(Experiment::QUICK_SORT, sort.strategy);
+  EXPECT_EQ(expected, std::vector<std::string>(list.cbegin(), list.cend()));
+}
+
+TEST(SortTest, otherwiseIsMergeSorted) {
+  std::vector<std::string> data;
+  for(int value : randomValues(10000, 1000000)) {
+    data.push_back(std::to_string(value));
+  }
+  std::vector<std::string> expected(data);
+  std::sort(expected.begin(), expected.end());
+
+  Sort<std::string> sort;
+  sort.thresholds = testThresholds();
+  sort.sort(data.data(), data.data() + data.size());
+  EXPECT_EQ(Experiment::MERGE_SORT, sort.strategy);
+  EXPECT_EQ(expected, data);
+}
+
+TEST(SortTest, defaultMergeSortIsStable) {
+  // Random records of 1000 keys, with second recording the original order
+  std::vector<std::pair<int, int> > data;
+  for(int key : randomValues(10000, 1000)) {
+    data.push_back(std::make_pair(key, static_cast<int>(data.size())));
+  }
+  std::vector<std::pair<int, int> > expected(data);
+  std::stable_sort(expected.begin(), expected.end(), FirstLess());
+
+  DoubleLinkedList<std::pair<int, int> > list(data.begin(), data.end());
+  Sort<std::pair<int, int>, std::pair<int, int>*, FirstLess> sort;
+  sort.sort(list);
+  EXPECT_EQ(Experiment::MERGE_SORT, sort.strategy);
+  const std::vector<std::pair<int, int> > sorted(list.cbegin(), list.cend());
+  EXPECT_EQ(expected, sorted);
+}
+
+TEST(SortTest, allDistinctSampleIsNotQuickSorted) {
+  std::vector<std::string> data;
+  for(int value : randomValues(10000, 1000000)) {
+    data.push_back(std::to_string(value));
+  }
+
+  // Every sample has no more distinct values than it has values
+  Sort<std::string> sort;
+  sort.thresholds = testThresholds();
+  sort.thresholds.fewDistinctMax = sort.thresholds.distinctSample;
+  sort.sort(data.data(), data.data() + data.size());
+  EXPECT_EQ(Experiment::MERGE_SORT, sort.strategy);
+  EXPECT_TRUE(std::is_sorted(data.begin(), data.end()));
+}
+
+TEST(SortTest, thresholdsChooseEngine) {
+  std::vector<int> data = randomValues(10000, 1000000);
+  std::vector<int> expected(data);
+  std::sort(expected.begin(), expected.end());
+
+  Sort<int> sort;
+  sort.thresholds = testThresholds();
+  sort.thresholds.radixMin = data.size() + 1;
+  sort.sort(data.data(), data.data() + data.size());
+  EXPECT_EQ(Experiment::MERGE_SORT, sort.strategy);
+  EXPECT_EQ(expected, data);
+
+  std::reverse(data.begin(), data.end());
+  sort.thresholds.insertionMax = data.size();
+  sort.sort(data.data(), data.data() + data.size());
+  EXPECT_EQ(Experiment::INSERTION_SORT, sort.strategy);
+  EXPECT_EQ(expected, data);
+}
+
+TEST(SortTest, iteratorsKeepPositions) {
+  DoubleLinkedList<int> list;
+  list.push_back(2);
+  list.push_back(0);
+  list.push_back(1);
+  DoubleLinkedList<int>::iterator first = list.begin();
+
+  Sort<int> sort;
+  sort.thresholds = testThresholds();
+  sort.sort(list);
+  EXPECT_EQ(Experiment::INSERTION_SORT, sort.strategy);
+
+  std::vector<int> expected = { 0, 1, 2 };
+  EXPECT_EQ(expected, std::vector<int>(list.cbegin(), list.cend()));
+  EXPECT_EQ(0, *first);
+}